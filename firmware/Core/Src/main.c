@@ -38,6 +38,7 @@
 #include "buttons.h"
 #include "system.h"
 #include "sound.h"
+#include "tracker.h"
 #include "tetris.h"
 
 /* USER CODE END Includes */
@@ -182,6 +183,9 @@ int main(void)
     // Write to LCD
     LCD_Update();
     
+    // Read ahead the song streamed from the SPI flash
+    Tracker_Service();
+    
   }
   /* USER CODE END 3 */
 }
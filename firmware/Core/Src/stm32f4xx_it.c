@@ -174,6 +174,9 @@ void DebugMon_Handler(void)
 void PendSV_Handler(void)
 {
   /* USER CODE BEGIN PendSV_IRQn 0 */
+  
+  // Sound buffer halves released by the DMA are rendered here, at the lowest priority
+  Sound_IT();
 
   /* USER CODE END PendSV_IRQn 0 */
   /* USER CODE BEGIN PendSV_IRQn 1 */
@@ -210,8 +213,7 @@ void DMA1_Stream4_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA1_Stream4_IRQn 0 */
   
-  // We get here when half of the sound buffer becomes empty
-  Sound_IT();
+  // Half of the sound buffer became empty: the I2S callbacks in sound.c pend the rendering
   
   /* USER CODE END DMA1_Stream4_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_spi2_tx);
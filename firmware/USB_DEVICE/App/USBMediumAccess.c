@@ -17,6 +17,8 @@
 #include "types.h"
 #include "usbd_storage_if.h"
 #include "spi_flash.h"
+#include "tracker.h"
+#include "music.h"
 // Own include
 #include "USBMediumAccess.h"
 
@@ -570,6 +572,7 @@ static const U8 cau8ReadmeFile[] =
 It support multiple files defined in the \"filesOnDrive\" array, with file content either hardcoded in an array, or generated by a callback function.\r\n\
 To make the FAT table simple, all unused clusters are marked as bad to prevent new file creation or file movement.\r\n\
 But the existing file can be modified to send data back to the hardware.\r\n\
+Songs can be copied over the TRACKn.TRK files, and chosen in the Music menu.\r\n\
 ";
 
 static const U8 cau8LEDControlFile[] =
@@ -618,6 +621,80 @@ void FlashWriteCallback( U32 u32FileOffset, U8* pu8Buffer, U32 u32Size )
   SPIFlash_Write_Polling( u32FileOffset, pu8Buffer, u32Size );
 }
 
+/*! *******************************************************************
+ * \brief  Reads a song slot of the SPI flash
+ * \param  u8Slot: index of the slot
+ * \param  u32FileOffset: offset in the slot
+ * \param  pu8Buffer: the output is written here
+ * \param  u32Size: number of bytes
+ * \return -
+ *********************************************************************/
+static void TrackRead( U8 u8Slot, U32 u32FileOffset, U8* pu8Buffer, U32 u32Size )
+{
+  SPIFlash_Read_Polling( MUSIC_SLOT_ADDRESS( u8Slot ) + u32FileOffset, pu8Buffer, u32Size );
+}
+
+/*! *******************************************************************
+ * \brief  Writes a song slot of the SPI flash
+ * \param  u8Slot: index of the slot
+ * \param  u32FileOffset: offset in the slot
+ * \param  pu8Buffer: the data to be written
+ * \param  u32Size: number of bytes
+ * \return -
+ * \note   The slot is a sector, erased by writing its first block: the
+ *         rest of the slot is 0xFF after a shorter song. A song streamed
+ *         from the flash is stopped before it is changed.
+ *********************************************************************/
+static void TrackWrite( U8 u8Slot, U32 u32FileOffset, U8* pu8Buffer, U32 u32Size )
+{
+  Tracker_InvalidateStream();
+  if( 0u == u32FileOffset )
+  {
+    SPIFlash_EraseSector_Polling( MUSIC_SLOT_ADDRESS( u8Slot ) );
+  }
+  SPIFlash_Write_Polling( MUSIC_SLOT_ADDRESS( u8Slot ) + u32FileOffset, pu8Buffer, u32Size );
+}
+
+void Track1ReadCallback( U32 u32FileOffset, U8* pu8Buffer, U32 u32Size )
+{
+  TrackRead( 0u, u32FileOffset, pu8Buffer, u32Size );
+}
+
+void Track2ReadCallback( U32 u32FileOffset, U8* pu8Buffer, U32 u32Size )
+{
+  TrackRead( 1u, u32FileOffset, pu8Buffer, u32Size );
+}
+
+void Track3ReadCallback( U32 u32FileOffset, U8* pu8Buffer, U32 u32Size )
+{
+  TrackRead( 2u, u32FileOffset, pu8Buffer, u32Size );
+}
+
+void Track4ReadCallback( U32 u32FileOffset, U8* pu8Buffer, U32 u32Size )
+{
+  TrackRead( 3u, u32FileOffset, pu8Buffer, u32Size );
+}
+
+void Track1WriteCallback( U32 u32FileOffset, U8* pu8Buffer, U32 u32Size )
+{
+  TrackWrite( 0u, u32FileOffset, pu8Buffer, u32Size );
+}
+
+void Track2WriteCallback( U32 u32FileOffset, U8* pu8Buffer, U32 u32Size )
+{
+  TrackWrite( 1u, u32FileOffset, pu8Buffer, u32Size );
+}
+
+void Track3WriteCallback( U32 u32FileOffset, U8* pu8Buffer, U32 u32Size )
+{
+  TrackWrite( 2u, u32FileOffset, pu8Buffer, u32Size );
+}
+
+void Track4WriteCallback( U32 u32FileOffset, U8* pu8Buffer, U32 u32Size )
+{
+  TrackWrite( 3u, u32FileOffset, pu8Buffer, u32Size );
+}
+
 void LongfileCallback( U32 u32FileOffset, U8* pu8Buffer, U32 u32Size ) 
 {
   for( U32 u32BufferIndex = 0u; u32BufferIndex < u32Size; u32BufferIndex++ )
@@ -684,10 +761,46 @@ const S_FILE_DESCRIPTOR gcsFilesOnDrive[] =
     .au8FileName = {'S', 'P', 'I', 'F', 'L', 'A', 'S', 'H', 'B', 'I', 'N'},
     .au8FileTime = {TIME_LOW(12, 34, 56), TIME_HIGH(12, 34, 56)},
     .au8FileDate = {DATE_LOW(2023,1,20), DATE_HIGH(2023,1,20)},
-    .u32FileSize = 16u*1024*1024u,  // 16 Mbytes
+    .u32FileSize = MUSIC_FLASH_ADDRESS,  // The flash up to the song slots, they are the TRACKn.TRK files
     .eReadCallbackType = FUNCTION_CALLBACK_FILE,
     .uReadHandler = {.pFuncRead = FlashReadCallback},
     .pWriteHandler = FlashWriteCallback,
+  },
+  {
+    .au8FileName = {'T', 'R', 'A', 'C', 'K', '1', ' ', ' ', 'T', 'R', 'K'},
+    .au8FileTime = {TIME_LOW(12, 34, 56), TIME_HIGH(12, 34, 56)},
+    .au8FileDate = {DATE_LOW(2023,1,20), DATE_HIGH(2023,1,20)},
+    .u32FileSize = MUSIC_SLOT_SIZE,
+    .eReadCallbackType = FUNCTION_CALLBACK_FILE,
+    .uReadHandler = {.pFuncRead = Track1ReadCallback},
+    .pWriteHandler = Track1WriteCallback,
+  },
+  {
+    .au8FileName = {'T', 'R', 'A', 'C', 'K', '2', ' ', ' ', 'T', 'R', 'K'},
+    .au8FileTime = {TIME_LOW(12, 34, 56), TIME_HIGH(12, 34, 56)},
+    .au8FileDate = {DATE_LOW(2023,1,20), DATE_HIGH(2023,1,20)},
+    .u32FileSize = MUSIC_SLOT_SIZE,
+    .eReadCallbackType = FUNCTION_CALLBACK_FILE,
+    .uReadHandler = {.pFuncRead = Track2ReadCallback},
+    .pWriteHandler = Track2WriteCallback,
+  },
+  {
+    .au8FileName = {'T', 'R', 'A', 'C', 'K', '3', ' ', ' ', 'T', 'R', 'K'},
+    .au8FileTime = {TIME_LOW(12, 34, 56), TIME_HIGH(12, 34, 56)},
+    .au8FileDate = {DATE_LOW(2023,1,20), DATE_HIGH(2023,1,20)},
+    .u32FileSize = MUSIC_SLOT_SIZE,
+    .eReadCallbackType = FUNCTION_CALLBACK_FILE,
+    .uReadHandler = {.pFuncRead = Track3ReadCallback},
+    .pWriteHandler = Track3WriteCallback,
+  },
+  {
+    .au8FileName = {'T', 'R', 'A', 'C', 'K', '4', ' ', ' ', 'T', 'R', 'K'},
+    .au8FileTime = {TIME_LOW(12, 34, 56), TIME_HIGH(12, 34, 56)},
+    .au8FileDate = {DATE_LOW(2023,1,20), DATE_HIGH(2023,1,20)},
+    .u32FileSize = MUSIC_SLOT_SIZE,
+    .eReadCallbackType = FUNCTION_CALLBACK_FILE,
+    .uReadHandler = {.pFuncRead = Track4ReadCallback},
+    .pWriteHandler = Track4WriteCallback,
   }
 };
 
@@ -695,6 +808,10 @@ const S_FILE_DESCRIPTOR gcsFilesOnDrive[] =
 const U8 gcu8NumFilesOnDrive = (sizeof(gcsFilesOnDrive)/sizeof(S_FILE_DESCRIPTOR) );
 // The number of files (including the root directory) should not exceed the maximum
 STATIC_ASSERT( (sizeof(gcsFilesOnDrive)/sizeof(S_FILE_DESCRIPTOR) ) < MAX_NUM_FILES_ROOT );
+// There is a file for each song slot
+STATIC_ASSERT( 4u == MUSIC_FLASH_SLOTS );
+// SPIFLASH.BIN erases whole sectors, none of them may be a song slot
+STATIC_ASSERT( 0u == ( MUSIC_FLASH_ADDRESS % 65536u ) );
 
 
 //-----------------------------------------------< EOF >--------------------------------------------------/
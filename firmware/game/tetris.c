@@ -20,7 +20,6 @@ Some notes about the implementation:
 //--------------------------------------------------------------------------------------------------------/
 // Include files
 //--------------------------------------------------------------------------------------------------------/
-#include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include "stm32f4xx_hal.h"  //TODO: replace this later to an own housekeeping library
@@ -28,6 +27,7 @@ Some notes about the implementation:
 #include "display.h"
 #include "buttons.h"
 #include "sound_synth.h"
+#include "sound_samples.h"
 #include "tracker.h"
 
 
@@ -41,6 +41,9 @@ Some notes about the implementation:
 #define DEFAULT_SPEED_MS    (500u)  //!< Default delay between two events/moves
 #define TETROID_SIZE_X        (4u)  //!< Maximum horizontal size of the tetroid in blocks
 #define TETROID_SIZE_Y        (4u)  //!< Maximum vertical size of the tetroid in blocks
+#define LINES_PER_LEVEL      (10u)  //!< Cleared lines to reach the next level
+#define MAX_LEVEL             (8u)  //!< Level where the music does not get faster any more
+#define LEVEL_TEMPO_STEP  ( TRACKER_TEMPO_NORMAL/16u )  //!< Music tempo increase by level (Q16)
 
 
 //--------------------------------------------------------------------------------------------------------/
@@ -59,6 +62,9 @@ static BOOL gabTetroid[ TETROID_SIZE_X ][ TETROID_SIZE_Y ];     //!< The current
 static I8   gi8TetroidX;                                        //!< Horizontal coordinate of the bottom left corner of the tetroid
 static I8   gi8TetroidY;                                        //!< Vertical coordinate of the bottom left corner of the tetroid
 static U32  gu32Score;                                          //!< Game score
+static U32  gu32Lines;                                          //!< Lines cleared in the game
+static U8   gu8Level;                                           //!< Game level, by the cleared lines
+static S_DISPLAY_NUMBER gsScoreNumber;                          //!< Cached glyphs of the printed score
 
 
 //--------------------------------------------------------------------------------------------------------/
@@ -69,6 +75,7 @@ static void FixTetroid( void );
 static void RollNewTetroid( void );
 static BOOL CheckPlayfieldHit( void );
 static void RotateTetroid( BOOL bClockWise );
+static void SetLevel( U8 u8Level );
 
 
 //--------------------------------------------------------------------------------------------------------/
@@ -100,9 +107,10 @@ static void FixTetroid( void )
 {
   U8   u8IndexX, u8IndexY, u8Iter;
   U32  u32ScoreIncrease = 1;
+  U8   u8Lines = 0;
   BOOL bFullLine;
   
-  SoundSynth_Press( 2*334783, 0u );  //FIXME: proper chime instead of just one note
+  SoundSynth_NoteOn( SYNTH_PLAYBACK_RATE( SOUND_SAMPLES_RATE ), SYNTH_INSTRUMENT_LOCK, SYNTH_PRIORITY_SFX, SoundSynth_GetTime() );
   for( u8IndexX = 0; u8IndexX < PLAYFIELD_SIZE_X; u8IndexX++ )
   {
     for( u8IndexY = 0; u8IndexY < PLAYFIELD_SIZE_Y; u8IndexY++ )
@@ -143,21 +151,44 @@ static void FixTetroid( void )
         }
       }
       u32ScoreIncrease *= 10;
-      SoundSynth_Press( 4*334783, 0u );  //FIXME: proper chime instead of just one note
+      u8Lines++;
     }
     else  // if it's not full, then we have nothing to do
     {
       u8IndexY++;
     }
   }
+  // One line clear sound, higher for more lines at once
+  if( 0 != u8Lines )
+  {
+    SoundSynth_NoteOn( SYNTH_PLAYBACK_RATE( SOUND_SAMPLES_RATE + ( u8Lines - 1 )*SOUND_SAMPLES_RATE/4 ), SYNTH_INSTRUMENT_LINECLEAR, SYNTH_PRIORITY_SFX, SoundSynth_GetTime() );
+  }
   // Increase score
   gu32Score += u32ScoreIncrease;
+  // The music speeds up with the level
+  gu32Lines += u8Lines;
+  if( ( gu32Lines/LINES_PER_LEVEL > gu8Level ) && ( gu8Level < MAX_LEVEL ) )
+  {
+    SetLevel( gu8Level + 1u );
+  }
   // Next tetroid
   RollNewTetroid();
   gi8TetroidX = (PLAYFIELD_SIZE_X - TETROID_SIZE_X)/2;
   gi8TetroidY = PLAYFIELD_SIZE_Y - 1;
 }
 
+/*! *******************************************************************
+ * \brief  Sets the game level
+ * \param  u8Level: the level
+ * \return -
+ * \note   The same module is played faster on higher levels
+ *********************************************************************/
+static void SetLevel( U8 u8Level )
+{
+  gu8Level = u8Level;
+  Tracker_SetTempo( TRACKER_TEMPO_NORMAL + u8Level*LEVEL_TEMPO_STEP );
+}
+
 /*! *******************************************************************
  * \brief  Generates a new tetroid using the rand() standard function
  * \param  -
@@ -357,7 +388,6 @@ static void RotateTetroid( BOOL bClockWise )
  *********************************************************************/
 void Tetris_Init( void )
 {
-  Tracker_Init( HAL_GetTick() );  
   gbRunning = FALSE;
   gbGameOver = FALSE;
   memset( gabBlocks, FALSE, sizeof( gabBlocks ) );
@@ -366,6 +396,9 @@ void Tetris_Init( void )
   gi8TetroidX = 0;
   gi8TetroidY = PLAYFIELD_SIZE_Y - 1;
   gu32Score = 0;
+  gu32Lines = 0;
+  gu8Level = 0;
+  Display_InitNumber( &gsScoreNumber );
   // Put "Tetris" text on playfield
   //   +----------+
   // 19|          |
@@ -472,7 +505,6 @@ void Tetris_Cycle( void )
 {
   volatile U32 u32RandomNumber = rand();  // roll the random number generator so it will be more random
   U8 u8IndexX, u8IndexY;
-  U8 au8HighScoreString[ 10 ];
   U32 u32TimeNow = HAL_GetTick();
 
   // Draw playfield frame
@@ -492,8 +524,7 @@ void Tetris_Cycle( void )
   if( ( TRUE == gbGameOver ) || ( TRUE == gbRunning ) )
   {
     Display_PrintString( "Score:", 24, 32, TRUE );
-    sprintf( (char*)au8HighScoreString, "%d", gu32Score );
-    Display_PrintString( au8HighScoreString, 24, 40, TRUE );
+    Display_PrintNumber( &gsScoreNumber, gu32Score, 24, 40 );
   }
   
   // Draw blocks
@@ -516,8 +547,10 @@ void Tetris_Cycle( void )
     gbGameOver = FALSE;
     memset( gabBlocks, FALSE, sizeof( gabBlocks ) );  // clear playfield
     gu32Score = 0;
+    gu32Lines = 0;
+    SetLevel( 0u );
     gu32TimerMS = u32TimeNow + DEFAULT_SPEED_MS;
-    Tracker_Init( u32TimeNow );  
+    Tracker_Start();
     // Roll a random tetroid and place it on the top of screen
     RollNewTetroid();
     gi8TetroidX = (PLAYFIELD_SIZE_X - TETROID_SIZE_X)/2;
@@ -527,9 +560,6 @@ void Tetris_Cycle( void )
   // If the game is running
   if( TRUE == gbRunning )
   {
-    // Play music
-    Tracker_Play( u32TimeNow );
-    
     // Check timer and down button, and move tetroid vertically
     if( ( u32TimeNow >= gu32TimerMS )                            // if timer is expired...
      || ( BUTTON_PRESSED == Buttons_GetEvent( BUTTON_DOWN ) ) )  // ...or down button is pressed
@@ -546,6 +576,7 @@ void Tetris_Cycle( void )
           // Game over
           gbGameOver = TRUE;
           gbRunning = FALSE;
+          Tracker_Stop();
         }
         FixTetroid();  // this fixes the tetroid and generates a new one
       }
@@ -565,6 +596,7 @@ void Tetris_Cycle( void )
         // Game over
         gbGameOver = TRUE;
         gbRunning = FALSE;
+        Tracker_Stop();
       }
       FixTetroid();  // this fixes the tetroid and generates a new one
     }
@@ -0,0 +1,191 @@
+﻿/*! *******************************************************************************************************
+* Copyright (c) 2023 K. Sz. Horvath
+*
+* All rights reserved
+*
+* \file adpcm.c
+*
+* \brief IMA-ADPCM sample decoder
+*
+* \author K. Sz. Horvath
+*
+**********************************************************************************************************/
+
+//--------------------------------------------------------------------------------------------------------/
+// Include files
+//--------------------------------------------------------------------------------------------------------/
+#include <stddef.h>
+#include "types.h"
+
+// Own include
+#include "adpcm.h"
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Definitions
+//--------------------------------------------------------------------------------------------------------/
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Types
+//--------------------------------------------------------------------------------------------------------/
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Global variables
+//--------------------------------------------------------------------------------------------------------/
+//! \brief Quantizer step sizes of the IMA-ADPCM standard
+const U16 gcau16ADPCMStepTable[ ADPCM_STEP_INDEX_MAX + 1u ] =
+{
+  7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
+  34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143,
+  157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658,
+  724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024,
+  3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+  15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+//! \brief Step index change for each code
+const I8 gcai8ADPCMIndexTable[ 16u ] =
+{
+  -1, -1, -1, -1, 2, 4, 6, 8,
+  -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Static function declarations
+//--------------------------------------------------------------------------------------------------------/
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Static functions
+//--------------------------------------------------------------------------------------------------------/
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Interface functions
+//--------------------------------------------------------------------------------------------------------/
+/*! *******************************************************************
+ * \brief  Starts decoding a sample from the beginning
+ * \param  psDecoder: decoder state
+ * \param  psSample: the encoded sample
+ * \return -
+ *********************************************************************/
+void ADPCM_Start( S_ADPCM_DECODER* psDecoder, S_ADPCM_SAMPLE const* psSample )
+{
+  psDecoder->psSample = psSample;
+  psDecoder->u32Block = 0u;
+  psDecoder->u32SamplesLeft = psSample->u32Samples;
+  psDecoder->pu8Data = NULL;
+  psDecoder->u16BlockSamples = 0u;
+  psDecoder->bHighNibble = FALSE;
+  psDecoder->i32Predictor = 0;
+  psDecoder->i32StepIndex = 0;
+}
+
+ /*! *******************************************************************
+ * \brief  Decodes the next samples
+ * \param  psDecoder: decoder state
+ * \param  pi16Output: output buffer
+ * \param  u16Samples: number of samples to decode
+ * \return Number of samples decoded: less than requested at the end of the sample
+ *********************************************************************/
+U16 ADPCM_Decode( S_ADPCM_DECODER* psDecoder, I16* pi16Output, U16 u16Samples )
+{
+  U16       u16Decoded = 0u;
+  U8 const* pu8Data = psDecoder->pu8Data;
+  U16       u16BlockSamples = psDecoder->u16BlockSamples;
+  BOOL      bHighNibble = psDecoder->bHighNibble;
+  I32       i32Predictor = psDecoder->i32Predictor;
+  I32       i32StepIndex = psDecoder->i32StepIndex;
+  U8 const* pu8Block;
+  U8        u8Nibble;
+
+  if( u16Samples > psDecoder->u32SamplesLeft )
+  {
+    u16Samples = (U16)psDecoder->u32SamplesLeft;
+  }
+
+  while( u16Decoded < u16Samples )
+  {
+    if( 0u == u16BlockSamples )
+    {
+      // Block boundary: the header restarts the decoder
+      pu8Block = &psDecoder->psSample->pu8Data[ psDecoder->u32Block*ADPCM_BLOCK_SIZE ];
+      psDecoder->u32Block++;
+      i32Predictor = (I16)( (U16)pu8Block[ 0u ] | ( (U16)pu8Block[ 1u ]<<8u ) );
+      i32StepIndex = ( pu8Block[ 2u ] > ADPCM_STEP_INDEX_MAX ) ? ADPCM_STEP_INDEX_MAX : pu8Block[ 2u ];
+      pu8Data = &pu8Block[ ADPCM_BLOCK_HEADER_SIZE ];
+      bHighNibble = FALSE;
+      u16BlockSamples = ADPCM_BLOCK_SAMPLES - 1u;
+      pi16Output[ u16Decoded++ ] = (I16)i32Predictor;
+      continue;
+    }
+
+    if( TRUE == bHighNibble )
+    {
+      u8Nibble = *pu8Data++ >> 4u;
+      bHighNibble = FALSE;
+    }
+    else
+    {
+      u8Nibble = *pu8Data & 0x0Fu;
+      bHighNibble = TRUE;
+    }
+    i32Predictor = ADPCM_Step( i32Predictor, i32StepIndex, u8Nibble );
+    i32StepIndex += gcai8ADPCMIndexTable[ u8Nibble ];
+    if( i32StepIndex < 0 )
+    {
+      i32StepIndex = 0;
+    }
+    else if( i32StepIndex > (I32)ADPCM_STEP_INDEX_MAX )
+    {
+      i32StepIndex = ADPCM_STEP_INDEX_MAX;
+    }
+    u16BlockSamples--;
+    pi16Output[ u16Decoded++ ] = (I16)i32Predictor;
+  }
+
+  psDecoder->pu8Data = pu8Data;
+  psDecoder->u16BlockSamples = u16BlockSamples;
+  psDecoder->bHighNibble = bHighNibble;
+  psDecoder->i32Predictor = i32Predictor;
+  psDecoder->i32StepIndex = i32StepIndex;
+  psDecoder->u32SamplesLeft -= u16Decoded;
+
+  return u16Decoded;
+}
+
+ /*! *******************************************************************
+ * \brief  One step of the IMA-ADPCM predictor
+ * \param  i32Predictor: last sample
+ * \param  i32StepIndex: index in the step size table
+ * \param  u8Nibble: 4-bit code (sign and magnitude)
+ * \return Next sample, saturated to 16 bits
+ * \note   Shared with the encoder, so its reconstruction matches the decoder bit by bit
+ *********************************************************************/
+I32 ADPCM_Step( I32 i32Predictor, I32 i32StepIndex, U8 u8Nibble )
+{
+  I32 i32Step = gcau16ADPCMStepTable[ i32StepIndex ];
+  I32 i32Difference = i32Step>>3;
+
+  if( 0u != ( u8Nibble & 4u ) )
+  {
+    i32Difference += i32Step;
+  }
+  if( 0u != ( u8Nibble & 2u ) )
+  {
+    i32Difference += i32Step>>1;
+  }
+  if( 0u != ( u8Nibble & 1u ) )
+  {
+    i32Difference += i32Step>>2;
+  }
+  i32Predictor += ( 0u != ( u8Nibble & 8u ) ) ? -i32Difference : i32Difference;
+
+  return DSP_SSAT16( i32Predictor );
+}
+
+
+//-----------------------------------------------< EOF >--------------------------------------------------/
@@ -0,0 +1,75 @@
+﻿/*! *******************************************************************************************************
+* Copyright (c) 2023 K. Sz. Horvath
+*
+* All rights reserved
+*
+* \file adpcm.h
+*
+* \brief IMA-ADPCM sample decoder
+*
+* \author K. Sz. Horvath
+*
+**********************************************************************************************************/
+
+#ifndef ADPCM_H
+#define ADPCM_H
+
+//--------------------------------------------------------------------------------------------------------/
+// Include files
+//--------------------------------------------------------------------------------------------------------/
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Definitions
+//--------------------------------------------------------------------------------------------------------/
+#define ADPCM_BLOCK_SIZE              (256u)  //!< Size of an encoded block in bytes
+#define ADPCM_BLOCK_HEADER_SIZE         (4u)  //!< Block header: first sample (I16, little endian), step index (U8), reserved (U8)
+#define ADPCM_BLOCK_SAMPLES  ( 1u + 2u*( ADPCM_BLOCK_SIZE - ADPCM_BLOCK_HEADER_SIZE ) )  //!< Samples in a full block: the header sample and two per byte
+#define ADPCM_STEP_INDEX_MAX           (88u)  //!< Last index of the step size table
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Types
+//--------------------------------------------------------------------------------------------------------/
+//! \brief Encoded sample
+//! \note  Mono, 4 bits per sample, in blocks of ADPCM_BLOCK_SIZE bytes. Every
+//!        block restarts the decoder, so any block can be decoded on its own.
+//!        The low nibble of a byte is decoded first.
+typedef struct
+{
+  U8 const*        pu8Data;            //!< Blocks in the internal flash
+  U32              u32Samples;         //!< Length in samples
+} S_ADPCM_SAMPLE;
+
+//! \brief Decoder state
+typedef struct
+{
+  S_ADPCM_SAMPLE const* psSample;      //!< Sample that is decoded
+  U32              u32Block;           //!< Index of the next block
+  U32              u32SamplesLeft;     //!< Samples left until the end of the sample
+  U8 const*        pu8Data;            //!< Next byte in the current block, NULL at a block boundary
+  U16              u16BlockSamples;    //!< Samples left in the current block
+  BOOL             bHighNibble;        //!< The high nibble of the current byte comes next
+  I32              i32Predictor;       //!< Last decoded sample
+  I32              i32StepIndex;       //!< Index in the step size table
+} S_ADPCM_DECODER;
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Global variables
+//--------------------------------------------------------------------------------------------------------/
+extern const U16 gcau16ADPCMStepTable[ ADPCM_STEP_INDEX_MAX + 1u ];
+extern const I8 gcai8ADPCMIndexTable[ 16u ];
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Interface functions
+//--------------------------------------------------------------------------------------------------------/
+void ADPCM_Start( S_ADPCM_DECODER* psDecoder, S_ADPCM_SAMPLE const* psSample );
+U16  ADPCM_Decode( S_ADPCM_DECODER* psDecoder, I16* pi16Output, U16 u16Samples );
+I32  ADPCM_Step( I32 i32Predictor, I32 i32StepIndex, U8 u8Nibble );
+
+
+#endif  // ADPCM_H
+
+//-----------------------------------------------< EOF >--------------------------------------------------/
@@ -305,6 +305,8 @@ const U8 cau8Font8x8[2048] =
 //--------------------------------------------------------------------------------------------------------/
 // Static function declarations
 //--------------------------------------------------------------------------------------------------------/
+static void RotateGlyph( U8 u8Char, U8* pu8Columns );
+static void BlitColumns( U8 const* pu8Columns, U8 u8X, U8 u8Y );
 
 
 //--------------------------------------------------------------------------------------------------------/
@@ -388,11 +390,62 @@ static void PlotLineHigh( U8 u8X0, U8 u8Y0, U8 u8X1, U8 u8Y1, BOOL bIsOn )
   }
 }
 
- /*! *******************************************************************
- * \brief
- * \param
- * \return
+/*! *******************************************************************
+ * \brief  Converts a character of the font to the column format of the LCD
+ * \param  u8Char: character to convert (extended ASCII)
+ * \param  pu8Columns: the 8 columns of the glyph are written here
+ * \return -
+ * \note   Bit N of a column byte is the pixel in row N of the glyph
+ *********************************************************************/
+static void RotateGlyph( U8 u8Char, U8* pu8Columns )
+{
+  U8 u8IndexX, u8IndexY;
+  U8 u8Column;
+
+  for( u8IndexX = 0u; u8IndexX < 8u; u8IndexX++ )
+  {
+    u8Column = 0u;
+    for( u8IndexY = 0u; u8IndexY < 8u; u8IndexY++ )
+    {
+      if( 0u != ( (0x80u>>u8IndexX) & cau8Font8x8[ u8Char*8u + u8IndexY ] ) )
+      {
+        u8Column |= 0x01u<<u8IndexY;
+      }
+    }
+    pu8Columns[ u8IndexX ] = u8Column;
+  }
+}
+
+/*! *******************************************************************
+ * \brief  Copies 8 glyph columns into the frame buffer
+ * \param  pu8Columns: glyph columns in LCD format
+ * \param  u8X: glyph top left corner X coordinate
+ * \param  u8Y: glyph top left corner Y coordinate
+ * \return -
+ * \note   Pixels are only set, never cleared, just like Display_PrintChar() with bIsOn == TRUE
  *********************************************************************/
+static void BlitColumns( U8 const* pu8Columns, U8 u8X, U8 u8Y )
+{
+  U8  u8Index;
+  U8  u8Row = u8Y>>3u;      // 8-pixel tall row of the frame buffer
+  U8  u8Shift = u8Y & 0x07u;
+  U16 u16Column;
+
+  if( u8Row >= (LCD_SIZE_Y/8u) )
+  {
+    return;
+  }
+  for( u8Index = 0u; ( u8Index < 8u ) && ( (u8X + u8Index) < LCD_SIZE_X ); u8Index++ )
+  {
+    // A glyph that is not aligned to a frame buffer row spans two rows
+    u16Column = (U16)pu8Columns[ u8Index ]<<u8Shift;
+    gau8LCDFrameBuffer[ u8X + u8Index + LCD_SIZE_X*u8Row ] |= (U8)u16Column;
+    if( ( 0u != u8Shift ) && ( (u8Row + 1u) < (LCD_SIZE_Y/8u) ) )
+    {
+      gau8LCDFrameBuffer[ u8X + u8Index + LCD_SIZE_X*(u8Row + 1u) ] |= (U8)(u16Column>>8u);
+    }
+  }
+}
 
 
 //--------------------------------------------------------------------------------------------------------/
@@ -484,10 +537,66 @@ void Display_PrintString( U8* pu8String, U8 u8X, U8 u8Y, BOOL bIsOn )
 }
 
 /*! *******************************************************************
- * \brief
- * \param
- * \return
+ * \brief  Initializes a numeric widget
+ * \param  psNumber: the widget
+ * \return -
+ *********************************************************************/
+void Display_InitNumber( S_DISPLAY_NUMBER* psNumber )
+{
+  psNumber->bValid = FALSE;
+  psNumber->u32Value = 0u;
+  psNumber->u8Digits = 0u;
+}
+
+/*! *******************************************************************
+ * \brief  Draws an unsigned decimal number to the screen
+ * \param  psNumber: widget holding the glyphs of the last rendered value
+ * \param  u32Value: value to print
+ * \param  u8X: first digit top left corner X coordinate
+ * \param  u8Y: first digit top left corner Y coordinate
+ * \return -
+ * \note   Replaces sprintf() + Display_PrintString(). Digits are only converted
+ *         to glyphs when they change; every other call just copies the cached
+ *         columns into the frame buffer, which is cleared in every frame.
  *********************************************************************/
+void Display_PrintNumber( S_DISPLAY_NUMBER* psNumber, U32 u32Value, U8 u8X, U8 u8Y )
+{
+  U8  au8Digit[ DISPLAY_NUMBER_DIGITS ];
+  U8  u8Digits = 0u;
+  U8  u8Index;
+  U32 u32Rest = u32Value;
+
+  if( ( FALSE == psNumber->bValid ) || ( u32Value != psNumber->u32Value ) )
+  {
+    // Split the value to digits, least significant first
+    do
+    {
+      au8Digit[ u8Digits ] = (U8)(u32Rest % 10u);
+      u32Rest /= 10u;
+      u8Digits++;
+    } while( 0u != u32Rest );
+
+    // Only the digits that have changed place or value get a new glyph
+    for( u8Index = 0u; u8Index < u8Digits; u8Index++ )
+    {
+      if( ( FALSE == psNumber->bValid )
+       || ( u8Digits != psNumber->u8Digits )
+       || ( au8Digit[ u8Digits - 1u - u8Index ] != psNumber->au8Digit[ u8Index ] ) )
+      {
+        psNumber->au8Digit[ u8Index ] = au8Digit[ u8Digits - 1u - u8Index ];
+        RotateGlyph( '0' + psNumber->au8Digit[ u8Index ], psNumber->aau8Columns[ u8Index ] );
+      }
+    }
+    psNumber->u8Digits = u8Digits;
+    psNumber->u32Value = u32Value;
+    psNumber->bValid = TRUE;
+  }
+
+  for( u8Index = 0u; u8Index < psNumber->u8Digits; u8Index++ )
+  {
+    BlitColumns( psNumber->aau8Columns[ u8Index ], u8X + u8Index*8u, u8Y );
+  }
+}
 
 
 
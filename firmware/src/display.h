@@ -23,11 +23,21 @@
 //--------------------------------------------------------------------------------------------------------/
 // Definitions
 //--------------------------------------------------------------------------------------------------------/
+#define DISPLAY_NUMBER_DIGITS  (10u)  //!< Maximum number of digits of a numeric widget (enough for a U32)
 
 
 //--------------------------------------------------------------------------------------------------------/
 // Types
 //--------------------------------------------------------------------------------------------------------/
+//! \brief Numeric widget that caches the glyphs of the last rendered value
+typedef struct
+{
+  BOOL bValid;                                          //!< TRUE, if the cache holds a rendered value
+  U32  u32Value;                                        //!< Last rendered value
+  U8   u8Digits;                                        //!< Number of digits of the last rendered value
+  U8   au8Digit[ DISPLAY_NUMBER_DIGITS ];               //!< Digits of the last rendered value, most significant first
+  U8   aau8Columns[ DISPLAY_NUMBER_DIGITS ][ 8u ];      //!< Glyph of each digit in the column format of the LCD
+} S_DISPLAY_NUMBER;
 
 
 //--------------------------------------------------------------------------------------------------------/
@@ -41,6 +51,8 @@
 void Display_DrawLine( U8 u8X0, U8 u8Y0, U8 u8X1, U8 u8Y1, BOOL bIsOn );
 void Display_PrintChar( U8 u8Char, U8 u8X, U8 u8Y, BOOL bIsOn );
 void Display_PrintString( U8* pu8String, U8 u8X, U8 u8Y, BOOL bIsOn );
+void Display_InitNumber( S_DISPLAY_NUMBER* psNumber );
+void Display_PrintNumber( S_DISPLAY_NUMBER* psNumber, U32 u32Value, U8 u8X, U8 u8Y );
 
 
 #endif  // DISPLAY_H
@@ -0,0 +1,103 @@
+﻿/*! *******************************************************************************************************
+* Copyright (c) 2023 K. Sz. Horvath
+*
+* All rights reserved
+*
+* \file music.c
+*
+* \brief Songs of the game: the linked one, and the ones stored in the SPI flash
+*
+* \author K. Sz. Horvath
+*
+**********************************************************************************************************/
+
+//--------------------------------------------------------------------------------------------------------/
+// Include files
+//--------------------------------------------------------------------------------------------------------/
+#include "types.h"
+#include "spi_flash.h"
+#include "tracker.h"
+
+// Own include
+#include "music.h"
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Definitions
+//--------------------------------------------------------------------------------------------------------/
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Types
+//--------------------------------------------------------------------------------------------------------/
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Global variables
+//--------------------------------------------------------------------------------------------------------/
+//! \brief The song selected last, the linked one is loaded by Tracker_Init()
+static U8 gu8Song = 0u;
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Static function declarations
+//--------------------------------------------------------------------------------------------------------/
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Static functions
+//--------------------------------------------------------------------------------------------------------/
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Interface functions
+//--------------------------------------------------------------------------------------------------------/
+/*! *******************************************************************
+ * \brief  Loads a song, and plays it from the beginning
+ * \param  u8Song: 0 for the linked song, otherwise the flash slot + 1
+ * \return TRACKER_LOAD_OK if the song is valid, otherwise the song played
+ *         before is kept
+ * \note   The songs of the flash are not copied to RAM, the tracker
+ *         streams them: Tracker_Service() reads them ahead in the main loop,
+ *         guarded against the USB access of the flash.
+ *         A slot is 0xFF after the end of its module, the song is closed by
+ *         END before that.
+ *********************************************************************/
+E_TRACKER_LOAD_RESULT Music_Select( U8 u8Song )
+{
+  E_TRACKER_LOAD_RESULT eResult;
+
+  if( 0u == u8Song )
+  {
+    eResult = Tracker_LoadLinked();
+  }
+  else if( u8Song < MUSIC_SONGS )
+  {
+    eResult = Tracker_LoadStream( SPIFlash_ReadGuarded_Polling, MUSIC_SLOT_ADDRESS( u8Song - 1u ), MUSIC_SLOT_SIZE );
+  }
+  else
+  {
+    eResult = TRACKER_LOAD_TOO_SHORT;  // there is no such song
+  }
+
+  if( TRACKER_LOAD_OK == eResult )
+  {
+    gu8Song = u8Song;
+    Tracker_Start();
+  }
+
+  return eResult;
+}
+
+ /*! *******************************************************************
+ * \brief  Returns the song selected last
+ * \param  -
+ * \return 0 for the linked song, otherwise the flash slot + 1
+ *********************************************************************/
+U8 Music_GetSong( void )
+{
+  return gu8Song;
+}
+
+
+//-----------------------------------------------< EOF >--------------------------------------------------/
@@ -0,0 +1,55 @@
+﻿/*! *******************************************************************************************************
+* Copyright (c) 2023 K. Sz. Horvath
+*
+* All rights reserved
+*
+* \file music.h
+*
+* \brief Songs of the game: the linked one, and the ones stored in the SPI flash
+*
+* \author K. Sz. Horvath
+*
+**********************************************************************************************************/
+
+#ifndef MUSIC_H
+#define MUSIC_H
+
+//--------------------------------------------------------------------------------------------------------/
+// Include files
+//--------------------------------------------------------------------------------------------------------/
+#include "tracker.h"
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Definitions
+//--------------------------------------------------------------------------------------------------------/
+#define MUSIC_FLASH_SLOTS             (4u)  //!< Number of songs that can be stored in the SPI flash
+#define MUSIC_SONGS ( 1u + MUSIC_FLASH_SLOTS )  //!< Songs to choose from: the linked one, then the flash slots
+#define MUSIC_SLOT_SIZE         (0x10000u)  //!< Each slot is a 64 kB sector of the SPI flash, so it is erased at once
+#define MUSIC_FLASH_ADDRESS    (0xFC0000u)  //!< The slots are at the end of the 16 MB SPI flash
+
+//! \brief Address of a slot in the SPI flash
+#define MUSIC_SLOT_ADDRESS( u8Slot )  ( MUSIC_FLASH_ADDRESS + (U32)(u8Slot)*MUSIC_SLOT_SIZE )
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Types
+//--------------------------------------------------------------------------------------------------------/
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Global variables
+//--------------------------------------------------------------------------------------------------------/
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Interface functions
+//--------------------------------------------------------------------------------------------------------/
+// Functions that are callable from main loop
+E_TRACKER_LOAD_RESULT Music_Select( U8 u8Song );
+U8 Music_GetSong( void );
+
+
+#endif  // MUSIC_H
+
+//-----------------------------------------------< EOF >--------------------------------------------------/
@@ -17,13 +17,17 @@
 //--------------------------------------------------------------------------------------------------------/
 // Include files
 //--------------------------------------------------------------------------------------------------------/
+#if defined( __IAR_SYSTEMS_ICC__ )
+  #include <intrinsics.h>
+#endif
 
 
 //--------------------------------------------------------------------------------------------------------/
 // Definitions and macros
 //--------------------------------------------------------------------------------------------------------/
 
-// Static assertion macro
+// Static assertion macro, packed structures, word alignment of byte buffers (written before the declaration),
+// and the memory barrier between shared data and the index that publishes it
 #ifdef __GNUC__              // GNU C compiler
   #define STATIC_ASSERT(X)  //TODO: get it to work
 //  #define STATIC_ASSERT(X) ({ extern int __attribute__((error("assertion failure: '" #X "' not true"))) compile_time_check(); ((X)?0:compile_time_check()),0; })
@@ -32,6 +36,10 @@
   #define PACKED_TYPES_BEGIN              _Pragma( "pack(push,1)" )
   #define PACKED_TYPES_END                _Pragma( "pack(pop)" )
 
+  #define ALIGNED_WORD                    __attribute__(( aligned( 4 ) ))
+
+  #define MEMORY_BARRIER()                __sync_synchronize()
+
 #elif __IAR_SYSTEMS_ICC__    // IAR C compiler
   #define STATIC_ASSERT(predicate) _impl_CASSERT_LINE(predicate,__LINE__,__FILE__)
   #define _impl_PASTE(a,b) a##b
@@ -40,6 +48,23 @@
   #define PACKED_STRUCT                     __packed
   #define PACKED_TYPES_BEGIN                _Pragma( "pack(push,1)" )
   #define PACKED_TYPES_END                  _Pragma( "pack(pop)" )
+
+  #define ALIGNED_WORD                      _Pragma( "data_alignment=4" )
+
+  #define MEMORY_BARRIER()                  __DMB()
+#endif
+
+// DSP instructions of the Cortex-M4
+// The C versions give bit-exactly the same results, and are used on the host and on cores without DSP extension
+// (tools/dsp_test checks that)
+#if defined( __IAR_SYSTEMS_ICC__ ) && defined( __ARM_FEATURE_DSP )
+  #define DSP_SMULWB(W,H)                   __SMULWB( (W), (H) )
+  #define DSP_SSAT16(X)                     __SSAT( (X), 16 )
+#else
+  //! \brief (32-bit * bottom signed halfword)>>16
+  #define DSP_SMULWB(W,H)                   ( (int32_t)( ( (int64_t)(int32_t)(W)*(int16_t)(H) )>>16 ) )
+  //! \brief Signed saturation to 16 bits (evaluates X more than once)
+  #define DSP_SSAT16(X)                     ( ( (X) > 32767 ) ? 32767 : ( ( (X) < -32768 ) ? -32768 : (int32_t)(X) ) )
 #endif
 
 
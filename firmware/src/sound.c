@@ -20,6 +20,7 @@
 #include "types.h"
 #include "system.h"
 #include "sound_synth.h"
+#include "tracker.h"
 
 // Own include
 #include "sound.h"
@@ -28,7 +29,18 @@
 //--------------------------------------------------------------------------------------------------------/
 // Definitions
 //--------------------------------------------------------------------------------------------------------/
-#define SOUND_BUFFER_SIZE  (512u)  //!< Sound buffer size in words
+#ifndef SOUND_BUFFER_SIZE
+#define SOUND_BUFFER_SIZE  (512u)  //!< Sound buffer size in words; one half is rendered at once, so this sets the latency
+#endif
+
+#if ( SOUND_BUFFER_SIZE % 4u ) != 0u
+#error "SOUND_BUFFER_SIZE must hold a whole number of stereo frames in each half"
+#endif
+
+#define SOUND_HALF_LOWER   (1u<<0u)  //!< Lower half of the sound buffer is waiting to be rendered
+#define SOUND_HALF_UPPER   (1u<<1u)  //!< Upper half of the sound buffer is waiting to be rendered
+
+#define SOUND_HALF_FRAMES  (SOUND_BUFFER_SIZE/4u)  //!< Stereo frames in one half of the sound buffer
 
 
 //--------------------------------------------------------------------------------------------------------/
@@ -43,26 +55,100 @@
 //! \note  Stereo sound, so even words are left samples and odd samples are right samples.
 volatile I16 gi16SoundBuffer[ SOUND_BUFFER_SIZE ];
 
+//! \brief Buffer halves released by the DMA that are not rendered yet (SOUND_HALF_* bits)
+static volatile U32 gu32PendingHalves;
+
+//! \brief Buffer half that the DMA is currently playing (SOUND_HALF_* bit)
+static volatile U32 gu32PlayingHalf;
+
+//! \brief Render time statistics; can also be watched live in the debugger
+volatile S_SOUND_STATS gsSoundStats;
+
 
 //--------------------------------------------------------------------------------------------------------/
 // Static function declarations
 //--------------------------------------------------------------------------------------------------------/
+static void ReleaseHalf( U32 u32Half, U32 u32PlayingHalf );
+static void RenderHalf( U16 u16Offset );
+static void UpdateStats( U16 u16Offset, U32 u32Cycles );
 
 
 //--------------------------------------------------------------------------------------------------------/
 // Static functions
 //--------------------------------------------------------------------------------------------------------/
 /*! *******************************************************************
- * \brief
- * \param
- * \return
+ * \brief  Mark a buffer half as free and request rendering
+ * \param  u32Half: half that the DMA has just finished playing
+ * \param  u32PlayingHalf: half that the DMA has just started to play
+ * \return -
+ * \note   Called from the DMA interrupt. If the half now being played is
+ *         still pending, the renderer did not keep up and it is an underrun.
  *********************************************************************/
+static void ReleaseHalf( U32 u32Half, U32 u32PlayingHalf )
+{
+  if( 0u != ( gu32PendingHalves & u32PlayingHalf ) )
+  {
+    gsSoundStats.u32Underruns++;
+  }
+  gu32PendingHalves |= u32Half;
+  gu32PlayingHalf = u32PlayingHalf;
+  
+  // Render at the lowest priority, so USB, SPI and the tick are not blocked
+  SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+}
+
+ /*! *******************************************************************
+ * \brief  Render one half of the sound buffer
+ * \param  u16Offset: first word of the half in the sound buffer
+ * \return -
+ *********************************************************************/
+static void RenderHalf( U16 u16Offset )
+{
+  U16 u16Frames;
+  U16 u16Chunk;
+  U16 u16GainQ15;
+  
+  // Master volume as Q15 gain: (volume+1)/256
+  u16GainQ15 = ( (U16)gsRuntimeGlobals.u8Volume + 1u )<<7u;
+  
+  // Render until the next tracker instruction, so the music is timed to the frame
+  for( u16Frames = 0u; u16Frames < SOUND_HALF_FRAMES; u16Frames += u16Chunk )
+  {
+    u16Chunk = Tracker_Tick( SOUND_HALF_FRAMES - u16Frames );
+    SoundSynth_Render( (I16*)&gi16SoundBuffer[ u16Offset + 2u*u16Frames ], u16Chunk, u16GainQ15 );
+  }
+}
 
  /*! *******************************************************************
- * \brief
- * \param
- * \return
+ * \brief  Account the render time of one half of the sound buffer
+ * \param  u16Offset: first word of the rendered half in the sound buffer
+ * \param  u32Cycles: CPU cycles spent on rendering
+ * \return -
+ * \note   If the DMA is already reading the rendered half, its beginning
+ *         was played from stale data, so the block was finished late.
  *********************************************************************/
+static void UpdateStats( U16 u16Offset, U32 u32Cycles )
+{
+  U32 u32Position;
+  
+  // Word of the sound buffer that the DMA transfers next
+  u32Position = SOUND_BUFFER_SIZE - __HAL_DMA_GET_COUNTER( hi2s2.hdmatx );
+  if( ( u32Position >= u16Offset ) && ( u32Position < ( u16Offset + SOUND_BUFFER_SIZE/2u ) ) )
+  {
+    gsSoundStats.u32LateBlocks++;
+  }
+  
+  if( ( 0u == gsSoundStats.u32Blocks ) || ( u32Cycles < gsSoundStats.u32MinCycles ) )
+  {
+    gsSoundStats.u32MinCycles = u32Cycles;
+  }
+  if( u32Cycles > gsSoundStats.u32MaxCycles )
+  {
+    gsSoundStats.u32MaxCycles = u32Cycles;
+  }
+  gsSoundStats.u64TotalCycles += u32Cycles;
+  gsSoundStats.u32Blocks++;
+}
 
 
 //--------------------------------------------------------------------------------------------------------/
@@ -78,8 +164,16 @@ void Sound_Init( void )
   // Initialize sound buffer
   memset( (void*)gi16SoundBuffer, 0, sizeof( gi16SoundBuffer ) );
   
-  // Initialize the synthesiser
+  // Start the DWT cycle counter for measuring the render time
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0u;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  memset( (void*)&gsSoundStats, 0, sizeof( gsSoundStats ) );
+  gsSoundStats.u32PeriodCycles = (U32)( ( (U64)SystemCoreClock*SOUND_HALF_FRAMES )/SAMPLE_RATE );
+  
+  // Initialize the synthesiser and the sequencer
   SoundSynth_Init();
+  Tracker_Init();
   
   // Start sound output
   HAL_I2S_Transmit_DMA( &hi2s2, (U16*)gi16SoundBuffer, sizeof(gi16SoundBuffer)/sizeof(U16) );
@@ -89,28 +183,131 @@ void Sound_Init( void )
 }
 
  /*! *******************************************************************
- * \brief  Interrupt service routine for sound generation
+ * \brief  Deferred sound generation
  * \param  -
  * \return -
+ * \note   Called from PendSV, which runs at the lowest interrupt priority.
  *********************************************************************/
 void Sound_IT( void )
 {
-  BOOL bLowerHalf;
-  U16 u16Index, u16Offset;
-  I16 i16SampleLeft, i16SampleRight;
-  U32 u32DMADataIndex = hdma_spi2_tx.Instance->NDTR;
+  U32 u32Half;
+  U16 u16Offset;
+  U32 u32StartCycles;
+  
+  while( 0u != gu32PendingHalves )
+  {
+    // Prefer the half the DMA plays next; a half that is already playing is rendered last
+    __disable_irq();
+    u32Half = gu32PendingHalves & ~gu32PlayingHalf;
+    if( 0u == u32Half )
+    {
+      u32Half = gu32PendingHalves;
+    }
+    gu32PendingHalves &= ~u32Half;
+    __enable_irq();
+    
+    u16Offset = ( SOUND_HALF_LOWER == u32Half ) ? 0u : SOUND_BUFFER_SIZE/2u;
+    u32StartCycles = DWT->CYCCNT;
+    RenderHalf( u16Offset );
+    UpdateStats( u16Offset, DWT->CYCCNT - u32StartCycles );
+  }
+}
+
+ /*! *******************************************************************
+ * \brief  Get the number of sound buffer underruns since startup
+ * \param  -
+ * \return Number of buffer halves played before they were rendered
+ *********************************************************************/
+U32 Sound_GetUnderruns( void )
+{
+  return gsSoundStats.u32Underruns;
+}
+
+ /*! *******************************************************************
+ * \brief  Get a consistent copy of the render time statistics
+ * \param  psStats: the statistics are copied here
+ * \return -
+ *********************************************************************/
+void Sound_GetStats( S_SOUND_STATS* psStats )
+{
+  __disable_irq();
+  memcpy( psStats, (void*)&gsSoundStats, sizeof( S_SOUND_STATS ) );
+  __enable_irq();
+}
+
+ /*! *******************************************************************
+ * \brief  Restart the render time statistics
+ * \param  -
+ * \return -
+ *********************************************************************/
+void Sound_ResetStats( void )
+{
+  __disable_irq();
+  gsSoundStats.u32Blocks = 0u;
+  gsSoundStats.u32MinCycles = 0u;
+  gsSoundStats.u32MaxCycles = 0u;
+  gsSoundStats.u64TotalCycles = 0u;
+  gsSoundStats.u32LateBlocks = 0u;
+  gsSoundStats.u32Underruns = 0u;
+  __enable_irq();
+}
+
+ /*! *******************************************************************
+ * \brief  Calculate the average render time of a block
+ * \param  psStats: statistics from Sound_GetStats()
+ * \return Average render time (CPU cycles)
+ *********************************************************************/
+U32 Sound_GetAverageCycles( S_SOUND_STATS const* psStats )
+{
+  U32 u32Return = 0u;
   
-  bLowerHalf = ( u32DMADataIndex > (SOUND_BUFFER_SIZE/2) ) ? FALSE : TRUE;
-  u16Offset = ( TRUE == bLowerHalf ) ? 0u : SOUND_BUFFER_SIZE/2u;
+  if( 0u != psStats->u32Blocks )
+  {
+    u32Return = (U32)( psStats->u64TotalCycles/psStats->u32Blocks );
+  }
+  return u32Return;
+}
+
+ /*! *******************************************************************
+ * \brief  Convert a render time to the CPU load of the audio
+ * \param  psStats: statistics from Sound_GetStats()
+ * \param  u32Cycles: render time of a block (CPU cycles)
+ * \return Render time in percent of the play time of a block
+ *********************************************************************/
+U32 Sound_GetLoadPercent( S_SOUND_STATS const* psStats, U32 u32Cycles )
+{
+  U32 u32Return = 0u;
   
-  for( u16Index = 0u; u16Index < (SOUND_BUFFER_SIZE/4u); u16Index++ )
+  if( 0u != psStats->u32PeriodCycles )
+  {
+    u32Return = (U32)( ( (U64)u32Cycles*100u )/psStats->u32PeriodCycles );
+  }
+  return u32Return;
+}
+
+ /*! *******************************************************************
+ * \brief  DMA callback: the lower half of the sound buffer was played
+ * \param  hi2s: I2S handle
+ * \return -
+ *********************************************************************/
+void HAL_I2S_TxHalfCpltCallback( I2S_HandleTypeDef *hi2s )
+{
+  if( &hi2s2 == hi2s )
+  {
+    ReleaseHalf( SOUND_HALF_LOWER, SOUND_HALF_UPPER );
+  }
+}
+
+ /*! *******************************************************************
+ * \brief  DMA callback: the upper half of the sound buffer was played
+ * \param  hi2s: I2S handle
+ * \return -
+ *********************************************************************/
+void HAL_I2S_TxCpltCallback( I2S_HandleTypeDef *hi2s )
+{
+  if( &hi2s2 == hi2s )
   {
-    i16SampleLeft = SoundSynth_Sample();  // Generate sample
-    i16SampleRight = i16SampleLeft;  // Mono
-    // Left
-    gi16SoundBuffer[ u16Offset + (u16Index*2u) + 0u ] = (( (I32)i16SampleLeft*((I32)gsRuntimeGlobals.u8Volume+1) )/256u);
-    // Right
-    gi16SoundBuffer[ u16Offset + (u16Index*2u) + 1u ] = (( (I32)i16SampleRight*((I32)gsRuntimeGlobals.u8Volume+1) )/256u);
+    ReleaseHalf( SOUND_HALF_UPPER, SOUND_HALF_LOWER );
   }
 }
 
@@ -27,11 +27,23 @@
 //--------------------------------------------------------------------------------------------------------/
 // Types
 //--------------------------------------------------------------------------------------------------------/
+//! \brief Render time statistics of the sound buffer halves (blocks)
+typedef struct
+{
+  U32 u32Blocks;        //!< Number of blocks rendered since the last reset
+  U32 u32MinCycles;     //!< Shortest render time of a block (CPU cycles)
+  U32 u32MaxCycles;     //!< Longest render time of a block (CPU cycles)
+  U64 u64TotalCycles;   //!< Sum of the render times, for the average
+  U32 u32PeriodCycles;  //!< Play time of a block (CPU cycles), i.e. the render deadline
+  U32 u32LateBlocks;    //!< Number of blocks that were finished after the DMA had started to play them
+  U32 u32Underruns;     //!< Number of blocks that were played before their rendering was even started
+} S_SOUND_STATS;
 
 
 //--------------------------------------------------------------------------------------------------------/
 // Global variables
 //--------------------------------------------------------------------------------------------------------/
+extern volatile S_SOUND_STATS gsSoundStats;
 
 
 //--------------------------------------------------------------------------------------------------------/
@@ -39,6 +51,11 @@
 //--------------------------------------------------------------------------------------------------------/
 void Sound_Init( void );
 void Sound_IT( void );
+U32  Sound_GetUnderruns( void );
+void Sound_GetStats( S_SOUND_STATS* psStats );
+void Sound_ResetStats( void );
+U32  Sound_GetAverageCycles( S_SOUND_STATS const* psStats );
+U32  Sound_GetLoadPercent( S_SOUND_STATS const* psStats, U32 u32Cycles );
 
 
 #endif  // SOUND_H
@@ -0,0 +1,407 @@
+﻿/*! *******************************************************************************************************
+* Copyright (c) 2023 K. Sz. Horvath
+*
+* All rights reserved
+*
+* \file sound_samples.c
+*
+* \brief ADPCM sound effect samples
+*
+* \author K. Sz. Horvath
+*
+**********************************************************************************************************/
+
+//--------------------------------------------------------------------------------------------------------/
+// Include files
+//--------------------------------------------------------------------------------------------------------/
+#include <stddef.h>
+#include "types.h"
+#include "adpcm.h"
+
+// Own include
+#include "sound_samples.h"
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Constants
+//--------------------------------------------------------------------------------------------------------/
+// The samples below are generated by tools/adpcmenc, the sources are in tools/adpcmenc/samples
+
+//! \brief Lock sample: 2646 samples, encoded by tools/adpcmenc from lock.wav
+static const U8 gcau8LockBlocks[ 1536u ] =
+{
+  0xF6, 0xF1, 0x00, 0x00, 0x77, 0x77, 0x77, 0x77, 0x60, 0x20, 0x1B, 0x93, 0x35, 0xAC, 0x51, 0x98,
+  0xA0, 0x10, 0x82, 0x88, 0x02, 0x7A, 0x12, 0x5A, 0xB1, 0x18, 0x31, 0x2A, 0xC8, 0x20, 0xA1, 0xF9,
+  0x2A, 0xB8, 0x11, 0xA0, 0x8A, 0xA2, 0xAC, 0xBF, 0x32, 0xB9, 0x8D, 0x83, 0x8A, 0x9E, 0xA1, 0xCB,
+  0x18, 0x0F, 0x80, 0x89, 0xAA, 0xDB, 0x90, 0x9B, 0xA9, 0x9B, 0xA8, 0xFB, 0xAB, 0x10, 0x88, 0xE9,
+  0x98, 0xAD, 0x1B, 0xAA, 0x90, 0xBB, 0xB0, 0x29, 0xB9, 0xF8, 0x88, 0xAA, 0x85, 0x09, 0xD3, 0x8A,
+  0x93, 0x14, 0x91, 0x25, 0x98, 0x03, 0x02, 0x95, 0x71, 0x83, 0x03, 0x24, 0x01, 0x60, 0x30, 0x14,
+  0x40, 0x13, 0x12, 0x22, 0x25, 0x21, 0x25, 0x23, 0x35, 0x20, 0x52, 0x13, 0x41, 0x33, 0x41, 0x22,
+  0x13, 0x14, 0x52, 0x31, 0x32, 0x22, 0x52, 0x32, 0x13, 0x12, 0x21, 0x27, 0x02, 0x22, 0x20, 0x80,
+  0x51, 0x30, 0x98, 0x12, 0x0C, 0xAB, 0xD1, 0x1A, 0xDB, 0xBB, 0xD9, 0xB9, 0xBA, 0xBF, 0xCB, 0xCA,
+  0x9B, 0xAC, 0xCB, 0x9C, 0xAB, 0xBD, 0xAA, 0xBC, 0xCB, 0xBB, 0xCC, 0xAA, 0xBB, 0xAC, 0xBC, 0xCB,
+  0xAA, 0xBC, 0xBB, 0xCB, 0xAC, 0xBB, 0xCB, 0xBA, 0xBB, 0xDB, 0xAB, 0xAC, 0xAB, 0xBA, 0xBC, 0xAB,
+  0xAC, 0xAB, 0xBB, 0xAA, 0xAA, 0xBB, 0xAC, 0x8A, 0x98, 0x39, 0x12, 0x63, 0x32, 0x44, 0x63, 0x33,
+  0x34, 0x44, 0x43, 0x43, 0x33, 0x44, 0x33, 0x34, 0x24, 0x34, 0x33, 0x44, 0x32, 0x24, 0x24, 0x33,
+  0x34, 0x43, 0x33, 0x34, 0x43, 0x43, 0x32, 0x43, 0x33, 0x43, 0x33, 0x34, 0x33, 0x25, 0x33, 0x33,
+  0x34, 0x33, 0x34, 0x33, 0x24, 0x33, 0x33, 0x34, 0x33, 0x23, 0x43, 0x22, 0x22, 0x22, 0x12, 0x00,
+  0x90, 0xC9, 0xCA, 0xBC, 0xCD, 0xCB, 0xBC, 0xBC, 0xBC, 0xBC, 0xBC, 0xDB, 0xBB, 0xBC, 0xBC, 0xDB,
+  0xAD, 0x1D, 0x28, 0x00, 0xBB, 0xCB, 0xCB, 0xBB, 0xBC, 0xBC, 0xBB, 0xBC, 0xBC, 0xCB, 0xBB, 0xBC,
+  0xCB, 0xBB, 0xCB, 0xCB, 0xBB, 0xCB, 0xBB, 0xCB, 0xCB, 0xBA, 0xCB, 0xBB, 0xBB, 0xBC, 0xBB, 0xAC,
+  0xCB, 0xAA, 0xBB, 0xBB, 0xCB, 0xBA, 0xBA, 0xBA, 0xAA, 0xAA, 0x99, 0x09, 0x10, 0x43, 0x44, 0x63,
+  0x33, 0x35, 0x44, 0x33, 0x44, 0x33, 0x44, 0x33, 0x34, 0x34, 0x34, 0x43, 0x43, 0x33, 0x34, 0x34,
+  0x43, 0x33, 0x34, 0x34, 0x33, 0x44, 0x32, 0x43, 0x33, 0x34, 0x33, 0x34, 0x34, 0x33, 0x53, 0x32,
+  0x43, 0x23, 0x24, 0x33, 0x24, 0x33, 0x43, 0x33, 0x33, 0x34, 0x33, 0x24, 0x33, 0x33, 0x24, 0x23,
+  0x23, 0x23, 0x23, 0x21, 0x11, 0x80, 0xA9, 0xDB, 0xCC, 0xDB, 0xCB, 0xBC, 0xBC, 0xCC, 0xBB, 0xCC,
+  0xBB, 0xBC, 0xBC, 0xBC, 0xBC, 0xBB, 0xBD, 0xCB, 0xBB, 0xBC, 0xBC, 0xBB, 0xAD, 0xAC, 0xBB, 0xCB,
+  0xCB, 0xBB, 0xCB, 0xCB, 0xBB, 0xCB, 0xBB, 0xBC, 0xCB, 0xBB, 0xAC, 0xAC, 0xAB, 0xAC, 0xBB, 0xBB,
+  0xBC, 0xCB, 0xAB, 0xAC, 0xAB, 0xCB, 0xBA, 0xBA, 0xCB, 0xAA, 0xAB, 0xBB, 0xBA, 0xBA, 0xAA, 0x99,
+  0x89, 0x20, 0x42, 0x63, 0x53, 0x43, 0x34, 0x34, 0x34, 0x35, 0x43, 0x43, 0x43, 0x43, 0x33, 0x44,
+  0x42, 0x32, 0x24, 0x24, 0x33, 0x34, 0x34, 0x33, 0x34, 0x34, 0x43, 0x43, 0x32, 0x34, 0x33, 0x34,
+  0x43, 0x33, 0x34, 0x43, 0x33, 0x43, 0x43, 0x32, 0x43, 0x33, 0x43, 0x33, 0x43, 0x33, 0x43, 0x33,
+  0x43, 0x33, 0x33, 0x24, 0x33, 0x43, 0x32, 0x23, 0x33, 0x33, 0x33, 0x22, 0x12, 0x02, 0x98, 0xBA,
+  0xBE, 0xBD, 0xBD, 0xCC, 0xCB, 0xCB, 0xCB, 0xBC, 0xCB, 0xCB, 0xCB, 0xCB, 0xBB, 0xBC, 0xBC, 0xBC,
+  0xCB, 0xBB, 0xBC, 0xBC, 0xCB, 0xBB, 0xBC, 0xBC, 0xBB, 0xCC, 0xBA, 0xCB, 0xBB, 0xBC, 0xCB, 0xBB,
+  0x30, 0xFE, 0x1E, 0x00, 0xAC, 0xAC, 0xBB, 0xCB, 0xBB, 0xCB, 0xCB, 0xBA, 0xAC, 0xBB, 0xCB, 0xBB,
+  0xBB, 0xBC, 0xCB, 0xAB, 0xAC, 0xBA, 0xBB, 0xCB, 0xBA, 0xBB, 0xBA, 0xAC, 0xAA, 0xAA, 0x9A, 0x99,
+  0x09, 0x10, 0x33, 0x45, 0x34, 0x35, 0x44, 0x33, 0x35, 0x34, 0x34, 0x53, 0x33, 0x34, 0x34, 0x43,
+  0x43, 0x43, 0x33, 0x34, 0x34, 0x43, 0x33, 0x34, 0x34, 0x43, 0x33, 0x34, 0x43, 0x43, 0x33, 0x43,
+  0x43, 0x32, 0x34, 0x33, 0x34, 0x43, 0x33, 0x43, 0x43, 0x33, 0x43, 0x33, 0x43, 0x33, 0x34, 0x33,
+  0x43, 0x43, 0x32, 0x33, 0x34, 0x42, 0x32, 0x32, 0x33, 0x24, 0x33, 0x33, 0x33, 0x33, 0x33, 0x32,
+  0x21, 0x11, 0x98, 0xCA, 0xCC, 0xEB, 0xCB, 0xDB, 0xBB, 0xBD, 0xDB, 0xBB, 0xBC, 0xAD, 0xCB, 0xBB,
+  0xBC, 0xBC, 0xBC, 0xCB, 0xCB, 0xBB, 0xBC, 0xCB, 0xCB, 0xBB, 0xBC, 0xCB, 0xCB, 0xCA, 0xBA, 0xCB,
+  0xBB, 0xBC, 0xBB, 0xCC, 0xBA, 0xCB, 0xBB, 0xCB, 0xCB, 0xCA, 0xBA, 0xCA, 0xBA, 0xCB, 0xBA, 0xCB,
+  0xBB, 0xCB, 0xBB, 0xCB, 0xBB, 0xCB, 0xBB, 0xCB, 0xBB, 0xCB, 0xBA, 0xBB, 0xAC, 0xBB, 0xAB, 0xAC,
+  0xBA, 0xAA, 0xAB, 0xA9, 0x99, 0x09, 0x10, 0x33, 0x45, 0x43, 0x53, 0x53, 0x33, 0x44, 0x33, 0x44,
+  0x33, 0x44, 0x33, 0x34, 0x53, 0x33, 0x43, 0x24, 0x24, 0x43, 0x33, 0x43, 0x43, 0x43, 0x42, 0x32,
+  0x43, 0x33, 0x34, 0x43, 0x33, 0x34, 0x43, 0x33, 0x34, 0x43, 0x33, 0x34, 0x43, 0x33, 0x34, 0x33,
+  0x34, 0x43, 0x33, 0x43, 0x43, 0x32, 0x43, 0x33, 0x43, 0x32, 0x34, 0x32, 0x24, 0x33, 0x43, 0x32,
+  0x43, 0x32, 0x33, 0x33, 0x24, 0x33, 0x33, 0x23, 0x33, 0x23, 0x12, 0x12, 0x91, 0xAA, 0xBB, 0xBD,
+  0xBC, 0xBC, 0xBD, 0xBC, 0xBC, 0xCC, 0xCA, 0xBB, 0xBC, 0xDB, 0xBB, 0xDB, 0xBB, 0xBC, 0xCB, 0xCB,
+  0x6E, 0x06, 0x13, 0x00, 0xCB, 0xBB, 0xDB, 0xBB, 0xCB, 0xCB, 0xBB, 0xDB, 0xBA, 0xBC, 0xBB, 0xBC,
+  0xCB, 0xCB, 0xBB, 0xCB, 0xCB, 0xBA, 0xBC, 0xBB, 0xBC, 0xCB, 0xBB, 0xCB, 0xCB, 0xBA, 0xAC, 0xCB,
+  0xBA, 0xBB, 0xBC, 0xBB, 0xBC, 0xCB, 0xBB, 0xBB, 0xBC, 0xCB, 0xBB, 0xBB, 0xBC, 0xBB, 0xAC, 0xBB,
+  0xCB, 0xBA, 0xAB, 0xBB, 0xBA, 0xBB, 0xAB, 0xAB, 0x99, 0x19, 0x11, 0x33, 0x53, 0x32, 0x53, 0x33,
+  0x35, 0x34, 0x34, 0x34, 0x34, 0x34, 0x34, 0x43, 0x24, 0x43, 0x33, 0x34, 0x34, 0x43, 0x33, 0x44,
+  0x32, 0x24, 0x24, 0x33, 0x34, 0x43, 0x33, 0x34, 0x43, 0x43, 0x33, 0x43, 0x43, 0x33, 0x43, 0x43,
+  0x42, 0x32, 0x33, 0x34, 0x43, 0x33, 0x34, 0x33, 0x34, 0x34, 0x42, 0x32, 0x43, 0x33, 0x33, 0x25,
+  0x33, 0x43, 0x33, 0x33, 0x25, 0x33, 0x33, 0x34, 0x33, 0x34, 0x33, 0x43, 0x32, 0x33, 0x43, 0x32,
+  0x23, 0x23, 0x33, 0x33, 0x13, 0x02, 0x91, 0x99, 0xAA, 0xBA, 0xBB, 0xBD, 0xBA, 0xBC, 0xBC, 0xBD,
+  0xCB, 0xCB, 0xBB, 0xBD, 0xCB, 0xCB, 0xBB, 0xBC, 0xBC, 0xBC, 0xBB, 0xAD, 0xAC, 0xBB, 0xBC, 0xCB,
+  0xCB, 0xCA, 0xBA, 0xCB, 0xBB, 0xBC, 0xAC, 0xCB, 0xBB, 0xCB, 0xCB, 0xBB, 0xCB, 0xCB, 0xBA, 0xBC,
+  0xBB, 0xBC, 0xCB, 0xCB, 0xBA, 0xCB, 0xBB, 0xCB, 0xCB, 0xBA, 0xAC, 0xBB, 0xAC, 0xCB, 0xBA, 0xCB,
+  0xBB, 0xCB, 0xBB, 0xCB, 0xBB, 0xCB, 0xBB, 0xBB, 0xBC, 0xCB, 0xBA, 0xBB, 0xAC, 0xBB, 0xCB, 0xBA,
+  0xBA, 0xBB, 0xBB, 0xBB, 0x9B, 0x9A, 0x99, 0x00, 0x11, 0x11, 0x13, 0x33, 0x33, 0x43, 0x32, 0x53,
+  0x33, 0x43, 0x43, 0x43, 0x33, 0x35, 0x43, 0x43, 0x42, 0x33, 0x43, 0x43, 0x43, 0x33, 0x34, 0x43,
+  0x43, 0x33, 0x34, 0x43, 0x43, 0x33, 0x34, 0x43, 0x33, 0x34, 0x43, 0x43, 0x33, 0x43, 0x43, 0x32,
+  0x74, 0xFF, 0x0B, 0x00, 0x43, 0x43, 0x33, 0x43, 0x33, 0x34, 0x43, 0x33, 0x34, 0x33, 0x25, 0x33,
+  0x43, 0x33, 0x34, 0x33, 0x34, 0x33, 0x34, 0x24, 0x33, 0x34, 0x42, 0x32, 0x33, 0x34, 0x43, 0x32,
+  0x33, 0x25, 0x32, 0x33, 0x33, 0x34, 0x32, 0x25, 0x12, 0x32, 0x23, 0x23, 0x31, 0x21, 0x11, 0x11,
+  0x00, 0x90, 0x90, 0xA9, 0xA9, 0xB9, 0xBA, 0xBA, 0xBB, 0xBB, 0xBC, 0xBA, 0xBC, 0xBB, 0xAE, 0xBA,
+  0xBB, 0xAD, 0xCB, 0xBB, 0xAC, 0xBC, 0xBB, 0xBD, 0xCB, 0xBB, 0xBC, 0xCB, 0xCB, 0xBB, 0xDB, 0xAB,
+  0xCB, 0xCB, 0xAB, 0xBC, 0xBB, 0xBC, 0xBC, 0xBB, 0xBC, 0xBC, 0xBB, 0xBD, 0xAB, 0xBC, 0xBB, 0xAD,
+  0xBB, 0xBC, 0xBB, 0xBC, 0xCB, 0xBB, 0xBC, 0xBB, 0xBC, 0xBC, 0xBB, 0xBC, 0xCB, 0xBB, 0xBC, 0xBB,
+  0xDB, 0xBA, 0xCB, 0xBA, 0xCB, 0xBA, 0xAC, 0xBB, 0xCB, 0xBB, 0xBB, 0xBD, 0xAA, 0xBB, 0xCB, 0xAA,
+  0xBB, 0xBB, 0xBB, 0xBB, 0xAB, 0xB9, 0xA9, 0xA9, 0x99, 0x99, 0x99, 0x09, 0x19, 0x00, 0x11, 0x11,
+  0x11, 0x12, 0x22, 0x31, 0x22, 0x22, 0x33, 0x32, 0x33, 0x33, 0x24, 0x32, 0x53, 0x22, 0x32, 0x53,
+  0x32, 0x32, 0x34, 0x53, 0x23, 0x43, 0x33, 0x34, 0x43, 0x33, 0x25, 0x33, 0x34, 0x24, 0x43, 0x42,
+  0x32, 0x43, 0x33, 0x53, 0x32, 0x53, 0x32, 0x33, 0x34, 0x43, 0x42, 0x32, 0x43, 0x33, 0x34, 0x43,
+  0x32, 0x34, 0x33, 0x34, 0x24, 0x43, 0x32, 0x24, 0x43, 0x32, 0x33, 0x34, 0x43, 0x33, 0x24, 0x33,
+  0x35, 0x32, 0x33, 0x35, 0x22, 0x33, 0x34, 0x32, 0x24, 0x32, 0x43, 0x22, 0x33, 0x33, 0x33, 0x33,
+  0x33, 0x22, 0x22, 0x22, 0x12, 0x22, 0x21, 0x11, 0x12, 0x11, 0x11, 0x11, 0x11, 0x10, 0x00, 0x00,
+  0x09, 0x09, 0x99, 0x99, 0x99, 0xA9, 0x99, 0x9A, 0x9A, 0xAA, 0xB9, 0x9A, 0xAB, 0xAA, 0xAB, 0xBA,
+  0xB1, 0x01, 0x00, 0x00, 0xBA, 0xBB, 0xBB, 0xBB, 0xBB, 0xBB, 0xAC, 0xBA, 0xBB, 0xAC, 0xBA, 0xAC,
+  0xBB, 0xCB, 0xAB, 0xCB, 0xBA, 0xCB, 0xAB, 0xDB, 0xAA, 0xAB, 0xDB, 0xAA, 0xBB, 0xCB, 0xBB, 0xCB,
+  0xBB, 0xDB, 0xAA, 0xBB, 0xDB, 0xAA, 0xBB, 0xCB, 0xAB, 0xBC, 0xBA, 0xAD, 0xBA, 0xBA, 0xAD, 0xBA,
+  0xBA, 0xBC, 0xBA, 0xAC, 0xBB, 0xCB, 0xAA, 0xCB, 0xAA, 0xBB, 0xAC, 0xBA, 0xBB, 0xBB, 0xAC, 0xAA,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+//! \brief Lock sample in the internal flash
+const S_ADPCM_SAMPLE gcsLockSample =
+{
+  gcau8LockBlocks,
+  2646u
+};
+
+//! \brief LineClear sample: 7717 samples, encoded by tools/adpcmenc from lineclear.wav
+static const U8 gcau8LineClearBlocks[ 4096u ] =
+{
+  0x00, 0x00, 0x00, 0x00, 0x77, 0x77, 0x17, 0x00, 0x80, 0x89, 0x88, 0x80, 0xB9, 0xDC, 0xBC, 0xBC,
+  0xBB, 0xBB, 0xCC, 0xDD, 0xCB, 0xBB, 0x89, 0x54, 0x46, 0x43, 0x33, 0x13, 0x81, 0x99, 0xBB, 0xAB,
+  0x9A, 0x9A, 0xDB, 0xCC, 0xBC, 0xBB, 0xAA, 0xBA, 0xEB, 0xCC, 0xBC, 0xAB, 0x28, 0x65, 0x35, 0x44,
+  0x22, 0x11, 0x80, 0x9A, 0xAB, 0xA9, 0x99, 0x99, 0xCB, 0xCC, 0xBB, 0xBB, 0xAA, 0xBA, 0xCD, 0xBD,
+  0xBC, 0x9A, 0x51, 0x55, 0x34, 0x34, 0x22, 0x01, 0x99, 0xAA, 0xAB, 0x9A, 0x99, 0xAA, 0xCC, 0xBC,
+  0xAC, 0xAA, 0xA9, 0xBA, 0xCE, 0xCB, 0xAB, 0x18, 0x55, 0x45, 0x43, 0x23, 0x02, 0x80, 0xAA, 0xAA,
+  0xAA, 0x99, 0x9A, 0xCB, 0xCC, 0xBB, 0xBB, 0x9A, 0xBB, 0xEC, 0xDB, 0xBB, 0x09, 0x62, 0x36, 0x35,
+  0x24, 0x12, 0x80, 0xA9, 0xAA, 0x9A, 0x99, 0x99, 0xBA, 0xCC, 0xBB, 0xAC, 0x99, 0x9A, 0xDB, 0xCC,
+  0xBB, 0x8A, 0x62, 0x55, 0x43, 0x33, 0x13, 0x81, 0xA9, 0xBA, 0xAB, 0xA9, 0x99, 0xCA, 0xDB, 0xCB,
+  0xAA, 0xA9, 0xA9, 0xCB, 0xCD, 0xBB, 0x0A, 0x61, 0x55, 0x43, 0x33, 0x22, 0x80, 0xA8, 0xAB, 0xAB,
+  0x9A, 0x99, 0xCA, 0xBC, 0xBC, 0xAB, 0x9A, 0xBA, 0xFB, 0xCB, 0xAC, 0x09, 0x53, 0x46, 0x43, 0x33,
+  0x12, 0x88, 0xA9, 0xAB, 0xAA, 0x99, 0xA9, 0xCB, 0xCC, 0xBA, 0x9B, 0x9A, 0xBA, 0xCD, 0xCC, 0xAA,
+  0x28, 0x55, 0x54, 0x23, 0x23, 0x02, 0x98, 0xAA, 0xAB, 0x9A, 0x9A, 0xB9, 0xCC, 0xCB, 0xAB, 0xAA,
+  0xA9, 0xCB, 0xCD, 0xAC, 0x8A, 0x42, 0x56, 0x43, 0x33, 0x12, 0x80, 0xA9, 0xAA, 0xAB, 0x99, 0xA9,
+  0xCA, 0xBC, 0xBC, 0xAA, 0x9A, 0xBA, 0xCD, 0xCC, 0x9A, 0x28, 0x46, 0x35, 0x34, 0x13, 0x01, 0xA8,
+  0xAA, 0xAA, 0x9A, 0x99, 0xBA, 0xCC, 0xAC, 0xAB, 0xA9, 0xA9, 0xCC, 0xCC, 0xAB, 0x19, 0x55, 0x35,
+  0xAC, 0x0A, 0x45, 0x00, 0x34, 0x22, 0x80, 0xA9, 0xAB, 0xAA, 0x99, 0xA9, 0xCB, 0xBC, 0xBC, 0xAA,
+  0x99, 0xCA, 0xCC, 0xDB, 0x8A, 0x30, 0x56, 0x44, 0x32, 0x12, 0x81, 0xA9, 0xAA, 0xAA, 0x89, 0xA9,
+  0xCA, 0xBC, 0xBB, 0xAB, 0x9A, 0xCB, 0xCD, 0xBC, 0x9A, 0x41, 0x56, 0x34, 0x33, 0x22, 0x80, 0xA9,
+  0xBB, 0xAA, 0x99, 0xAA, 0xDB, 0xBC, 0xBB, 0xAA, 0xAA, 0xDA, 0xBD, 0xBC, 0x8A, 0x62, 0x36, 0x35,
+  0x33, 0x12, 0x98, 0xB9, 0xAA, 0xAA, 0x99, 0xB9, 0xCC, 0xCB, 0xBA, 0xA9, 0xA9, 0xCC, 0xBC, 0xAC,
+  0x19, 0x74, 0x34, 0x25, 0x13, 0x01, 0x98, 0xAA, 0xAA, 0x99, 0x99, 0xB9, 0xBD, 0xBB, 0xBB, 0xA9,
+  0xDA, 0xCC, 0xCB, 0x9A, 0x41, 0x56, 0x34, 0x33, 0x12, 0x90, 0xA9, 0xBB, 0x9A, 0x99, 0xAA, 0xCC,
+  0xCB, 0xAA, 0xAA, 0xA9, 0xEB, 0xBC, 0xBB, 0x28, 0x66, 0x44, 0x33, 0x22, 0x81, 0xA8, 0xAB, 0xAA,
+  0x99, 0xA9, 0xCB, 0xBC, 0xAC, 0x9A, 0x9A, 0xCB, 0xDC, 0xAB, 0x09, 0x73, 0x45, 0x43, 0x22, 0x01,
+  0x98, 0xAA, 0x9A, 0x99, 0x99, 0xBA, 0xCC, 0xBB, 0xAA, 0xA9, 0xCA, 0xCD, 0xBB, 0x8A, 0x73, 0x36,
+  0x44, 0x22, 0x01, 0x98, 0xAA, 0xA9, 0x99, 0x98, 0xBA, 0xDB, 0xBB, 0xAA, 0xA9, 0xCA, 0xCD, 0xBB,
+  0x0A, 0x73, 0x45, 0x34, 0x23, 0x01, 0x98, 0xBA, 0xAA, 0x99, 0xA8, 0xCA, 0xCB, 0xBB, 0xAB, 0xA9,
+  0xDB, 0xDC, 0xAB, 0x09, 0x64, 0x54, 0x33, 0x23, 0x81, 0x99, 0xBA, 0xAA, 0x99, 0xA9, 0xCB, 0xBC,
+  0xBB, 0xAB, 0xB9, 0xCC, 0xCD, 0xAA, 0x28, 0x65, 0x44, 0x33, 0x12, 0x80, 0xA9, 0xBA, 0xA9, 0x98,
+  0xAA, 0xBC, 0xBC, 0xAB, 0xAA, 0xBA, 0xDD, 0xCB, 0x9A, 0x51, 0x46, 0x53, 0x22, 0x01, 0x88, 0xAA,
+  0xA9, 0x89, 0x99, 0xBA, 0xDB, 0xAB, 0xAA, 0xA9, 0xDB, 0xCC, 0xAB, 0x29, 0x65, 0x35, 0x24, 0x12,
+  0x77, 0x4A, 0x45, 0x00, 0x98, 0xA9, 0x9A, 0x99, 0x98, 0xBA, 0xBC, 0xAC, 0xA9, 0x99, 0xDB, 0xCC,
+  0xAA, 0x38, 0x56, 0x44, 0x23, 0x12, 0x90, 0xA9, 0xAA, 0x8A, 0x99, 0xBA, 0xBC, 0xBC, 0xAA, 0xA9,
+  0xDA, 0xCC, 0xAB, 0x09, 0x65, 0x44, 0x43, 0x12, 0x80, 0x99, 0xAA, 0x99, 0x89, 0x9A, 0xCB, 0xCB,
+  0x9A, 0x9A, 0xB9, 0xCD, 0xAC, 0x89, 0x54, 0x45, 0x33, 0x23, 0x81, 0xA9, 0xBA, 0xAA, 0x98, 0xBA,
+  0xBC, 0xBD, 0xAA, 0x99, 0xCA, 0xCC, 0xCB, 0x09, 0x73, 0x54, 0x33, 0x22, 0x80, 0x99, 0xAB, 0xA9,
+  0x98, 0xAA, 0xBC, 0xBC, 0xAA, 0x9A, 0xCB, 0xDC, 0xBB, 0x19, 0x55, 0x45, 0x43, 0x11, 0x00, 0xA9,
+  0x9A, 0x99, 0x89, 0xAA, 0xCB, 0xBB, 0xAA, 0x9A, 0xEB, 0xBC, 0xAC, 0x10, 0x56, 0x44, 0x23, 0x02,
+  0x90, 0xA9, 0x9B, 0x99, 0x99, 0xBA, 0xCC, 0xBA, 0x99, 0xAA, 0xEB, 0xBC, 0x9A, 0x51, 0x46, 0x34,
+  0x33, 0x81, 0xA8, 0xAA, 0x9A, 0x99, 0xAA, 0xDB, 0xBB, 0xAB, 0xAA, 0xCA, 0xCD, 0xAC, 0x19, 0x64,
+  0x44, 0x33, 0x22, 0x90, 0xB9, 0xAA, 0x99, 0xA9, 0xBA, 0xCC, 0xBB, 0x9A, 0xAA, 0xCC, 0xBD, 0x9A,
+  0x51, 0x46, 0x34, 0x23, 0x01, 0x99, 0xBA, 0xA9, 0x89, 0xAA, 0xBC, 0xBC, 0xAA, 0xA9, 0xDA, 0xCC,
+  0x9B, 0x39, 0x47, 0x35, 0x33, 0x12, 0xA8, 0xAA, 0xAA, 0x99, 0xA9, 0xCB, 0xBC, 0xAB, 0xA9, 0xCA,
+  0xCC, 0xAC, 0x1A, 0x55, 0x35, 0x34, 0x02, 0x90, 0xA9, 0x9A, 0x99, 0x99, 0xCA, 0xBB, 0xBB, 0xAA,
+  0xBA, 0xCE, 0xBC, 0x09, 0x73, 0x45, 0x33, 0x13, 0x90, 0xA9, 0xAB, 0x99, 0xA8, 0xCA, 0xCB, 0xAB,
+  0xA9, 0xB9, 0xCD, 0xAC, 0x0A, 0x73, 0x45, 0x33, 0x13, 0x90, 0xAA, 0xAA, 0x99, 0x99, 0xCA, 0xCB,
+  0xAB, 0x99, 0xBA, 0xCD, 0xAC, 0x1A, 0x64, 0x35, 0x34, 0x11, 0x90, 0x9A, 0xAA, 0x89, 0x99, 0xBB,
+  0xCD, 0xFD, 0x38, 0x00, 0xBC, 0x9A, 0xAA, 0xCC, 0xBD, 0x8A, 0x71, 0x54, 0x33, 0x13, 0x81, 0xAA,
+  0xAA, 0x99, 0x99, 0xBB, 0xBD, 0xAB, 0x9A, 0xBA, 0xCE, 0xBB, 0x1A, 0x74, 0x35, 0x34, 0x11, 0x90,
+  0xAA, 0xA9, 0x98, 0x99, 0xBB, 0xAD, 0xAA, 0xA9, 0xCA, 0xCC, 0xAB, 0x48, 0x56, 0x34, 0x23, 0x01,
+  0xA9, 0xAA, 0x9A, 0x98, 0xAA, 0xCC, 0xAA, 0x9A, 0xAA, 0xCC, 0xBC, 0x8A, 0x64, 0x45, 0x33, 0x12,
+  0x88, 0xAA, 0xAA, 0x89, 0xA9, 0xCB, 0xCB, 0x9A, 0x9A, 0xCA, 0xBD, 0xAB, 0x50, 0x46, 0x25, 0x13,
+  0x81, 0xA8, 0x9A, 0x8A, 0x99, 0xB9, 0xBC, 0xAB, 0x9A, 0xBA, 0xCE, 0xBB, 0x29, 0x66, 0x34, 0x24,
+  0x01, 0x98, 0x9A, 0x9A, 0x98, 0xA9, 0xCB, 0xAB, 0x9A, 0xAA, 0xDC, 0xAC, 0x0A, 0x73, 0x36, 0x33,
+  0x12, 0x98, 0xAA, 0xAA, 0x89, 0xAA, 0xDB, 0xBB, 0x9A, 0xAA, 0xEB, 0xBC, 0x9A, 0x73, 0x36, 0x24,
+  0x12, 0x90, 0xA9, 0x9A, 0x99, 0xA8, 0xBB, 0xBC, 0xAA, 0xA9, 0xCC, 0xCC, 0x8A, 0x62, 0x45, 0x43,
+  0x11, 0x90, 0xA9, 0x99, 0x89, 0x99, 0xBB, 0xAC, 0xAA, 0x99, 0xCC, 0xBC, 0x8A, 0x73, 0x36, 0x24,
+  0x12, 0x98, 0xA9, 0x9A, 0x98, 0x99, 0xCB, 0xAB, 0xAA, 0xB9, 0xCC, 0xAD, 0x0A, 0x64, 0x35, 0x24,
+  0x01, 0x98, 0xA9, 0x99, 0x98, 0xA9, 0xCB, 0xAB, 0x9A, 0xB9, 0xCD, 0xAC, 0x18, 0x56, 0x34, 0x33,
+  0x01, 0xA9, 0xAB, 0x99, 0x99, 0xCA, 0xCB, 0xAA, 0x99, 0xCA, 0xCC, 0x9B, 0x50, 0x46, 0x34, 0x12,
+  0x80, 0xAA, 0xA9, 0x98, 0x99, 0xBB, 0xBC, 0xAA, 0xA9, 0xCC, 0xAD, 0x0A, 0x64, 0x44, 0x33, 0x02,
+  0xA8, 0xAA, 0x99, 0x99, 0xBA, 0xDB, 0xAA, 0x9A, 0xBA, 0xBE, 0xAC, 0x40, 0x56, 0x43, 0x12, 0x80,
+  0x9A, 0x9A, 0x89, 0x99, 0xBA, 0xAC, 0xAA, 0xA9, 0xEB, 0xCB, 0x09, 0x55, 0x35, 0x33, 0x82, 0xA8,
+  0x5A, 0x24, 0x3F, 0x00, 0x9A, 0x99, 0x99, 0xBC, 0xAB, 0xAA, 0xB9, 0xDD, 0xBB, 0x28, 0x57, 0x34,
+  0x23, 0x81, 0xA9, 0xAA, 0x99, 0xA8, 0xCA, 0xCB, 0x9A, 0x99, 0xDB, 0xBC, 0x09, 0x74, 0x44, 0x32,
+  0x81, 0x98, 0xAA, 0x99, 0x98, 0xAA, 0xBC, 0xAA, 0xA9, 0xDA, 0xCC, 0x89, 0x62, 0x45, 0x33, 0x02,
+  0x98, 0x9B, 0x9A, 0x98, 0xBA, 0xBC, 0xAB, 0x9A, 0xDB, 0xCC, 0x8B, 0x72, 0x54, 0x23, 0x02, 0x98,
+  0x9A, 0x9A, 0x98, 0xB9, 0xAC, 0xAB, 0xA9, 0xCA, 0xCD, 0x8A, 0x62, 0x45, 0x33, 0x02, 0xA8, 0xA9,
+  0x9A, 0x89, 0xBA, 0xBC, 0xAB, 0xA9, 0xDB, 0xBD, 0x8A, 0x73, 0x36, 0x33, 0x02, 0xA8, 0xAA, 0x8A,
+  0x99, 0xBB, 0xAD, 0x9B, 0xA9, 0xDB, 0xBC, 0x0A, 0x65, 0x35, 0x33, 0x81, 0xA9, 0xAA, 0x89, 0xA9,
+  0xCA, 0xBB, 0x9B, 0xAA, 0xCD, 0xAC, 0x29, 0x47, 0x35, 0x12, 0x91, 0xA9, 0x99, 0x99, 0xA8, 0xCB,
+  0xAA, 0x9A, 0xBA, 0xCD, 0xAB, 0x51, 0x47, 0x33, 0x12, 0x98, 0xAA, 0x9A, 0x98, 0xBA, 0xBC, 0xAA,
+  0x9A, 0xEB, 0xBC, 0x89, 0x74, 0x44, 0x22, 0x81, 0xA8, 0xA9, 0x98, 0x99, 0xBA, 0xCB, 0x99, 0xAA,
+  0xDC, 0xAB, 0x40, 0x56, 0x24, 0x12, 0x90, 0x9A, 0x8A, 0x89, 0xAA, 0xBB, 0x9C, 0x99, 0xCB, 0xBD,
+  0x0A, 0x55, 0x45, 0x22, 0x81, 0x99, 0x9A, 0x89, 0x99, 0xBB, 0xBB, 0x9A, 0xCA, 0xCD, 0xAA, 0x51,
+  0x46, 0x24, 0x02, 0x98, 0x9A, 0x99, 0x98, 0xAA, 0xBB, 0x9B, 0xAA, 0xCD, 0xAC, 0x28, 0x57, 0x43,
+  0x12, 0x90, 0xA9, 0x99, 0x98, 0xB9, 0xBB, 0xAB, 0xA9, 0xCC, 0xBD, 0x09, 0x65, 0x44, 0x22, 0x80,
+  0xA9, 0x99, 0x89, 0xA9, 0xCA, 0x9A, 0x99, 0xCA, 0xBC, 0x8A, 0x74, 0x44, 0x23, 0x81, 0xA9, 0xA9,
+  0x98, 0x99, 0xCB, 0xAA, 0x9A, 0xC9, 0xCC, 0x8A, 0x72, 0x35, 0x24, 0x81, 0xA8, 0xA9, 0x98, 0xA8,
+  0x18, 0x04, 0x3B, 0x00, 0xBB, 0x9A, 0xAA, 0xFB, 0xAB, 0x39, 0x67, 0x33, 0x13, 0x98, 0xAA, 0x99,
+  0x99, 0xBA, 0xCB, 0xAA, 0xA9, 0xDC, 0xBB, 0x48, 0x47, 0x34, 0x02, 0x90, 0xAA, 0x99, 0x98, 0xAA,
+  0xAC, 0x9A, 0xA9, 0xDC, 0x9B, 0x58, 0x55, 0x24, 0x11, 0xA8, 0x99, 0x99, 0x98, 0xAA, 0xBB, 0x9A,
+  0xBA, 0xBE, 0x9C, 0x61, 0x55, 0x22, 0x82, 0xA8, 0xA9, 0x98, 0xA8, 0xBA, 0xBB, 0xA9, 0xDA, 0xCC,
+  0x89, 0x73, 0x36, 0x22, 0x80, 0xA9, 0x99, 0x89, 0xB9, 0xBB, 0xAB, 0xA9, 0xCC, 0xAD, 0x29, 0x57,
+  0x43, 0x02, 0x90, 0x9A, 0x99, 0x98, 0xAA, 0xBB, 0x9A, 0xBA, 0xDD, 0x9A, 0x61, 0x45, 0x33, 0x01,
+  0xA9, 0x9A, 0x99, 0xA8, 0xAC, 0xAB, 0x99, 0xDB, 0xBC, 0x19, 0x66, 0x34, 0x12, 0x90, 0x9A, 0x8A,
+  0x99, 0xB9, 0xAC, 0x9A, 0xA9, 0xDC, 0x9A, 0x51, 0x37, 0x24, 0x81, 0xA8, 0x99, 0x89, 0xA9, 0xBA,
+  0xAB, 0x9A, 0xEB, 0xCB, 0x29, 0x47, 0x25, 0x12, 0x98, 0x9A, 0x89, 0x99, 0xB9, 0xAB, 0x9A, 0xCA,
+  0xCC, 0x8A, 0x73, 0x36, 0x23, 0x90, 0xA9, 0x99, 0x89, 0xAA, 0xAC, 0x9A, 0xA9, 0xDC, 0xAA, 0x61,
+  0x45, 0x33, 0x81, 0x99, 0xAA, 0x98, 0xA9, 0xCB, 0xAA, 0x99, 0xEB, 0xBB, 0x40, 0x47, 0x24, 0x02,
+  0x99, 0xA9, 0x98, 0xA8, 0xBA, 0xAB, 0xA9, 0xDB, 0xBC, 0x29, 0x67, 0x43, 0x11, 0x98, 0x9A, 0x98,
+  0x98, 0xBA, 0xAB, 0x99, 0xCB, 0xBD, 0x19, 0x57, 0x43, 0x12, 0x98, 0xA9, 0x89, 0x99, 0xBA, 0xBB,
+  0x99, 0xDB, 0xBC, 0x1A, 0x57, 0x34, 0x03, 0x90, 0xAA, 0x99, 0xA8, 0xBA, 0xAC, 0x99, 0xBA, 0xBE,
+  0x19, 0x66, 0x24, 0x12, 0x98, 0xA9, 0x89, 0x99, 0xBA, 0xAB, 0x9A, 0xDB, 0xBC, 0x29, 0x67, 0x43,
+  0x01, 0x98, 0x99, 0x89, 0xA8, 0xAA, 0xAB, 0x99, 0xDB, 0xAC, 0x38, 0x67, 0x33, 0x01, 0x99, 0x9A,
+  0x3F, 0x10, 0x3E, 0x00, 0x98, 0xAA, 0xBB, 0x99, 0xCA, 0xBD, 0x1A, 0x66, 0x24, 0x12, 0x98, 0xA9,
+  0x89, 0x99, 0xBA, 0xAB, 0xA9, 0xDB, 0xBC, 0x38, 0x77, 0x23, 0x01, 0x99, 0x99, 0x89, 0xA9, 0xBA,
+  0xAA, 0xA9, 0xBD, 0xAC, 0x72, 0x45, 0x22, 0x80, 0xA9, 0x99, 0x98, 0xB9, 0xBA, 0x9A, 0xC9, 0xBD,
+  0x1A, 0x56, 0x35, 0x11, 0x98, 0xA9, 0x98, 0x99, 0xBA, 0xAB, 0x99, 0xCC, 0xAC, 0x50, 0x46, 0x23,
+  0x81, 0x99, 0x9A, 0x98, 0xAA, 0xAC, 0x99, 0xB9, 0xBD, 0x0B, 0x66, 0x34, 0x12, 0x98, 0x9A, 0x89,
+  0xA9, 0xCA, 0x9A, 0x99, 0xDB, 0xBB, 0x61, 0x46, 0x23, 0x81, 0x9A, 0x8A, 0x99, 0xB9, 0xBB, 0x9A,
+  0xCA, 0xBD, 0x1A, 0x67, 0x33, 0x02, 0xA8, 0xA9, 0x98, 0xA9, 0xCB, 0x9A, 0xA9, 0xCC, 0x8B, 0x73,
+  0x27, 0x03, 0x90, 0x99, 0x89, 0x99, 0xAA, 0x9B, 0xA9, 0xDB, 0x9C, 0x50, 0x46, 0x23, 0x80, 0xA9,
+  0x99, 0x98, 0xBA, 0xAB, 0x9A, 0xDA, 0xBC, 0x39, 0x77, 0x32, 0x81, 0x99, 0x99, 0x98, 0xA9, 0xBA,
+  0x99, 0xBA, 0xCD, 0x19, 0x75, 0x33, 0x02, 0xA8, 0x9A, 0x89, 0xB9, 0xBB, 0xAA, 0xC9, 0xDC, 0x09,
+  0x64, 0x25, 0x12, 0x99, 0x99, 0x89, 0xA9, 0xBA, 0x9A, 0xB9, 0xDC, 0x8A, 0x74, 0x34, 0x12, 0xA8,
+  0x99, 0x99, 0xA8, 0xBB, 0xAA, 0xB9, 0xCD, 0x0B, 0x74, 0x44, 0x11, 0x98, 0x99, 0x89, 0xA8, 0xAA,
+  0x9A, 0xB9, 0xCC, 0x8A, 0x65, 0x44, 0x11, 0x98, 0x9A, 0x88, 0xA9, 0xAA, 0x9A, 0xA9, 0xDC, 0x09,
+  0x74, 0x43, 0x02, 0x99, 0x99, 0x89, 0xA9, 0xBA, 0x99, 0xBA, 0xCD, 0x19, 0x47, 0x34, 0x81, 0xA8,
+  0x99, 0x98, 0xB9, 0xBA, 0x99, 0xCA, 0xAD, 0x49, 0x56, 0x23, 0x81, 0xA9, 0x99, 0x98, 0xBA, 0xAB,
+  0xA9, 0xEB, 0xAB, 0x61, 0x37, 0x23, 0x88, 0xAA, 0x89, 0x99, 0xBB, 0xAA, 0xB9, 0xDC, 0x8B, 0x74,
+  0x25, 0x02, 0x42, 0x00, 0x24, 0x81, 0x9A, 0x99, 0x98, 0xAB, 0xAB, 0xA9, 0xEB, 0x9B, 0x72, 0x36,
+  0x13, 0x98, 0x9A, 0x89, 0xA9, 0xAB, 0x9B, 0xB9, 0xBE, 0x1A, 0x76, 0x33, 0x01, 0x99, 0x9A, 0x98,
+  0xAA, 0xBB, 0x99, 0xDB, 0xAC, 0x50, 0x37, 0x14, 0x90, 0x99, 0x89, 0xA8, 0xAA, 0x9A, 0xA9, 0xCC,
+  0x0A, 0x65, 0x34, 0x02, 0xA8, 0x9A, 0x98, 0xB9, 0xAB, 0x9A, 0xDB, 0xAC, 0x60, 0x45, 0x23, 0x90,
+  0x9A, 0x89, 0xA9, 0xBA, 0x9B, 0xB9, 0xBE, 0x1A, 0x57, 0x24, 0x82, 0x99, 0x8A, 0x98, 0xAA, 0x9B,
+  0xA9, 0xDB, 0xAB, 0x73, 0x37, 0x02, 0xA0, 0x99, 0x98, 0x99, 0xAB, 0x99, 0xCA, 0xBC, 0x58, 0x46,
+  0x23, 0x80, 0x9A, 0x99, 0xA8, 0xBA, 0x9B, 0xB9, 0xBE, 0x1A, 0x57, 0x24, 0x01, 0xA9, 0x89, 0x89,
+  0xAA, 0x9B, 0xA9, 0xEB, 0x9A, 0x64, 0x35, 0x11, 0x99, 0x8A, 0x89, 0xAA, 0xAA, 0x9A, 0xDA, 0x9C,
+  0x61, 0x36, 0x12, 0x98, 0x9A, 0x98, 0xA9, 0xBA, 0x99, 0xDA, 0xBB, 0x60, 0x37, 0x23, 0x90, 0xAA,
+  0x89, 0xA9, 0xBB, 0x9A, 0xDA, 0xAC, 0x48, 0x47, 0x23, 0x90, 0xA9, 0x89, 0x99, 0xBB, 0x9A, 0xC9,
+  0xBC, 0x49, 0x57, 0x13, 0x91, 0xA9, 0x98, 0xA8, 0xBA, 0x99, 0xBA, 0xBD, 0x49, 0x57, 0x13, 0x91,
+  0xA9, 0x98, 0xA8, 0xBA, 0x99, 0xBA, 0xBD, 0x49, 0x57, 0x13, 0x80, 0x9A, 0x98, 0xA8, 0xBA, 0x99,
+  0xBA, 0xBD, 0x58, 0x56, 0x22, 0x90, 0xA9, 0x98, 0xA8, 0xBA, 0x99, 0xC9, 0xAC, 0x50, 0x37, 0x13,
+  0x90, 0xAA, 0x98, 0xA9, 0xBB, 0x99, 0xDB, 0x9C, 0x71, 0x35, 0x03, 0xA8, 0x99, 0x89, 0xAA, 0xAB,
+  0xA9, 0xEB, 0x8B, 0x74, 0x34, 0x82, 0xA8, 0x99, 0x98, 0xBA, 0xAA, 0xA9, 0xDC, 0x09, 0x56, 0x24,
+  0x80, 0x99, 0x89, 0x98, 0xBA, 0x99, 0xB9, 0xAD, 0x49, 0x47, 0x23, 0x98, 0x99, 0x89, 0xA9, 0xAB,
+  0xEA, 0xF4, 0x38, 0x00, 0xA9, 0xCC, 0x19, 0x57, 0x23, 0x91, 0xA9, 0x98, 0x99, 0xAB, 0x9A, 0xCA,
+  0xBC, 0x61, 0x46, 0x12, 0xA8, 0x89, 0x89, 0xA9, 0x9B, 0x99, 0xDB, 0x8A, 0x65, 0x34, 0x81, 0x99,
+  0x99, 0xA8, 0xAA, 0x9A, 0xB9, 0xAE, 0x48, 0x56, 0x12, 0x90, 0x99, 0x89, 0xA9, 0xAA, 0x99, 0xDA,
+  0x8B, 0x74, 0x34, 0x01, 0xA9, 0x89, 0x99, 0xBA, 0x99, 0xBA, 0xBD, 0x58, 0x37, 0x14, 0x98, 0x99,
+  0x88, 0x9A, 0x9B, 0x99, 0xDB, 0x8A, 0x65, 0x34, 0x81, 0xA9, 0x89, 0x99, 0xBA, 0x99, 0xBA, 0xBD,
+  0x61, 0x46, 0x02, 0x98, 0x99, 0x98, 0xA9, 0x9A, 0x99, 0xBC, 0x2A, 0x77, 0x22, 0x90, 0x99, 0x88,
+  0xA9, 0x9A, 0x99, 0xCA, 0x9B, 0x65, 0x25, 0x01, 0xA9, 0x89, 0x98, 0xAA, 0x9A, 0xB9, 0xAD, 0x61,
+  0x36, 0x12, 0x99, 0x9A, 0x98, 0xAA, 0x9A, 0xAA, 0xBD, 0x49, 0x57, 0x12, 0x90, 0x99, 0x98, 0xA9,
+  0x9A, 0xA9, 0xDB, 0x09, 0x57, 0x23, 0x90, 0x99, 0x89, 0xA9, 0xAB, 0x99, 0xDB, 0x0B, 0x75, 0x24,
+  0x80, 0x99, 0x98, 0xA8, 0x9A, 0x99, 0xCA, 0x9B, 0x74, 0x25, 0x01, 0xA9, 0x98, 0x98, 0xAA, 0x8A,
+  0xBA, 0x9D, 0x72, 0x35, 0x01, 0x99, 0x99, 0xA8, 0xAA, 0x99, 0xCA, 0xBB, 0x72, 0x37, 0x01, 0xA8,
+  0x98, 0x98, 0xAA, 0x8A, 0xBA, 0x9D, 0x70, 0x35, 0x02, 0xA9, 0x89, 0x99, 0xAA, 0x9A, 0xC9, 0x9C,
+  0x61, 0x36, 0x02, 0xA9, 0x89, 0x99, 0xAA, 0x9A, 0xC9, 0x9C, 0x71, 0x35, 0x01, 0x99, 0x89, 0x99,
+  0xAB, 0x99, 0xBA, 0x9E, 0x72, 0x25, 0x01, 0xA9, 0x88, 0x99, 0xAA, 0x99, 0xBA, 0x8D, 0x73, 0x26,
+  0x80, 0x98, 0x89, 0xA8, 0x9A, 0x98, 0xCA, 0x0A, 0x75, 0x23, 0x80, 0x9A, 0x98, 0xA9, 0xAA, 0x99,
+  0xCC, 0x29, 0x57, 0x13, 0x98, 0x99, 0x98, 0xA9, 0x9A, 0xB9, 0xBC, 0x58, 0x47, 0x12, 0xA8, 0x89,
+  0xC5, 0x08, 0x3E, 0x00, 0x99, 0xAA, 0x98, 0xCB, 0x2A, 0x67, 0x22, 0x98, 0x99, 0x98, 0xA9, 0x99,
+  0xA9, 0xBC, 0x50, 0x37, 0x03, 0xA8, 0x99, 0xA8, 0xAA, 0x9A, 0xCA, 0x9C, 0x73, 0x26, 0x81, 0x99,
+  0x98, 0xA8, 0x9A, 0x99, 0xCA, 0x1A, 0x67, 0x22, 0x98, 0x99, 0x98, 0xA9, 0x99, 0xA9, 0xBC, 0x70,
+  0x35, 0x02, 0x99, 0x99, 0xA8, 0xBA, 0x99, 0xDA, 0x8B, 0x66, 0x33, 0x90, 0x9A, 0x98, 0xB9, 0x9A,
+  0xA9, 0xBD, 0x58, 0x37, 0x03, 0xA8, 0x99, 0xA8, 0xBA, 0x99, 0xDA, 0x8B, 0x75, 0x33, 0x80, 0x9A,
+  0x89, 0xAA, 0x9B, 0xA9, 0xBD, 0x58, 0x37, 0x03, 0xA8, 0x99, 0xA8, 0xBA, 0x99, 0xDA, 0x0B, 0x75,
+  0x33, 0x90, 0x9A, 0x98, 0xB9, 0x9A, 0xB9, 0xAD, 0x70, 0x35, 0x82, 0x99, 0x89, 0xA9, 0xAA, 0x99,
+  0xBC, 0x2B, 0x77, 0x13, 0x98, 0x99, 0x98, 0xA9, 0x99, 0xB9, 0x9C, 0x74, 0x24, 0x80, 0x99, 0x89,
+  0xA9, 0x9A, 0xA8, 0xBC, 0x60, 0x36, 0x02, 0xA9, 0x98, 0x99, 0x9B, 0x9A, 0xDB, 0x2A, 0x67, 0x12,
+  0x98, 0x89, 0x89, 0xAA, 0x89, 0xBA, 0x8B, 0x76, 0x23, 0x80, 0x9A, 0x98, 0xAA, 0x9A, 0xC9, 0xAB,
+  0x72, 0x37, 0x80, 0x99, 0x88, 0xA9, 0x99, 0xA9, 0xBB, 0x70, 0x36, 0x02, 0x9A, 0x89, 0xA9, 0xAA,
+  0x99, 0xBC, 0x49, 0x67, 0x01, 0x98, 0x98, 0x98, 0x99, 0x99, 0xC9, 0x29, 0x56, 0x13, 0x99, 0x99,
+  0x98, 0xAA, 0x99, 0xDA, 0x1A, 0x66, 0x22, 0x98, 0x8A, 0x98, 0xAA, 0x99, 0xC9, 0x0B, 0x57, 0x13,
+  0x90, 0x8A, 0x99, 0xAA, 0x99, 0xCA, 0x8B, 0x57, 0x14, 0x90, 0x99, 0x98, 0xA9, 0x99, 0xB9, 0x0C,
+  0x74, 0x14, 0x90, 0x89, 0x98, 0x9A, 0x99, 0xC9, 0x8A, 0x65, 0x14, 0x90, 0x99, 0x98, 0xA9, 0x89,
+  0xBA, 0x8B, 0x67, 0x23, 0x98, 0x99, 0x98, 0xBA, 0x89, 0xCB, 0x1B, 0x67, 0x22, 0xA8, 0x89, 0x98,
+  0x89, 0xFE, 0x3C, 0x00, 0x8A, 0xA9, 0xBB, 0x72, 0x27, 0x81, 0x99, 0x98, 0x99, 0x8A, 0xA9, 0x9C,
+  0x73, 0x25, 0x80, 0x8A, 0x89, 0xA9, 0x99, 0xB9, 0x8C, 0x65, 0x14, 0x88, 0x99, 0x98, 0xA9, 0x89,
+  0xCA, 0x1A, 0x57, 0x12, 0xA8, 0x98, 0x98, 0xAA, 0x98, 0xCB, 0x49, 0x47, 0x01, 0xA8, 0x88, 0x99,
+  0x9A, 0x99, 0xCB, 0x61, 0x35, 0x92, 0x99, 0x89, 0xAA, 0x9A, 0xC9, 0x9B, 0x74, 0x25, 0x90, 0x99,
+  0x98, 0xA9, 0x89, 0xBA, 0x1B, 0x77, 0x12, 0xA8, 0x88, 0x99, 0xA9, 0x98, 0xBB, 0x68, 0x46, 0x81,
+  0x99, 0x88, 0xA9, 0x99, 0xA8, 0x9C, 0x73, 0x25, 0x90, 0x99, 0x98, 0xA9, 0x89, 0xBA, 0x2B, 0x77,
+  0x02, 0x98, 0x98, 0x98, 0x9A, 0x98, 0xBB, 0x70, 0x26, 0x81, 0x99, 0x98, 0xA9, 0x99, 0xB9, 0x8B,
+  0x67, 0x13, 0x98, 0x99, 0x98, 0xAA, 0x99, 0xCB, 0x58, 0x37, 0x01, 0x9A, 0x88, 0xAA, 0x99, 0xB9,
+  0x9C, 0x75, 0x13, 0x90, 0x8A, 0xA8, 0x9A, 0x99, 0xCB, 0x59, 0x37, 0x82, 0x9A, 0x88, 0xAA, 0x99,
+  0xB9, 0x8C, 0x75, 0x13, 0x98, 0x89, 0x99, 0xAA, 0xA8, 0xCB, 0x60, 0x36, 0x91, 0x99, 0x98, 0xA9,
+  0x99, 0xBA, 0x0B, 0x77, 0x03, 0x98, 0x89, 0x99, 0x9A, 0xA8, 0xBB, 0x73, 0x27, 0x90, 0x89, 0x98,
+  0x99, 0x99, 0xB9, 0x4A, 0x47, 0x82, 0x99, 0x88, 0xA9, 0x8A, 0xB9, 0x0C, 0x65, 0x13, 0x98, 0x99,
+  0xA8, 0xAA, 0xA8, 0xBC, 0x72, 0x26, 0x80, 0x8A, 0x98, 0xA9, 0x89, 0xCA, 0x38, 0x57, 0x01, 0x99,
+  0x89, 0x99, 0x99, 0xB9, 0x0A, 0x67, 0x02, 0x98, 0x89, 0x99, 0x99, 0xA9, 0x9B, 0x74, 0x15, 0x90,
+  0x99, 0x98, 0x99, 0x99, 0xAB, 0x71, 0x26, 0x90, 0x89, 0x98, 0xA9, 0x98, 0xCA, 0x48, 0x37, 0x81,
+  0x99, 0x89, 0xAA, 0x89, 0xCA, 0x29, 0x67, 0x01, 0x99, 0x88, 0x99, 0x99, 0xA9, 0x0A, 0x57, 0x02,
+  0x27, 0x11, 0x41, 0x00, 0x99, 0x88, 0x9A, 0x99, 0xBA, 0x78, 0x35, 0x91, 0x99, 0x98, 0xAA, 0x99,
+  0xCA, 0x59, 0x37, 0x81, 0x8A, 0x89, 0xAA, 0x89, 0xCA, 0x39, 0x67, 0x81, 0x89, 0x98, 0x99, 0x98,
+  0xB9, 0x29, 0x67, 0x81, 0x98, 0x88, 0xA9, 0x98, 0xA9, 0x2A, 0x57, 0x02, 0xA9, 0x88, 0xA9, 0x99,
+  0xB9, 0x2A, 0x77, 0x01, 0x89, 0x89, 0xA8, 0x89, 0xB9, 0x29, 0x57, 0x82, 0x99, 0x88, 0xA9, 0x99,
+  0xB9, 0x3A, 0x77, 0x01, 0x99, 0x88, 0x99, 0x89, 0xAA, 0x39, 0x67, 0x81, 0x99, 0x88, 0x99, 0x89,
+  0xAA, 0x59, 0x36, 0x81, 0x9A, 0x98, 0x9A, 0x99, 0xCB, 0x60, 0x26, 0x91, 0x99, 0x98, 0x9A, 0x99,
+  0xAB, 0x71, 0x17, 0x90, 0x88, 0x89, 0x8A, 0x99, 0x9B, 0x73, 0x16, 0x98, 0x89, 0x98, 0x99, 0xA8,
+  0x8A, 0x65, 0x03, 0x98, 0x89, 0x9A, 0x9A, 0xB9, 0x2B, 0x77, 0x02, 0x99, 0x98, 0x99, 0x89, 0xBA,
+  0x59, 0x27, 0x81, 0x99, 0x98, 0xA9, 0x89, 0xBB, 0x71, 0x17, 0x90, 0x98, 0x98, 0x89, 0x99, 0x8B,
+  0x73, 0x06, 0x98, 0x88, 0x98, 0x99, 0xB8, 0x19, 0x47, 0x82, 0x99, 0x88, 0xAA, 0x89, 0xBB, 0x78,
+  0x35, 0x91, 0x99, 0x99, 0x9A, 0xA9, 0xAC, 0x74, 0x14, 0x98, 0x89, 0x99, 0x8A, 0xA9, 0x1B, 0x67,
+  0x01, 0x99, 0x88, 0x99, 0x99, 0xB9, 0x68, 0x26, 0x90, 0x89, 0x98, 0x9A, 0xA8, 0x9B, 0x75, 0x13,
+  0x99, 0x89, 0xA9, 0x8A, 0xBA, 0x4A, 0x57, 0x81, 0x99, 0x88, 0x9A, 0x98, 0xAB, 0x72, 0x16, 0x98,
+  0x88, 0x99, 0x89, 0xB9, 0x2A, 0x57, 0x01, 0x99, 0x98, 0xA9, 0x98, 0xBA, 0x71, 0x16, 0x90, 0x89,
+  0x98, 0x8A, 0xA9, 0x0A, 0x57, 0x82, 0x99, 0x88, 0x9A, 0x89, 0xAB, 0x71, 0x16, 0x88, 0x89, 0x99,
+  0x89, 0xA9, 0x1A, 0x57, 0x01, 0x99, 0x98, 0xA9, 0x98, 0xAB, 0x72, 0x16, 0x98, 0x88, 0x99, 0x89,
+  0xC3, 0xF5, 0x3B, 0x00, 0x9A, 0x72, 0x14, 0x98, 0x89, 0xA9, 0x89, 0xBA, 0x59, 0x37, 0x80, 0x99,
+  0xA8, 0x99, 0xA9, 0x0C, 0x65, 0x02, 0x99, 0x88, 0xAA, 0x98, 0xBB, 0x71, 0x17, 0x88, 0x89, 0x98,
+  0x99, 0xA8, 0x2A, 0x47, 0x81, 0x99, 0x98, 0x99, 0x99, 0x8C, 0x74, 0x02, 0x98, 0x89, 0xA9, 0x98,
+  0xBA, 0x71, 0x25, 0x98, 0x89, 0x99, 0x8A, 0xB9, 0x4A, 0x47, 0x91, 0x89, 0xA8, 0x99, 0xB8, 0x8A,
+  0x57, 0x02, 0x99, 0x89, 0x9A, 0x99, 0xAB, 0x74, 0x14, 0x99, 0x88, 0xA9, 0x89, 0xBA, 0x70, 0x25,
+  0x98, 0x89, 0xA8, 0x99, 0xB9, 0x5A, 0x37, 0x90, 0x89, 0x99, 0x99, 0xB9, 0x1A, 0x67, 0x01, 0x99,
+  0x98, 0x99, 0x99, 0x8B, 0x75, 0x02, 0x99, 0x98, 0x99, 0x89, 0xAB, 0x73, 0x06, 0x98, 0x88, 0x99,
+  0x98, 0xAA, 0x71, 0x14, 0x98, 0x98, 0xA8, 0x89, 0xBA, 0x78, 0x25, 0x98, 0x89, 0xA8, 0x99, 0xB9,
+  0x69, 0x26, 0x90, 0x89, 0x99, 0x99, 0xB9, 0x4A, 0x47, 0x80, 0x89, 0x99, 0x99, 0xA9, 0x3A, 0x57,
+  0x81, 0x8A, 0x98, 0x8A, 0xA9, 0x2B, 0x67, 0x80, 0x98, 0x98, 0x89, 0x99, 0x1A, 0x47, 0x81, 0x99,
+  0x98, 0x8A, 0xA9, 0x1B, 0x67, 0x81, 0x99, 0x88, 0x8A, 0x99, 0x1A, 0x47, 0x81, 0x8A, 0x98, 0x8A,
+  0xA9, 0x2B, 0x57, 0x81, 0x99, 0x98, 0x99, 0xB8, 0x2A, 0x57, 0x81, 0x99, 0x98, 0x8A, 0xA9, 0x2A,
+  0x67, 0x80, 0x89, 0x98, 0x89, 0xA9, 0x29, 0x47, 0x80, 0x99, 0x98, 0x8A, 0xB9, 0x48, 0x37, 0x90,
+  0x99, 0xA8, 0x99, 0xBA, 0x78, 0x16, 0x90, 0x89, 0x99, 0x89, 0xAA, 0x70, 0x15, 0x89, 0x89, 0x99,
+  0x89, 0xAA, 0x72, 0x05, 0x98, 0x98, 0x99, 0x98, 0x9A, 0x74, 0x02, 0x99, 0x98, 0x99, 0xA9, 0x0A,
+  0x57, 0x81, 0x89, 0x99, 0x89, 0xB9, 0x3A, 0x67, 0x90, 0x88, 0x99, 0x98, 0xA8, 0x59, 0x25, 0xA0,
+  0x8C, 0x06, 0x3E, 0x00, 0x98, 0x8A, 0xA9, 0x1A, 0x67, 0x80, 0x89, 0x98, 0x89, 0xA9, 0x59, 0x25,
+  0xA0, 0x98, 0x99, 0x99, 0xBA, 0x72, 0x16, 0x99, 0x88, 0x99, 0xA8, 0x8A, 0x65, 0x82, 0x99, 0x98,
+  0x99, 0xA9, 0x3A, 0x57, 0x80, 0x89, 0x99, 0x99, 0xA9, 0x78, 0x24, 0x99, 0x98, 0x99, 0x99, 0x9B,
+  0x75, 0x02, 0x99, 0x98, 0x8A, 0xA9, 0x1A, 0x57, 0x91, 0x89, 0xA8, 0x89, 0xB9, 0x70, 0x14, 0x98,
+  0x89, 0xA9, 0x98, 0x9B, 0x66, 0x82, 0x99, 0x98, 0x99, 0xA9, 0x4A, 0x37, 0x90, 0x99, 0x99, 0x99,
+  0xBA, 0x72, 0x06, 0x98, 0x88, 0x99, 0xA8, 0x0A, 0x47, 0x91, 0x89, 0x99, 0x89, 0xB9, 0x60, 0x25,
+  0x99, 0x98, 0x99, 0x99, 0x8B, 0x66, 0x81, 0x89, 0x98, 0x8A, 0xB9, 0x58, 0x17, 0x88, 0x89, 0x99,
+  0x98, 0x9A, 0x74, 0x82, 0x89, 0x99, 0x99, 0xB8, 0x59, 0x17, 0x90, 0x89, 0x99, 0x98, 0x9A, 0x55,
+  0x02, 0x8A, 0x99, 0x9A, 0xB9, 0x79, 0x25, 0x98, 0x89, 0xA9, 0xA8, 0x9A, 0x47, 0x82, 0x99, 0xA8,
+  0x99, 0xC9, 0x60, 0x24, 0x99, 0x89, 0x9A, 0xA8, 0x0B, 0x67, 0x80, 0x89, 0x98, 0x89, 0x9A, 0x71,
+  0x13, 0xA9, 0x98, 0x9A, 0xB8, 0x4B, 0x47, 0x90, 0x89, 0x99, 0x99, 0x9A, 0x74, 0x02, 0x8A, 0xA8,
+  0x89, 0xAA, 0x68, 0x16, 0x98, 0x98, 0x99, 0xA8, 0x1A, 0x47, 0x80, 0x99, 0xA8, 0x98, 0xAA, 0x73,
+  0x85, 0x98, 0x98, 0x89, 0xA9, 0x69, 0x24, 0xA8, 0x98, 0xA9, 0xA8, 0x1B, 0x67, 0x80, 0x89, 0x99,
+  0x98, 0x99, 0x73, 0x83, 0x99, 0xA8, 0x99, 0xB9, 0x78, 0x06, 0x98, 0x88, 0x99, 0xA8, 0x29, 0x37,
+  0xA0, 0x98, 0x99, 0xA9, 0x0B, 0x57, 0x81, 0x99, 0xA8, 0x98, 0xAA, 0x73, 0x85, 0x89, 0x98, 0x89,
+  0xB9, 0x60, 0x14, 0xA8, 0x88, 0x9A, 0xA9, 0x4A, 0x37, 0x98, 0x89, 0xA9, 0x99, 0x1B, 0x57, 0x91,
+  0x1B, 0x06, 0x3F, 0x00, 0x98, 0x89, 0xA9, 0x59, 0x25, 0xA8, 0x98, 0x99, 0xA9, 0x3A, 0x57, 0x90,
+  0x89, 0x99, 0x99, 0x0A, 0x47, 0x80, 0x89, 0xA9, 0x98, 0x9A, 0x65, 0x92, 0x89, 0x99, 0x89, 0xAA,
+  0x73, 0x04, 0x8A, 0xA8, 0x89, 0xAA, 0x71, 0x05, 0x99, 0x98, 0x89, 0xA9, 0x60, 0x14, 0x99, 0x98,
+  0x8A, 0xB9, 0x68, 0x25, 0x99, 0x98, 0x9A, 0xB8, 0x59, 0x17, 0x98, 0x88, 0x8A, 0xA9, 0x39, 0x37,
+  0x98, 0x98, 0x9A, 0xA9, 0x4B, 0x37, 0xA0, 0x98, 0xA9, 0xA9, 0x3B, 0x67, 0x90, 0x89, 0x89, 0x99,
+  0x2A, 0x37, 0x98, 0x98, 0xA9, 0xA8, 0x1A, 0x57, 0x90, 0x98, 0x99, 0x98, 0x1A, 0x37, 0x90, 0x89,
+  0x9A, 0xA9, 0x2B, 0x67, 0x90, 0x98, 0x89, 0x99, 0x2A, 0x37, 0x98, 0x98, 0xA9, 0xA8, 0x2A, 0x57,
+  0x88, 0x89, 0x99, 0x99, 0x3A, 0x37, 0x98, 0x89, 0x9A, 0xA9, 0x4A, 0x37, 0x98, 0x99, 0x99, 0xB9,
+  0x69, 0x16, 0x98, 0x89, 0x99, 0xA9, 0x68, 0x05, 0x98, 0x98, 0x99, 0xA9, 0x70, 0x04, 0x99, 0x98,
+  0x89, 0xAA, 0x72, 0x03, 0x99, 0x99, 0x8A, 0xAB, 0x75, 0x92, 0x89, 0xA8, 0x98, 0x9A, 0x56, 0x91,
+  0x89, 0x99, 0x98, 0x1B, 0x37, 0x90, 0x89, 0x9A, 0xA9, 0x3A, 0x67, 0x98, 0x88, 0x99, 0xA8, 0x59,
+  0x15, 0x99, 0x98, 0x89, 0xAA, 0x71, 0x03, 0x99, 0xA8, 0x99, 0xAA, 0x74, 0x93, 0x89, 0xA9, 0xA8,
+  0x8A, 0x57, 0x90, 0x88, 0x99, 0x99, 0x2A, 0x37, 0x98, 0x89, 0x9A, 0xB9, 0x78, 0x05, 0x98, 0x98,
+  0x99, 0xA9, 0x72, 0x83, 0x99, 0xA8, 0x99, 0x9A, 0x57, 0x80, 0x89, 0x99, 0x99, 0x2A, 0x37, 0x98,
+  0x89, 0x9A, 0xB9, 0x70, 0x05, 0x89, 0x99, 0x98, 0xA9, 0x73, 0x93, 0x89, 0xA9, 0x99, 0x0A, 0x57,
+  0x90, 0x89, 0x99, 0xA8, 0x59, 0x15, 0x99, 0x98, 0x99, 0xA9, 0x73, 0x83, 0x99, 0xA9, 0xA8, 0x0B,
+  0x47, 0x00, 0x34, 0x00, 0x17, 0x8A, 0xA9, 0x9A, 0x9B, 0x67, 0x91, 0x89, 0x99, 0xA8, 0x39, 0x27,
+  0x98, 0x99, 0x99, 0xB9, 0x72, 0x85, 0x89, 0x99, 0x98, 0x0A, 0x37, 0xA0, 0x98, 0x99, 0xA9, 0x79,
+  0x04, 0x98, 0xA8, 0x89, 0x9A, 0x74, 0x91, 0x88, 0x99, 0x99, 0x3A, 0x37, 0x99, 0xA8, 0x99, 0xB9,
+  0x73, 0x84, 0x89, 0x99, 0x99, 0x2B, 0x47, 0x98, 0x98, 0x99, 0xA9, 0x71, 0x83, 0x89, 0xA9, 0x89,
+  0x8B, 0x57, 0x90, 0x89, 0x99, 0xA8, 0x78, 0x03, 0x8A, 0x99, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+//! \brief LineClear sample in the internal flash
+const S_ADPCM_SAMPLE gcsLineClearSample =
+{
+  gcau8LineClearBlocks,
+  7717u
+};
+
+
+//-----------------------------------------------< EOF >--------------------------------------------------/
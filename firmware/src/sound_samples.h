@@ -0,0 +1,38 @@
+﻿/*! *******************************************************************************************************
+* Copyright (c) 2023 K. Sz. Horvath
+*
+* All rights reserved
+*
+* \file sound_samples.h
+*
+* \brief ADPCM sound effect samples
+*
+* \author K. Sz. Horvath
+*
+**********************************************************************************************************/
+
+#ifndef SOUND_SAMPLES_H
+#define SOUND_SAMPLES_H
+
+//--------------------------------------------------------------------------------------------------------/
+// Include files
+//--------------------------------------------------------------------------------------------------------/
+#include "adpcm.h"
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Definitions
+//--------------------------------------------------------------------------------------------------------/
+#define SOUND_SAMPLES_RATE          (22050u)  //!< Sampling rate of the sound effect samples in Hz
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Extern values
+//--------------------------------------------------------------------------------------------------------/
+extern const S_ADPCM_SAMPLE gcsLockSample;
+extern const S_ADPCM_SAMPLE gcsLineClearSample;
+
+
+#endif  // SOUND_SAMPLES_H
+
+//-----------------------------------------------< EOF >--------------------------------------------------/
@@ -15,9 +15,10 @@
 // Include files
 //--------------------------------------------------------------------------------------------------------/
 #include <string.h>
-#include "main.h"
 #include "types.h"
 #include "sound_wavetables.h"
+#include "sound_samples.h"
+#include "adpcm.h"
 
 // Own include
 #include "sound_synth.h"
@@ -26,6 +27,46 @@
 //--------------------------------------------------------------------------------------------------------/
 // Definitions
 //--------------------------------------------------------------------------------------------------------/
+#define ENVELOPE_LEVEL_SHIFT            (15u)  //!< Envelope level is a Q16.15 fixed-point number
+#define ENVELOPE_LEVEL_MAX  ( (I32)0xFFFFu<<ENVELOPE_LEVEL_SHIFT )  //!< Full scale envelope level
+#define ENVELOPE_CURVE_SEGMENTS         (32u)  //!< Number of segments of the envelope curve table
+#define ENVELOPE_CURVE_SEGMENT_SHIFT     (5u)  //!< 2^n is ENVELOPE_CURVE_SEGMENTS
+#define ENVELOPE_CURVE_SHIFT            (31u)  //!< Curve value is a Q31 number in the curved stages
+#define ENVELOPE_STAGE_MAX  ( 1u<<25u )  //!< Longest envelope stage in samples (12 minutes), the curve positions fit into 32 bits
+
+#define PHASE_MASK  ( ( (U32)SYNTH_WAVETABLE_SIZE<<16u ) - 1u )  //!< One period of the oscillator phase, independent of the table size
+#define PHASE_FRACTION_SHIFT            (17u)  //!< Interpolation weight is the Q15 fraction of the table index
+
+#ifndef SOUNDSYNTH_INTERPOLATION
+#define SOUNDSYNTH_INTERPOLATION         (1u)  //!< Linear interpolation between the wave table samples (0: nearest lower sample)
+#endif
+
+#define PITCH_OCTAVE  ( 12u*SYNTH_PITCH_SEMITONE )  //!< Pitch units in an octave
+#define PITCH_FINE_SEGMENTS             (32u)  //!< Number of segments of the fine pitch ratio table in a semitone
+#define PITCH_FINE_SHIFT                 (3u)  //!< Pitch units in a fine table segment: SYNTH_PITCH_SEMITONE/PITCH_FINE_SEGMENTS = 2^n
+#define LFO_INDEX_SHIFT                 (23u)  //!< LFO phase to sine table index shift (512 samples)
+#define NOISE_AMPLITUDE              (23170u)  //!< Noise output level: the same power as a full scale sine wave
+#define NOISE_MAX_CLOCK  ( 0x10000u )  //!< Fastest noise clock: one shift per sample, white noise
+
+#define RATE_MASK  ( ( 1u<<SOUNDSYNTH_RATE_SHIFT ) - 1u )  //!< Output frames per internal sample, minus one
+
+#if ( SOUNDSYNTH_RATE_SHIFT > 2u )
+  #error "The internal sample rate can be reduced by a factor of 4 at most"
+#endif
+
+#define SAMPLE_BUFFER_SIZE  ( SOUNDSYNTH_BLOCK_FRAMES*SYNTH_SAMPLE_MAX_RATE + 1u )  //!< Source samples that a block may cross
+
+#define NOTE_RENDER_FLAG            (0x8000u)  //!< Set in the handles of the notes started by the renderer
+
+#ifndef SOUNDSYNTH_COMMAND_HOOK
+#define SOUNDSYNTH_COMMAND_HOOK(C)             //!< Called with every command the renderer executes (for the host tests)
+#endif
+
+#define COMMAND_QUEUE_MASK  ( SOUNDSYNTH_COMMAND_QUEUE - 1u )  //!< Index mask of the command queue
+
+#if ( 0u != ( SOUNDSYNTH_COMMAND_QUEUE & COMMAND_QUEUE_MASK ) )
+  #error "The size of the command queue must be a power of two"
+#endif
 
 
 //--------------------------------------------------------------------------------------------------------/
@@ -34,6 +75,7 @@
 //! \brief ADSR state machine state
 typedef enum
 {
+  ADSR_IDLE,
   ADSR_ATTACK,
   ADSR_DECAY,
   ADSR_SUSTAIN,
@@ -43,46 +85,1041 @@ typedef enum
 //! \brief Oscillator type
 typedef struct
 {
-  U32          u32Phase;          //!< Current phase of the oscillator (U16.16 fixed-point number)
-  U32          u32PhaseIncrease;  //!< Phase increase per sampling time (U16.16 fixed-point number)
-  I16 const*   pi16WaveTable;     //!< Pointer to the wavetable
-  U16          u16WaveTableSize;  //!< Size in words
-  E_ADSR_STATE eADSRState;        //!< Current ADSR envelope section
-  U16          u16ADSROutput;     //!< Output of the ADSR generator
-  U32          u32ADSRTimer;      //!< ADSR timer (U3.29 fixed-point number)
-  U32          u32Attack;         //!< Attack time
-  U32          u32Decay;          //!< Decay time
-  U16          u16Sustain;        //!< Sustain level
-  U32          u32Release;        //!< Release time
+  U32              u32Phase;           //!< Current phase of the oscillator (U16.16 fixed-point number, SYNTH_WAVETABLE_SIZE samples per period)
+  U32              u32PhaseIncrease;   //!< Phase increase per sampling time (U16.16 fixed-point number)
+  U32              u32BaseIncrease;    //!< Phase increase of the note without the pitch bend and the vibrato
+  I16              i16PitchBend;       //!< Pitch bend (1/SYNTH_PITCH_SEMITONE semitones)
+  U16              u16VibratoDepth;    //!< Vibrato depth (1/SYNTH_PITCH_SEMITONE semitones), 0: no vibrato
+  U32              u32LfoPhase;        //!< Phase of the vibrato LFO (one period is 2^32)
+  U32              u32LfoIncrease;     //!< Vibrato LFO phase increase per sampling time
+  S_WAVETABLE const* psWaveTable;      //!< Wavetable of the voice, for selecting the mip level again
+  I16 const*       pi16WaveTable;      //!< Mip level of the wavetable that is played
+  U32              u32IndexMask;       //!< Index wrap-around mask of the mip level
+  U8               u8IndexShift;       //!< Phase to table index shift of the mip level
+  S_ADPCM_SAMPLE const* psSample;      //!< One-shot sample that is played, NULL for wavetable voices
+  S_ADPCM_DECODER  sDecoder;           //!< Decoder of the sample
+  I16              i16Previous;        //!< Sample voices: source sample before the phase
+  I16              i16Current;         //!< Sample voices: source sample after the phase
+  U32              u32NoiseTaps;       //!< Feedback taps of the noise shift register, 0 for tonal voices
+  U32              u32NoiseState;      //!< Noise shift register
+  E_ADSR_STATE     eADSRState;         //!< Current ADSR envelope section
+  I32              i32Level;           //!< Envelope level (Q16.15 fixed-point number)
+  I32              i32LevelStep;       //!< Envelope level change per sample in a linear stage
+  U16              u16StepFraction;    //!< Fraction of the level step (1/65536 of the level LSB)
+  U16              u16FractionSum;     //!< Accumulated fraction of the level steps
+  U32              u32StageSamples;    //!< Samples left in the current stage
+  I32              i32StageStart;      //!< Envelope level at the beginning of the current stage
+  I32              i32StageDelta;      //!< Envelope level change over the current stage
+  U32              u32StageLength;     //!< Length of the current stage on the curve, 0 if it is not on the curve
+  E_SYNTH_CURVE    eCurve;             //!< Shape of the envelope stages
+  S_SYNTH_ENVELOPE const* psEnvelope;  //!< Envelope of the instrument of the note
+  E_SYNTH_PRIORITY ePriority;          //!< Priority class of the note played
+  SYNTH_NOTE       hNote;              //!< Handle of the note played
+  U32              u32NoteAge;         //!< Note counter value at the allocation
 } S_SYNTH_OSCILLATOR;
 
+//! \brief Instrument type
+typedef struct
+{
+  S_WAVETABLE const* psWaveTable;      //!< Wavetable with its mip levels
+  S_WAVETABLE      sCustomWaveTable;   //!< Single level wavetable given by SoundSynth_SetInstrument()
+  S_ADPCM_SAMPLE const* psSample;      //!< One-shot sample, the wavetable is not used if it is set
+  U8               u8NoiseBits;        //!< Length of the noise shift register, 0: not a noise instrument
+  S_SYNTH_ENVELOPE const* psEnvelope;  //!< Prepared envelope, never NULL
+} S_SYNTH_INSTRUMENT;
+
+//! \brief Synthesizer commands
+typedef enum
+{
+  SYNTH_COMMAND_NOTEON,
+  SYNTH_COMMAND_NOTEOFF,
+  SYNTH_COMMAND_SETINSTRUMENT,
+  SYNTH_COMMAND_SETWAVETABLE,
+  SYNTH_COMMAND_SETSAMPLE,
+  SYNTH_COMMAND_SETNOISE,
+  SYNTH_COMMAND_SETENVELOPE
+} E_SYNTH_COMMAND;
+
+//! \brief Command from the main loop to the renderer
+typedef struct
+{
+  U32              u32Time;            //!< Sample time of the execution
+  U32              u32PhaseIncrease;   //!< Note on: phase increase per sample
+  I16 const*       pi16WaveTable;      //!< Set instrument: pointer to the wavetable
+  U16              u16WaveTableSize;   //!< Set instrument: size in words
+  S_WAVETABLE const* psWaveTable;      //!< Set wavetable: wavetable with its mip levels
+  S_ADPCM_SAMPLE const* psSample;      //!< Set sample: the encoded sample
+  S_SYNTH_ENVELOPE const* psEnvelope;  //!< Set envelope, set instrument: the prepared envelope, NULL keeps the envelope
+  SYNTH_NOTE       hNote;              //!< Note on, note off: handle of the note
+  U8               u8Command;          //!< Command according to E_SYNTH_COMMAND
+  U8               u8Instrument;       //!< Note on, set instrument: instrument slot
+  U8               u8NoiseBits;        //!< Set noise: length of the shift register
+  U8               u8Priority;         //!< Note on: priority class according to E_SYNTH_PRIORITY
+} S_SYNTH_COMMAND;
+
 
 //--------------------------------------------------------------------------------------------------------/
 // Global variables
 //--------------------------------------------------------------------------------------------------------/
 static S_SYNTH_OSCILLATOR gasOscillators[ NUMBER_OF_OSCILLATORS ];
 
+//! \brief Instrument slots
+static S_SYNTH_INSTRUMENT gasInstruments[ SOUNDSYNTH_INSTRUMENTS ];
+
+//! \brief Envelopes of the default instruments
+static S_SYNTH_ENVELOPE gsSustainedEnvelope;
+static S_SYNTH_ENVELOPE gsChimeEnvelope;
+static S_SYNTH_ENVELOPE gsDrumEnvelope;
+static S_SYNTH_ENVELOPE gsCymbalEnvelope;
+
+//! \brief Upsampler state: output frames since the last internal sample, and the last four internal samples
+static U32 gu32UpsamplePosition;
+static I32 gai32UpsampleHistory[ 4u ];
+
+#if ( 0u != SOUNDSYNTH_RATE_SHIFT )
+//! \brief Cubic (4-point Lagrange) interpolation weights at 0, 1/4, 2/4 and 3/4 of the way between the two middle samples (Q15)
+//! \note  At 2/4 this is the -1, 9, 9, -1 half-band filter
+static const I32 gcaai32UpsampleWeights[ 4u ][ 4u ] =
+{
+  {     0, 32768,     0,     0 },
+  { -1792, 26880,  8960, -1280 },
+  { -2048, 18432, 18432, -2048 },
+  { -1280,  8960, 26880, -1792 }
+};
+#endif
+
+//! \brief Decoded source samples of the sample voice being rendered
+static I16 gai16SampleBuffer[ SAMPLE_BUFFER_SIZE ];
+
+//! \brief Counts the allocated notes, for finding the oldest one
+static U32 gu32NoteCounter;
+
+//! \brief Command queue: single producer (main loop), single consumer (renderer)
+static volatile S_SYNTH_COMMAND gasCommands[ SOUNDSYNTH_COMMAND_QUEUE ];
+static volatile U32 gu32CommandWrite;  //!< Written by the producer only
+static volatile U32 gu32CommandRead;   //!< Written by the consumer only
+
+//! \brief Number of frames rendered so far
+static volatile U32 gu32SampleTime;
+
+//! \brief Last note handle given out by the producer (main loop) and by the renderer
+static SYNTH_NOTE ghLastNote;
+static SYNTH_NOTE ghLastRenderNote;
+
+//! \brief Mixer accumulator of the block renderer
+static I32 gai32MixBuffer[ SOUNDSYNTH_BLOCK_FRAMES ];
+
+//! \brief Exponential envelope curve: 32768*(1-exp(-4x))/(1-exp(-4)), x = 0..1
+static const U16 gcau16EnvelopeCurve[ ENVELOPE_CURVE_SEGMENTS + 1u ] =
+{
+      0u,  3922u,  7383u, 10438u, 13134u, 15513u, 17612u, 19465u,
+  21100u, 22543u, 23816u, 24940u, 25931u, 26807u, 27579u, 28260u,
+  28862u, 29393u, 29861u, 30275u, 30639u, 30961u, 31245u, 31496u,
+  31718u, 31913u, 32085u, 32237u, 32371u, 32490u, 32594u, 32687u,
+  32768u
+};
+
+//! \brief Pitch ratio of the semitones in an octave: 65536*2^(n/12)
+static const U32 gcau32SemitoneRatio[ 12u ] =
+{
+  65536u,  69433u,  73562u,  77936u,  82570u,  87480u,
+  92682u,  98193u, 104032u, 110218u, 116772u, 123715u
+};
+
+//! \brief Pitch ratio inside a semitone: 65536*2^(n/(12*32)) - 65536
+static const U16 gcau16FineRatio[ PITCH_FINE_SEGMENTS + 1u ] =
+{
+     0u,  118u,  237u,  356u,  475u,  594u,  714u,  833u,
+   953u, 1073u, 1194u, 1314u, 1435u, 1556u, 1677u, 1799u,
+  1920u, 2042u, 2164u, 2287u, 2409u, 2532u, 2655u, 2778u,
+  2902u, 3025u, 3149u, 3273u, 3397u, 3522u, 3647u, 3772u,
+  3897u
+};
+
+//! \brief Maximal length feedback taps of the noise shift registers from SYNTH_NOISE_BITS_MIN bits
+static const U16 gcau16NoiseTaps[ SYNTH_NOISE_BITS_MAX - SYNTH_NOISE_BITS_MIN + 1u ] =
+{
+  0x0006u, 0x000Cu, 0x0014u, 0x0030u, 0x0060u, 0x00B8u, 0x0110u,
+  0x0240u, 0x0500u, 0x0E08u, 0x1C80u, 0x3802u, 0x6000u, 0xD008u
+};
+
 
 //--------------------------------------------------------------------------------------------------------/
 // Static function declarations
 //--------------------------------------------------------------------------------------------------------/
+static void PrepareStage( S_SYNTH_STAGE* psStage, U32 u32Length, I32 i32Delta );
+static void EnvelopeStage( S_SYNTH_OSCILLATOR* psOscillator, E_ADSR_STATE eState );
+static I32 EnvelopeCurveLevel( S_SYNTH_OSCILLATOR const* psOscillator, U32 u32Sample );
+static I32 EnvelopeSegmentStep( S_SYNTH_OSCILLATOR* psOscillator, U32* pu32Frames );
+static I32 RenderSampleSegment( S_SYNTH_OSCILLATOR* psOscillator, U32* pu32Phase, U16 u16Frame, U16 u16SegmentEnd, I32 i32Level, I32 i32LevelStep );
+static I32 RenderNoiseSegment( S_SYNTH_OSCILLATOR* psOscillator, U32* pu32Phase, U16 u16Frame, U16 u16SegmentEnd, I32 i32Level, I32 i32LevelStep );
+static void RenderBlock( I16* pi16Buffer, U16 u16Frames, U16 u16GainQ15 );
+static U8 AllocateVoice( E_SYNTH_PRIORITY ePriority );
+static void SelectMipLevel( S_SYNTH_OSCILLATOR* psOscillator, S_WAVETABLE const* psWaveTable );
+static U32 PitchShift( U32 u32PhaseIncrease, I32 i32Pitch );
+static void UpdatePitch( S_SYNTH_OSCILLATOR* psOscillator, U16 u16Samples );
+static void StartNote( SYNTH_NOTE hNote, U32 u32PhaseIncrease, U8 u8Instrument, E_SYNTH_PRIORITY ePriority );
+static void ReleaseNote( SYNTH_NOTE hNote );
+static void ExecuteCommand( S_SYNTH_COMMAND const* psCommand );
+static BOOL PushCommand( S_SYNTH_COMMAND const* psCommand );
 
 
 //--------------------------------------------------------------------------------------------------------/
 // Static functions
 //--------------------------------------------------------------------------------------------------------/
 /*! *******************************************************************
- * \brief
- * \param
- * \return
+ * \brief  Does the divisions of an envelope stage
+ * \param  psStage: the stage is filled in here
+ * \param  u32Length: length of the stage in samples (at SOUNDSYNTH_INTERNAL_RATE)
+ * \param  i32Delta: level change over the stage from its usual start level
+ * \return -
+ * \note   A stage of N samples length outputs N+1 samples, from the start
+ *         level to the target level. The length is limited to ENVELOPE_STAGE_MAX.
  *********************************************************************/
+static void PrepareStage( S_SYNTH_STAGE* psStage, U32 u32Length, I32 i32Delta )
+{
+  I32 i32Remainder;
 
- /*! *******************************************************************
- * \brief
- * \param
- * \return
+  if( u32Length > ENVELOPE_STAGE_MAX )
+  {
+    u32Length = ENVELOPE_STAGE_MAX;
+  }
+  psStage->u32Samples = u32Length;
+  psStage->i32Delta = i32Delta;
+  if( 0u == u32Length )
+  {
+    psStage->i32LevelStep = 0;
+    psStage->u16StepFraction = 0u;
+  }
+  else
+  {
+    psStage->i32LevelStep = i32Delta / (I32)u32Length;
+    i32Remainder = i32Delta % (I32)u32Length;
+    if( i32Remainder < 0 )
+    {
+      i32Remainder = -i32Remainder;
+    }
+    psStage->u16StepFraction = ( (U64)i32Remainder<<16u ) / u32Length;
+  }
+}
+
+/*! *******************************************************************
+ * \brief  Starts an envelope stage from the current level
+ * \param  psOscillator: the oscillator
+ * \param  eState: the new stage
+ * \return -
+ * \note   The stages are prepared with the envelope, so there is no
+ *         division here, unless the stage starts from an unusual level.
+ *********************************************************************/
+static void EnvelopeStage( S_SYNTH_OSCILLATOR* psOscillator, E_ADSR_STATE eState )
+{
+  S_SYNTH_ENVELOPE const* psEnvelope = psOscillator->psEnvelope;
+  S_SYNTH_STAGE const* psStage = NULL;
+  I32 i32Target;
+  I32 i32Remainder;
+
+  switch( eState )
+  {
+    case ADSR_ATTACK:
+      i32Target = ENVELOPE_LEVEL_MAX;
+      psStage = &psEnvelope->sAttack;
+      break;
+
+    case ADSR_DECAY:
+      i32Target = (I32)psEnvelope->u16Sustain<<ENVELOPE_LEVEL_SHIFT;
+      psStage = &psEnvelope->sDecay;
+      break;
+
+    case ADSR_RELEASE:
+      i32Target = 0;
+      psStage = &psEnvelope->sRelease;
+      break;
+
+    case ADSR_SUSTAIN:
+      i32Target = (I32)psEnvelope->u16Sustain<<ENVELOPE_LEVEL_SHIFT;
+      if( 0u == psEnvelope->u16Sustain )
+      {
+        // Nothing to hear until the release: the voice is free
+        eState = ADSR_IDLE;
+      }
+      break;
+
+    case ADSR_IDLE:
+    default:
+      i32Target = 0;
+      break;
+  }
+
+  psOscillator->eADSRState = eState;
+  psOscillator->i32StageStart = psOscillator->i32Level;
+  psOscillator->i32StageDelta = i32Target - psOscillator->i32Level;
+  psOscillator->u32StageLength = 0u;
+  psOscillator->u16FractionSum = 0u;
+
+  if( NULL == psStage )
+  {
+    // Steady state, lasts until the next press or release
+    psOscillator->i32Level = i32Target;
+    psOscillator->i32LevelStep = 0;
+    psOscillator->u32StageSamples = 0u;
+    psOscillator->u16StepFraction = 0u;
+  }
+  else if( 0u == psStage->u32Samples )
+  {
+    // Zero length: jump to the target level, and hold it for one sample
+    psOscillator->i32Level = i32Target;
+    psOscillator->i32LevelStep = 0;
+    psOscillator->u32StageSamples = 1u;
+    psOscillator->u16StepFraction = 0u;
+  }
+  else
+  {
+    if( psOscillator->i32StageDelta == psStage->i32Delta )
+    {
+      psOscillator->i32LevelStep = psStage->i32LevelStep;
+      psOscillator->u16StepFraction = psStage->u16StepFraction;
+    }
+    else
+    {
+      // E.g. released in the attack or the decay
+      psOscillator->i32LevelStep = psOscillator->i32StageDelta / (I32)psStage->u32Samples;
+      i32Remainder = psOscillator->i32StageDelta % (I32)psStage->u32Samples;
+      if( i32Remainder < 0 )
+      {
+        i32Remainder = -i32Remainder;
+      }
+      psOscillator->u16StepFraction = ( (U64)i32Remainder<<16u ) / psStage->u32Samples;
+    }
+    psOscillator->u32StageSamples = psStage->u32Samples + 1u;
+    if( SYNTH_CURVE_LINEAR != psOscillator->eCurve )
+    {
+      psOscillator->u32StageLength = psStage->u32Samples;
+    }
+  }
+}
+
+/*! *******************************************************************
+ * \brief  Calculates the envelope level of a sample of a curved stage
+ * \param  psOscillator: the oscillator
+ * \param  u32Sample: sample of the stage, 0..u32StageLength
+ * \return Envelope level
+ * \note   The curve table is interpolated at the exact position of the
+ *         sample, so the curve does not drift in long stages either.
+ *********************************************************************/
+static I32 EnvelopeCurveLevel( S_SYNTH_OSCILLATOR const* psOscillator, U32 u32Sample )
+{
+  U32 u32Position = u32Sample<<ENVELOPE_CURVE_SEGMENT_SHIFT;
+  U32 u32Index;
+  U32 u32Curve;
+
+  u32Index = u32Position / psOscillator->u32StageLength;
+  u32Curve = (U32)gcau16EnvelopeCurve[ u32Index ]<<( ENVELOPE_CURVE_SHIFT - 15u );
+  if( u32Index < ENVELOPE_CURVE_SEGMENTS )
+  {
+    u32Position -= u32Index*psOscillator->u32StageLength;
+    u32Curve += (U32)( ( (U64)( gcau16EnvelopeCurve[ u32Index + 1u ] - gcau16EnvelopeCurve[ u32Index ] )*u32Position<<( ENVELOPE_CURVE_SHIFT - 15u ) )
+                       / psOscillator->u32StageLength );
+  }
+
+  // Q16.15 * Q31 gives Q16.15 after the shift; the end of the stage is exactly on the target level
+  return psOscillator->i32StageStart + (I32)( ( (I64)psOscillator->i32StageDelta*u32Curve )>>ENVELOPE_CURVE_SHIFT );
+}
+
+/*! *******************************************************************
+ * \brief  Calculates the envelope level step for the next few samples
+ * \param  psOscillator: the oscillator
+ * \param  pu32Frames: number of samples in the segment (not beyond the end of the stage),
+ *                     may be shortened
+ * \return Level change per sample (the level itself may also be adjusted)
+ * \note   Linear stages use the step calculated at the beginning of the stage.
+ *         A segment of a curved stage ends at the next point of the curve
+ *         table, so the curve is linear inside it. Its first and last levels
+ *         are calculated from the curve, with a division each.
+ *********************************************************************/
+static I32 EnvelopeSegmentStep( S_SYNTH_OSCILLATOR* psOscillator, U32* pu32Frames )
+{
+  U32 u32Sample;
+  U32 u32Index;
+  U32 u32Last;
+  I32 i32First;
+
+  if( 0u == psOscillator->u32StageLength )
+  {
+    return psOscillator->i32LevelStep;
+  }
+
+  // Sample of the stage, and the last sample before the next point of the curve table
+  u32Sample = psOscillator->u32StageLength + 1u - psOscillator->u32StageSamples;
+  u32Index = ( u32Sample<<ENVELOPE_CURVE_SEGMENT_SHIFT ) / psOscillator->u32StageLength;
+  u32Last = ( u32Index < ENVELOPE_CURVE_SEGMENTS ) ? ( ( ( u32Index + 1u )*psOscillator->u32StageLength )>>ENVELOPE_CURVE_SEGMENT_SHIFT ) : u32Sample;
+  if( ( u32Last - u32Sample + 1u ) < *pu32Frames )
+  {
+    *pu32Frames = u32Last - u32Sample + 1u;
+  }
+
+  i32First = EnvelopeCurveLevel( psOscillator, u32Sample );
+  psOscillator->i32Level = i32First;
+  if( 1u == *pu32Frames )
+  {
+    return 0;
+  }
+  return ( EnvelopeCurveLevel( psOscillator, u32Sample + *pu32Frames - 1u ) - i32First ) / (I32)( *pu32Frames - 1u );
+}
+
+/*! *******************************************************************
+ * \brief  Renders a segment of a sample voice into the mix buffer
+ * \param  psOscillator: the voice
+ * \param  pu32Phase: position between the source samples (0..65535)
+ * \param  u16Frame: first frame of the segment
+ * \param  u16SegmentEnd: frame after the segment
+ * \param  i32Level: envelope level at the first frame
+ * \param  i32LevelStep: envelope level change per frame
+ * \return Envelope level after the segment
+ * \note   The source samples crossed by the segment are decoded at once,
+ *         then they are resampled with linear interpolation. The voice is
+ *         freed at the end of the sample.
+ *********************************************************************/
+static I32 RenderSampleSegment( S_SYNTH_OSCILLATOR* psOscillator, U32* pu32Phase, U16 u16Frame, U16 u16SegmentEnd, I32 i32Level, I32 i32LevelStep )
+{
+  U32 u32Phase = *pu32Phase;
+  U32 u32PhaseIncrease = psOscillator->u32PhaseIncrease;
+  U32 u32Needed;
+  U16 u16Decoded;
+  U16 u16Read = 0u;
+  I32 i32Previous = psOscillator->i16Previous;
+  I32 i32Current = psOscillator->i16Current;
+  I32 i32Sample;
+
+  u32Needed = ( u32Phase + u32PhaseIncrease*( u16SegmentEnd - u16Frame ) )>>16u;
+  u16Decoded = ADPCM_Decode( &psOscillator->sDecoder, gai16SampleBuffer, (U16)u32Needed );
+  if( u16Decoded < u32Needed )
+  {
+    // End of the sample: silence
+    memset( &gai16SampleBuffer[ u16Decoded ], 0, ( u32Needed - u16Decoded )*sizeof( I16 ) );
+  }
+
+  for( ; u16Frame < u16SegmentEnd; u16Frame++ )
+  {
+    u32Phase += u32PhaseIncrease;
+    while( u32Phase > 0xFFFFu )
+    {
+      i32Previous = i32Current;
+      i32Current = gai16SampleBuffer[ u16Read++ ];
+      u32Phase -= 0x10000u;
+    }
+    i32Sample = i32Previous + ( ( ( i32Current - i32Previous )*(I32)( u32Phase>>1u ) )>>15 );
+    gai32MixBuffer[ u16Frame ] += DSP_SMULWB( i32Level>>ENVELOPE_LEVEL_SHIFT, i32Sample );
+    i32Level = (I32)( (U32)i32Level + (U32)i32LevelStep );
+  }
+
+  *pu32Phase = u32Phase;
+  psOscillator->i16Previous = (I16)i32Previous;
+  psOscillator->i16Current = (I16)i32Current;
+  if( u16Decoded < u32Needed )
+  {
+    EnvelopeStage( psOscillator, ADSR_IDLE );
+  }
+
+  return i32Level;
+}
+
+/*! *******************************************************************
+ * \brief  Renders a segment of a noise voice into the mix buffer
+ * \param  psOscillator: the voice
+ * \param  pu32Phase: position between the shift register clocks (0..65535)
+ * \param  u16Frame: first frame of the segment
+ * \param  u16SegmentEnd: frame after the segment
+ * \param  i32Level: envelope level at the first frame
+ * \param  i32LevelStep: envelope level change per frame
+ * \return Envelope level after the segment
+ * \note   Galois LFSR: the output is its lowest bit, it is shifted when
+ *         the phase wraps around, so the phase increase is the noise
+ *         clock. No table is read.
+ *********************************************************************/
+static I32 RenderNoiseSegment( S_SYNTH_OSCILLATOR* psOscillator, U32* pu32Phase, U16 u16Frame, U16 u16SegmentEnd, I32 i32Level, I32 i32LevelStep )
+{
+  U32 u32Phase = *pu32Phase;
+  U32 u32PhaseIncrease = psOscillator->u32PhaseIncrease;
+  U32 u32State = psOscillator->u32NoiseState;
+  U32 u32Taps = psOscillator->u32NoiseTaps;
+  I32 i32Sample;
+
+  i32Sample = ( 0u != ( u32State & 1u ) ) ? (I32)NOISE_AMPLITUDE : -(I32)NOISE_AMPLITUDE;
+  for( ; u16Frame < u16SegmentEnd; u16Frame++ )
+  {
+    u32Phase += u32PhaseIncrease;
+    if( u32Phase > 0xFFFFu )
+    {
+      // The clock is at most one shift per sample; the conditionals map to LSRS and IT blocks on the Cortex-M4
+      u32Phase &= 0xFFFFu;
+      if( 0u != ( u32State & 1u ) )
+      {
+        u32State = ( u32State>>1u ) ^ u32Taps;
+      }
+      else
+      {
+        u32State >>= 1u;
+      }
+      i32Sample = ( 0u != ( u32State & 1u ) ) ? (I32)NOISE_AMPLITUDE : -(I32)NOISE_AMPLITUDE;
+    }
+    gai32MixBuffer[ u16Frame ] += DSP_SMULWB( i32Level>>ENVELOPE_LEVEL_SHIFT, i32Sample );
+    i32Level = (I32)( (U32)i32Level + (U32)i32LevelStep );
+  }
+
+  *pu32Phase = u32Phase;
+  psOscillator->u32NoiseState = u32State;
+
+  return i32Level;
+}
+
+/*! *******************************************************************
+ * \brief  Renders at most SOUNDSYNTH_BLOCK_FRAMES frames
+ * \param  pi16Buffer: stereo output buffer (left and right samples interleaved)
+ * \param  u16Frames: number of frames to render
+ * \param  u16GainQ15: master gain (Q15, 0x8000 is unity gain)
+ * \return -
+ * \note   Renders one oscillator at a time, so its state stays in registers.
+ *         The block is split into segments at the envelope stage boundaries
+ *         and at the points of the curve table, the envelope is a constant
+ *         step inside a segment.
+ *         The voices run at SOUNDSYNTH_INTERNAL_RATE, the mix is upsampled
+ *         to SAMPLE_RATE with cubic interpolation.
+ *********************************************************************/
+static void RenderBlock( I16* pi16Buffer, U16 u16Frames, U16 u16GainQ15 )
+{
+  U8          u8Index;
+  U16         u16Samples;
+  U16         u16Frame;
+  U16         u16SegmentEnd;
+  U32         u32Segment;
+  U32         u32Fraction;
+  U32         u32Phase;
+  U32         u32PhaseIncrease;
+  U32         u32IndexMask;
+  U32         u32Index;
+  U8          u8IndexShift;
+  I32         i32Level;
+  I32         i32LevelStep;
+  I16 const*  pi16WaveTable;
+  I32         i32Sample;
+  I16         i16Sample;
+#if ( 0u != SOUNDSYNTH_RATE_SHIFT )
+  I32 const*  pi32Weights;
+#endif
+
+  // Internal samples that the output frames reach
+  u16Samples = (U16)( ( ( gu32UpsamplePosition + u16Frames + RATE_MASK )>>SOUNDSYNTH_RATE_SHIFT ) - ( ( gu32UpsamplePosition + RATE_MASK )>>SOUNDSYNTH_RATE_SHIFT ) );
+  memset( gai32MixBuffer, 0, u16Samples*sizeof( I32 ) );
+
+  for( u8Index = 0u; u8Index < NUMBER_OF_OSCILLATORS; u8Index++ )
+  {
+    S_SYNTH_OSCILLATOR* psOscillator = &gasOscillators[ u8Index ];
+
+    if( ADSR_IDLE == psOscillator->eADSRState )
+    {
+      // Free voice, nothing to render
+      continue;
+    }
+
+    if( 0u != psOscillator->u16VibratoDepth )
+    {
+      // The pitch modulation is updated once per block
+      UpdatePitch( psOscillator, u16Samples );
+    }
+
+    u32Phase = psOscillator->u32Phase;
+    u32PhaseIncrease = psOscillator->u32PhaseIncrease;
+    u32IndexMask = psOscillator->u32IndexMask;
+    u8IndexShift = psOscillator->u8IndexShift;
+    pi16WaveTable = psOscillator->pi16WaveTable;
+    i32Level = psOscillator->i32Level;
+    u16Frame = 0u;
+
+    while( u16Frame < u16Samples )
+    {
+      // Segment: until the end of the block or the end of the envelope stage
+      u32Segment = u16Samples - u16Frame;
+      if( ( 0u != psOscillator->u32StageSamples ) && ( psOscillator->u32StageSamples < u32Segment ) )
+      {
+        u32Segment = psOscillator->u32StageSamples;
+      }
+      psOscillator->i32Level = i32Level;
+      i32LevelStep = EnvelopeSegmentStep( psOscillator, &u32Segment );
+      i32Level = psOscillator->i32Level;
+      u16SegmentEnd = u16Frame + (U16)u32Segment;
+
+      if( NULL != psOscillator->psSample )
+      {
+        i32Level = RenderSampleSegment( psOscillator, &u32Phase, u16Frame, u16SegmentEnd, i32Level, i32LevelStep );
+        u16Frame = u16SegmentEnd;
+      }
+      else if( 0u != psOscillator->u32NoiseTaps )
+      {
+        i32Level = RenderNoiseSegment( psOscillator, &u32Phase, u16Frame, u16SegmentEnd, i32Level, i32LevelStep );
+        u16Frame = u16SegmentEnd;
+      }
+      for( ; u16Frame < u16SegmentEnd; u16Frame++ )
+      {
+        u32Phase = ( u32Phase + u32PhaseIncrease ) & PHASE_MASK;
+        u32Index = u32Phase>>u8IndexShift;
+        i32Sample = pi16WaveTable[ u32Index ];
+#if ( 0u != SOUNDSYNTH_INTERPOLATION )
+        // Q15 weight of the next sample: 17 bit difference * 15 bit weight fits into 32 bits
+        i32Sample += ( ( pi16WaveTable[ ( u32Index + 1u ) & u32IndexMask ] - i32Sample )*(I32)( ( u32Phase<<( 32u - u8IndexShift ) )>>PHASE_FRACTION_SHIFT ) )>>15;
+#endif
+        // ( envelope * sample )>>16: the envelope output is a 0..1 gain
+        gai32MixBuffer[ u16Frame ] += DSP_SMULWB( i32Level>>ENVELOPE_LEVEL_SHIFT, i32Sample );
+        // The step after the last sample of a stage may go past the full scale, it is not used
+        i32Level = (I32)( (U32)i32Level + (U32)i32LevelStep );
+      }
+      if( ( SYNTH_CURVE_LINEAR == psOscillator->eCurve ) && ( 0u != psOscillator->u16StepFraction ) )
+      {
+        // Carry of the step fractions, so long linear stages do not drift away
+        u32Fraction = psOscillator->u16FractionSum + u32Segment*psOscillator->u16StepFraction;
+        psOscillator->u16FractionSum = (U16)u32Fraction;
+        i32Level += ( psOscillator->i32StageDelta < 0 ) ? -(I32)( u32Fraction>>16u ) : (I32)( u32Fraction>>16u );
+      }
+      psOscillator->i32Level = i32Level;
+
+      if( 0u != psOscillator->u32StageSamples )
+      {
+        psOscillator->u32StageSamples -= u32Segment;
+        if( 0u == psOscillator->u32StageSamples )
+        {
+          // End of the stage: continue from the exact target level
+          psOscillator->i32Level = psOscillator->i32StageStart + psOscillator->i32StageDelta;
+          switch( psOscillator->eADSRState )
+          {
+            case ADSR_ATTACK:
+              EnvelopeStage( psOscillator, ADSR_DECAY );
+              break;
+
+            case ADSR_DECAY:
+              EnvelopeStage( psOscillator, ADSR_SUSTAIN );
+              break;
+
+            default:
+              EnvelopeStage( psOscillator, ADSR_IDLE );
+              break;
+          }
+          i32Level = psOscillator->i32Level;
+        }
+      }
+
+      if( ADSR_IDLE == psOscillator->eADSRState )
+      {
+        break;
+      }
+    }
+
+    psOscillator->u32Phase = u32Phase;
+  }
+
+  // Headroom, saturation, upsampling, master volume and mono to stereo
+#if ( 0u == SOUNDSYNTH_RATE_SHIFT )
+  for( u16Frame = 0u; u16Frame < u16Frames; u16Frame++ )
+  {
+    i32Sample = gai32MixBuffer[ u16Frame ]>>SOUNDSYNTH_MIX_HEADROOM;
+    i32Sample = DSP_SSAT16( i32Sample );
+#else
+  u16Samples = 0u;
+  for( u16Frame = 0u; u16Frame < u16Frames; u16Frame++ )
+  {
+    if( 0u == gu32UpsamplePosition )
+    {
+      gai32UpsampleHistory[ 0u ] = gai32UpsampleHistory[ 1u ];
+      gai32UpsampleHistory[ 1u ] = gai32UpsampleHistory[ 2u ];
+      gai32UpsampleHistory[ 2u ] = gai32UpsampleHistory[ 3u ];
+      i32Sample = gai32MixBuffer[ u16Samples++ ]>>SOUNDSYNTH_MIX_HEADROOM;
+      gai32UpsampleHistory[ 3u ] = DSP_SSAT16( i32Sample );
+    }
+    // Interpolation between the two middle samples of the history, two internal samples late
+    pi32Weights = gcaai32UpsampleWeights[ gu32UpsamplePosition<<( 2u - SOUNDSYNTH_RATE_SHIFT ) ];
+    i32Sample = ( pi32Weights[ 0u ]*gai32UpsampleHistory[ 0u ] + pi32Weights[ 1u ]*gai32UpsampleHistory[ 1u ]
+                + pi32Weights[ 2u ]*gai32UpsampleHistory[ 2u ] + pi32Weights[ 3u ]*gai32UpsampleHistory[ 3u ] )>>15;
+    i32Sample = DSP_SSAT16( i32Sample );
+    gu32UpsamplePosition = ( gu32UpsamplePosition + 1u ) & RATE_MASK;
+#endif
+    i16Sample = (I16)( ( i32Sample*u16GainQ15 )>>15u );
+    pi16Buffer[ (u16Frame*2u) + 0u ] = i16Sample;  // Left
+    pi16Buffer[ (u16Frame*2u) + 1u ] = i16Sample;  // Right
+  }
+}
+
+
+/*! *******************************************************************
+ * \brief  Finds a voice for a new note
+ * \param  ePriority: priority class of the new note
+ * \return Index of the voice, or NUMBER_OF_OSCILLATORS if all voices are
+ *         playing notes of higher priority
+ * \note   A free voice is used, if there is one. Otherwise a voice of the
+ *         same or lower priority is stolen: lower priority first, then
+ *         the quietest released voice, then the oldest one.
+ *********************************************************************/
+static U8 AllocateVoice( E_SYNTH_PRIORITY ePriority )
+{
+  U8   u8Index;
+  U8   u8Best = NUMBER_OF_OSCILLATORS;
+  BOOL bReleased;
+  BOOL bBestReleased = FALSE;
+  BOOL bBetter;
+  S_SYNTH_OSCILLATOR* psOscillator;
+  S_SYNTH_OSCILLATOR* psBest = NULL;
+
+  for( u8Index = 0u; u8Index < NUMBER_OF_OSCILLATORS; u8Index++ )
+  {
+    psOscillator = &gasOscillators[ u8Index ];
+    if( ADSR_IDLE == psOscillator->eADSRState )
+    {
+      return u8Index;
+    }
+    if( psOscillator->ePriority > ePriority )
+    {
+      continue;
+    }
+
+    bReleased = ( ADSR_RELEASE == psOscillator->eADSRState ) ? TRUE : FALSE;
+    if( NULL == psBest )
+    {
+      bBetter = TRUE;
+    }
+    else if( psOscillator->ePriority != psBest->ePriority )
+    {
+      bBetter = ( psOscillator->ePriority < psBest->ePriority ) ? TRUE : FALSE;
+    }
+    else if( bReleased != bBestReleased )
+    {
+      bBetter = bReleased;
+    }
+    else if( ( TRUE == bReleased ) && ( psOscillator->i32Level != psBest->i32Level ) )
+    {
+      bBetter = ( psOscillator->i32Level < psBest->i32Level ) ? TRUE : FALSE;
+    }
+    else
+    {
+      bBetter = ( (I32)( psOscillator->u32NoteAge - psBest->u32NoteAge ) < 0 ) ? TRUE : FALSE;
+    }
+
+    if( TRUE == bBetter )
+    {
+      u8Best = u8Index;
+      psBest = psOscillator;
+      bBestReleased = bReleased;
+    }
+  }
+
+  return u8Best;
+}
+
+/*! *******************************************************************
+ * \brief  Selects the mip level of a wavetable for the pitch of a voice
+ * \param  psOscillator: the voice, its phase increase is already set
+ * \param  psWaveTable: wavetable with its mip levels
+ * \return -
+ * \note   Level N is used from a phase increase of 2^N*65536, one level
+ *         per octave, so the harmonics stay below the Nyquist frequency.
+ *********************************************************************/
+static void SelectMipLevel( S_SYNTH_OSCILLATOR* psOscillator, S_WAVETABLE const* psWaveTable )
+{
+  U8  u8Level = 0u;
+  U8  u8Shift = 16u;
+  U32 u32Size;
+
+  while( ( ( u8Level + 1u ) < psWaveTable->u8Levels ) && ( ( psOscillator->u32PhaseIncrease>>( 17u + u8Level ) ) != 0u ) )
+  {
+    u8Level++;
+  }
+  u32Size = psWaveTable->asLevels[ u8Level ].u16Size;
+
+  // A table shorter than the reference is read with a bigger step
+  for( ; u32Size < SYNTH_WAVETABLE_SIZE; u32Size <<= 1u )
+  {
+    u8Shift++;
+  }
+  for( ; u32Size > SYNTH_WAVETABLE_SIZE; u32Size >>= 1u )
+  {
+    u8Shift--;
+  }
+
+  psOscillator->pi16WaveTable = psWaveTable->asLevels[ u8Level ].pi16Samples;
+  psOscillator->u32IndexMask = psWaveTable->asLevels[ u8Level ].u16Size - 1u;
+  psOscillator->u8IndexShift = u8Shift;
+}
+
+/*! *******************************************************************
+ * \brief  Shifts the pitch of a phase increase
+ * \param  u32PhaseIncrease: phase increase at the original pitch
+ * \param  i32Pitch: pitch shift (1/SYNTH_PITCH_SEMITONE semitones)
+ * \return Phase increase at the shifted pitch
+ * \note   2^(pitch/12) from the octave, the semitone table and the
+ *         linearly interpolated fine table, so there is no floating point
+ *         math and no division by a variable.
+ *********************************************************************/
+static U32 PitchShift( U32 u32PhaseIncrease, I32 i32Pitch )
+{
+  I32 i32Octave;
+  U32 u32Rest;
+  U32 u32Fine;
+  U32 u32Ratio;
+  U64 u64Result;
+
+  // Octave rounded down, so the rest is not negative
+  i32Octave = ( i32Pitch >= 0 ) ? ( i32Pitch/(I32)PITCH_OCTAVE ) : -( ( (I32)PITCH_OCTAVE - 1 - i32Pitch )/(I32)PITCH_OCTAVE );
+  u32Rest = (U32)( i32Pitch - i32Octave*(I32)PITCH_OCTAVE );
+
+  // Ratio inside the semitone, then of the semitone (Q16)
+  u32Fine = ( u32Rest % SYNTH_PITCH_SEMITONE )>>PITCH_FINE_SHIFT;
+  u32Ratio = gcau16FineRatio[ u32Fine ]
+           + ( ( ( gcau16FineRatio[ u32Fine + 1u ] - gcau16FineRatio[ u32Fine ] )*( u32Rest & ( ( 1u<<PITCH_FINE_SHIFT ) - 1u ) ) )>>PITCH_FINE_SHIFT );
+  u32Ratio = (U32)( ( (U64)gcau32SemitoneRatio[ u32Rest/SYNTH_PITCH_SEMITONE ]*( 0x10000u + u32Ratio ) )>>16u );
+
+  // 2^25 * 2^17 is shifted: 16 octaves up still fit, 48 octaves down is silence
+  u64Result = (U64)u32PhaseIncrease*u32Ratio;
+  if( i32Octave >= 0 )
+  {
+    u64Result <<= (U32)( ( i32Octave > 16 ) ? 16 : i32Octave );
+  }
+  else
+  {
+    u64Result >>= (U32)( ( i32Octave < -48 ) ? 48 : -i32Octave );
+  }
+  u64Result >>= 16u;
+
+  // Half a period per sample is the Nyquist frequency: it can not go higher
+  if( u64Result > ( PHASE_MASK>>1u ) )
+  {
+    u64Result = PHASE_MASK>>1u;
+  }
+
+  return (U32)u64Result;
+}
+
+/*! *******************************************************************
+ * \brief  Applies the pitch bend and the vibrato to a voice
+ * \param  psOscillator: the voice
+ * \param  u16Samples: the vibrato LFO is advanced by this many samples
+ * \return -
+ * \note   Called once per block, or when the modulation is changed.
+ *         The mip level follows the pitch.
+ *********************************************************************/
+static void UpdatePitch( S_SYNTH_OSCILLATOR* psOscillator, U16 u16Samples )
+{
+  I32 i32Pitch = psOscillator->i16PitchBend;
+
+  if( 0u != psOscillator->u16VibratoDepth )
+  {
+    i32Pitch += ( (I32)psOscillator->u16VibratoDepth*gcai16SineWaveTable[ psOscillator->u32LfoPhase>>LFO_INDEX_SHIFT ] )>>15;
+    psOscillator->u32LfoPhase += u16Samples*psOscillator->u32LfoIncrease;
+  }
+
+  psOscillator->u32PhaseIncrease = PitchShift( psOscillator->u32BaseIncrease, i32Pitch );
+  if( NULL != psOscillator->psSample )
+  {
+    if( psOscillator->u32PhaseIncrease > ( (U32)SYNTH_SAMPLE_MAX_RATE<<( 16u + SOUNDSYNTH_RATE_SHIFT ) ) )
+    {
+      psOscillator->u32PhaseIncrease = (U32)SYNTH_SAMPLE_MAX_RATE<<( 16u + SOUNDSYNTH_RATE_SHIFT );
+    }
+  }
+  else if( 0u != psOscillator->u32NoiseTaps )
+  {
+    if( psOscillator->u32PhaseIncrease > NOISE_MAX_CLOCK )
+    {
+      psOscillator->u32PhaseIncrease = NOISE_MAX_CLOCK;
+    }
+  }
+  else
+  {
+    SelectMipLevel( psOscillator, psOscillator->psWaveTable );
+  }
+}
+
+/*! *******************************************************************
+ * \brief  Starts a note on a free (or stolen) voice
+ * \param  hNote: handle of the note
+ * \param  u32PhaseIncrease: phase increase per sample
+ * \param  u8Instrument: instrument slot
+ * \param  ePriority: priority class of the note
+ * \return -
+ * \note   The note is dropped if all voices play higher priority notes
  *********************************************************************/
+static void StartNote( SYNTH_NOTE hNote, U32 u32PhaseIncrease, U8 u8Instrument, E_SYNTH_PRIORITY ePriority )
+{
+  U8 u8Voice;
+  S_SYNTH_OSCILLATOR* psOscillator;
+  S_SYNTH_INSTRUMENT const* psInstrument;
+
+  u8Voice = AllocateVoice( ePriority );
+  if( ( u8Instrument < SOUNDSYNTH_INSTRUMENTS ) && ( u8Voice < NUMBER_OF_OSCILLATORS ) )
+  {
+    psInstrument = &gasInstruments[ u8Instrument ];
+    psOscillator = &gasOscillators[ u8Voice ];
+    // The envelope is prepared, only the pitch is given at SAMPLE_RATE
+    psOscillator->psEnvelope = psInstrument->psEnvelope;
+    psOscillator->eCurve = psInstrument->psEnvelope->eCurve;
+    psOscillator->ePriority = ePriority;
+    psOscillator->hNote = hNote;
+    psOscillator->u32NoteAge = gu32NoteCounter++;
+    psOscillator->u32Phase = 0u;
+    psOscillator->u32PhaseIncrease = u32PhaseIncrease<<SOUNDSYNTH_RATE_SHIFT;
+    psOscillator->i16PitchBend = 0;
+    psOscillator->u16VibratoDepth = 0u;
+    psOscillator->u32LfoPhase = 0u;
+    psOscillator->u32LfoIncrease = 0u;
+    psOscillator->psWaveTable = psInstrument->psWaveTable;
+    psOscillator->psSample = psInstrument->psSample;
+    psOscillator->u32NoiseTaps = 0u;
+    if( NULL != psInstrument->psSample )
+    {
+      // One-shot sample, played from the beginning
+      if( u32PhaseIncrease > ( (U32)SYNTH_SAMPLE_MAX_RATE<<16u ) )
+      {
+        psOscillator->u32PhaseIncrease = (U32)SYNTH_SAMPLE_MAX_RATE<<( 16u + SOUNDSYNTH_RATE_SHIFT );
+      }
+      ADPCM_Start( &psOscillator->sDecoder, psInstrument->psSample );
+      psOscillator->i16Previous = 0;
+      psOscillator->i16Current = 0;
+    }
+    else if( 0u != psInstrument->u8NoiseBits )
+    {
+      // Noise: the phase increase is the clock of the shift register
+      if( psOscillator->u32PhaseIncrease > NOISE_MAX_CLOCK )
+      {
+        psOscillator->u32PhaseIncrease = NOISE_MAX_CLOCK;
+      }
+      psOscillator->u32NoiseTaps = gcau16NoiseTaps[ psInstrument->u8NoiseBits - SYNTH_NOISE_BITS_MIN ];
+      psOscillator->u32NoiseState = 1u;
+    }
+    else
+    {
+      SelectMipLevel( psOscillator, psInstrument->psWaveTable );
+    }
+    psOscillator->u32BaseIncrease = psOscillator->u32PhaseIncrease;
+    psOscillator->i32Level = 0;
+    EnvelopeStage( psOscillator, ADSR_ATTACK );
+  }
+}
+
+/*! *******************************************************************
+ * \brief  Releases a note
+ * \param  hNote: handle of the note
+ * \return -
+ * \note   Does nothing if the voice of the note was stolen meanwhile
+ *********************************************************************/
+static void ReleaseNote( SYNTH_NOTE hNote )
+{
+  U8 u8Voice;
+  S_SYNTH_OSCILLATOR* psOscillator;
+
+  for( u8Voice = 0u; u8Voice < NUMBER_OF_OSCILLATORS; u8Voice++ )
+  {
+    psOscillator = &gasOscillators[ u8Voice ];
+    if( ( hNote == psOscillator->hNote )
+     && ( ADSR_IDLE != psOscillator->eADSRState )
+     && ( ADSR_RELEASE != psOscillator->eADSRState ) )
+    {
+      // Release from the current level
+      EnvelopeStage( psOscillator, ADSR_RELEASE );
+    }
+  }
+}
 
+/*! *******************************************************************
+ * \brief  Executes a command of the main loop
+ * \param  psCommand: the command
+ * \return -
+ *********************************************************************/
+static void ExecuteCommand( S_SYNTH_COMMAND const* psCommand )
+{
+  S_SYNTH_INSTRUMENT* psInstrument;
+
+  SOUNDSYNTH_COMMAND_HOOK( psCommand );
+  switch( (E_SYNTH_COMMAND)psCommand->u8Command )
+  {
+    case SYNTH_COMMAND_NOTEON:
+      StartNote( psCommand->hNote, psCommand->u32PhaseIncrease, psCommand->u8Instrument, (E_SYNTH_PRIORITY)psCommand->u8Priority );
+      break;
+
+    case SYNTH_COMMAND_NOTEOFF:
+      ReleaseNote( psCommand->hNote );
+      break;
+
+    case SYNTH_COMMAND_SETINSTRUMENT:
+      if( psCommand->u8Instrument < SOUNDSYNTH_INSTRUMENTS )
+      {
+        psInstrument = &gasInstruments[ psCommand->u8Instrument ];
+        psInstrument->sCustomWaveTable.u8Levels = 1u;
+        psInstrument->sCustomWaveTable.asLevels[ 0u ].pi16Samples = psCommand->pi16WaveTable;
+        psInstrument->sCustomWaveTable.asLevels[ 0u ].u16Size = psCommand->u16WaveTableSize;
+        psInstrument->psWaveTable = &psInstrument->sCustomWaveTable;
+        psInstrument->psSample = NULL;
+        psInstrument->u8NoiseBits = 0u;
+        if( NULL != psCommand->psEnvelope )
+        {
+          psInstrument->psEnvelope = psCommand->psEnvelope;
+        }
+      }
+      break;
+
+    case SYNTH_COMMAND_SETWAVETABLE:
+      if( psCommand->u8Instrument < SOUNDSYNTH_INSTRUMENTS )
+      {
+        gasInstruments[ psCommand->u8Instrument ].psWaveTable = psCommand->psWaveTable;
+        gasInstruments[ psCommand->u8Instrument ].psSample = NULL;
+        gasInstruments[ psCommand->u8Instrument ].u8NoiseBits = 0u;
+      }
+      break;
+
+    case SYNTH_COMMAND_SETSAMPLE:
+      if( psCommand->u8Instrument < SOUNDSYNTH_INSTRUMENTS )
+      {
+        gasInstruments[ psCommand->u8Instrument ].psSample = psCommand->psSample;
+        gasInstruments[ psCommand->u8Instrument ].u8NoiseBits = 0u;
+      }
+      break;
+
+    case SYNTH_COMMAND_SETNOISE:
+      if( ( psCommand->u8Instrument < SOUNDSYNTH_INSTRUMENTS )
+       && ( psCommand->u8NoiseBits >= SYNTH_NOISE_BITS_MIN ) && ( psCommand->u8NoiseBits <= SYNTH_NOISE_BITS_MAX ) )
+      {
+        gasInstruments[ psCommand->u8Instrument ].psSample = NULL;
+        gasInstruments[ psCommand->u8Instrument ].u8NoiseBits = psCommand->u8NoiseBits;
+      }
+      break;
+
+    case SYNTH_COMMAND_SETENVELOPE:
+      if( ( psCommand->u8Instrument < SOUNDSYNTH_INSTRUMENTS ) && ( NULL != psCommand->psEnvelope ) )
+      {
+        gasInstruments[ psCommand->u8Instrument ].psEnvelope = psCommand->psEnvelope;
+      }
+      break;
+
+    default:  // This should not happen
+      break;
+  }
+}
+
+/*! *******************************************************************
+ * \brief  Puts a command into the queue (producer side)
+ * \param  psCommand: the command
+ * \return TRUE if the command was queued, FALSE if the queue is full
+ * \note   The command is written before the write index, so the renderer
+ *         never sees half-written commands. Interrupts are not masked.
+ *         The barrier keeps that order on the host threads of the tests too.
+ *********************************************************************/
+static BOOL PushCommand( S_SYNTH_COMMAND const* psCommand )
+{
+  U32 u32Write = gu32CommandWrite;
+
+  if( ( u32Write - gu32CommandRead ) >= SOUNDSYNTH_COMMAND_QUEUE )
+  {
+    return FALSE;
+  }
+  gasCommands[ u32Write & COMMAND_QUEUE_MASK ] = *psCommand;
+  MEMORY_BARRIER();
+  gu32CommandWrite = u32Write + 1u;
+
+  return TRUE;
+}
 
 //--------------------------------------------------------------------------------------------------------/
 // Interface functions
@@ -97,185 +1134,424 @@ void SoundSynth_Init( void )
   U8 u8Index;
   
   memset( (void*)gasOscillators, 0, sizeof( gasOscillators ) );
+  memset( (void*)gasInstruments, 0, sizeof( gasInstruments ) );
+  gu32NoteCounter = 0u;
+  gu32CommandWrite = 0u;
+  gu32CommandRead = 0u;
+  gu32SampleTime = 0u;
+  gu32UpsamplePosition = 0u;
+  memset( gai32UpsampleHistory, 0, sizeof( gai32UpsampleHistory ) );
+  ghLastNote = SYNTH_NOTE_NONE;
+  ghLastRenderNote = SYNTH_NOTE_NONE;
   
-  // Default: all oscillators are sine wave oscillators
   for( u8Index = 0u; u8Index < NUMBER_OF_OSCILLATORS; u8Index++ )
   {
-    // Sine wave
-    gasOscillators[ u8Index ].pi16WaveTable = gcai16SineWaveTable;
-    gasOscillators[ u8Index ].u16WaveTableSize = sizeof( gcai16SineWaveTable )/sizeof( U16 );
-    // ADSR
-    gasOscillators[ u8Index ].eADSRState = ADSR_RELEASE;
-    gasOscillators[ u8Index ].u32Attack = 0;
-    gasOscillators[ u8Index ].u32Decay = 0;
-    gasOscillators[ u8Index ].u16Sustain = 0xFFFFu;
-    gasOscillators[ u8Index ].u32Release = 0;
-    gasOscillators[ u8Index ].u32ADSRTimer = 0xFFFFFFFFu;
-    gasOscillators[ u8Index ].u16ADSROutput = 0;
-  }
-
-  //FIXME: DEBUG
-  gasOscillators[ 0u ].u32PhaseIncrease = 2*334783;//(1<<16)-1;
-  //
-//  gasOscillators[ 0u ].eADSRState = ADSR_ATTACK;
-  gasOscillators[ 0u ].u32Attack = 4410u;
-  gasOscillators[ 0u ].u32Decay = 4410u;
-  gasOscillators[ 0u ].u16Sustain = 0x0u;
-  gasOscillators[ 0u ].u32Release = 0u;
-//  gasOscillators[ 0u ].u32ADSRTimer = 0;
+    gasOscillators[ u8Index ].eADSRState = ADSR_IDLE;
+  }
+
+  // Default: all instruments are sustained sine waves
+  SoundSynth_PrepareEnvelope( &gsSustainedEnvelope, 0u, 0u, 0xFFFFu, 0u, SYNTH_CURVE_LINEAR );
+  for( u8Index = 0u; u8Index < SOUNDSYNTH_INSTRUMENTS; u8Index++ )
+  {
+    gasInstruments[ u8Index ].psWaveTable = &gcsSineWaveTable;
+    gasInstruments[ u8Index ].psSample = NULL;
+    gasInstruments[ u8Index ].u8NoiseBits = 0u;
+    gasInstruments[ u8Index ].psEnvelope = &gsSustainedEnvelope;
+  }
+
+  // Chime for the sound effects: 100 ms attack, 100 ms decay to silence
+  SoundSynth_PrepareEnvelope( &gsChimeEnvelope, 4410u, 4410u, 0x0u, 0u, SYNTH_CURVE_LINEAR );
+  gasInstruments[ SYNTH_INSTRUMENT_CHIME ].psEnvelope = &gsChimeEnvelope;
+
+  // Band-limited waveforms for the music
+  gasInstruments[ SYNTH_INSTRUMENT_SQUARE ].psWaveTable = &gcsSquareWaveTable;
+  gasInstruments[ SYNTH_INSTRUMENT_SAW ].psWaveTable = &gcsSawWaveTable;
+
+  // Sound effect samples
+  gasInstruments[ SYNTH_INSTRUMENT_LOCK ].psSample = &gcsLockSample;
+  gasInstruments[ SYNTH_INSTRUMENT_LINECLEAR ].psSample = &gcsLineClearSample;
+
+  // Percussion: 15 bit noise with a 200 ms exponential decay, 7 bit metallic noise with 80 ms
+  SoundSynth_PrepareEnvelope( &gsDrumEnvelope, 0u, 8820u, 0x0u, 2205u, SYNTH_CURVE_EXPONENTIAL );
+  SoundSynth_PrepareEnvelope( &gsCymbalEnvelope, 0u, 3528u, 0x0u, 2205u, SYNTH_CURVE_EXPONENTIAL );
+  gasInstruments[ SYNTH_INSTRUMENT_DRUM ].u8NoiseBits = 15u;
+  gasInstruments[ SYNTH_INSTRUMENT_DRUM ].psEnvelope = &gsDrumEnvelope;
+  gasInstruments[ SYNTH_INSTRUMENT_CYMBAL ].u8NoiseBits = 7u;
+  gasInstruments[ SYNTH_INSTRUMENT_CYMBAL ].psEnvelope = &gsCymbalEnvelope;
 }
 
- /*! *******************************************************************
- * \brief  Generate one sound sample
- * \param  -
- * \return One sound sample
+/*! *******************************************************************
+ * \brief  Renders a block of stereo frames
+ * \param  pi16Buffer: output buffer (left and right samples interleaved)
+ * \param  u16Frames: number of frames to render
+ * \param  u16GainQ15: master gain (Q15, 0x8000 is unity gain)
+ * \return -
+ * \note   Executes the queued commands at their sample time: the block is
+ *         split where a command is due
  *********************************************************************/
-I16 SoundSynth_Sample( void )
+void SoundSynth_Render( I16* pi16Buffer, U16 u16Frames, U16 u16GainQ15 )
 {
-  U8  u8Index;
-  I16 i16Sample = 0;
-  U32 u32Phase;
-  U16 u16ADSR;
-  
-  // Increase the phase of each oscillators
-  for( u8Index = 0u; u8Index < NUMBER_OF_OSCILLATORS; u8Index++ )
-  {
-    u32Phase = gasOscillators[ u8Index ].u32PhaseIncrease;
-    gasOscillators[ u8Index ].u32Phase += u32Phase;
-    if( gasOscillators[ u8Index ].u32Phase > ((U32)gasOscillators[ u8Index ].u16WaveTableSize<<16u) )
-    {
-      u32Phase = ((U32)gasOscillators[ u8Index ].u16WaveTableSize<<16u);
-      gasOscillators[ u8Index ].u32Phase -= u32Phase;
-    }
-  }
-  
-  // ADSR envelope generator
-  for( u8Index = 0u; u8Index < NUMBER_OF_OSCILLATORS; u8Index++ )
+  U16 u16Block;
+  U32 u32Read;
+  I32 i32Wait;
+  S_SYNTH_COMMAND sCommand;
+
+  while( 0u != u16Frames )
   {
-    switch( gasOscillators[ u8Index ].eADSRState )
+    u16Block = ( u16Frames > SOUNDSYNTH_BLOCK_FRAMES ) ? SOUNDSYNTH_BLOCK_FRAMES : u16Frames;
+
+    // Execute the commands that are due, and render until the next one
+    u32Read = gu32CommandRead;
+    while( u32Read != gu32CommandWrite )
     {
-      case ADSR_ATTACK:
-        if( 0u != gasOscillators[ u8Index ].u32Attack )
+      // The command is read after the index that published it, and given back after it was copied
+      MEMORY_BARRIER();
+      sCommand = gasCommands[ u32Read & COMMAND_QUEUE_MASK ];
+      i32Wait = (I32)( sCommand.u32Time - gu32SampleTime );
+      if( i32Wait > 0 )
+      {
+        if( i32Wait < (I32)u16Block )
         {
-          u16ADSR = (U64)0xFFFFu*gasOscillators[ u8Index ].u32ADSRTimer / gasOscillators[ u8Index ].u32Attack;
-        }
-        else
-        {
-          u16ADSR = 0xFFFFu;
-        }
-        gasOscillators[ u8Index ].u32ADSRTimer++;
-        if( gasOscillators[ u8Index ].u32ADSRTimer > gasOscillators[ u8Index ].u32Attack )
-        {
-          gasOscillators[ u8Index ].u32ADSRTimer = 0u;
-          gasOscillators[ u8Index ].eADSRState = ADSR_DECAY;
-        }
-        break;
-        
-      case ADSR_DECAY:
-        if( 0u != gasOscillators[ u8Index ].u32Decay )
-        {
-          u16ADSR = 0xFFFFu - (U64)(0xFFFFu - gasOscillators[ u8Index ].u16Sustain)*gasOscillators[ u8Index ].u32ADSRTimer / gasOscillators[ u8Index ].u32Decay;
-        }
-        else
-        {
-          u16ADSR = gasOscillators[ u8Index ].u16Sustain;
-        }
-        gasOscillators[ u8Index ].u32ADSRTimer++;
-        if( gasOscillators[ u8Index ].u32ADSRTimer > gasOscillators[ u8Index ].u32Decay )
-        {
-          gasOscillators[ u8Index ].u32ADSRTimer = 0u;
-          gasOscillators[ u8Index ].eADSRState = ADSR_SUSTAIN;
-        }
-        break;
-        
-      case ADSR_SUSTAIN:
-        u16ADSR = gasOscillators[ u8Index ].u16Sustain;
-        break;
-        
-      case ADSR_RELEASE:
-        if( 0u != gasOscillators[ u8Index ].u32Release )
-        {
-          u16ADSR = (U64)gasOscillators[ u8Index ].u16Sustain*( gasOscillators[ u8Index ].u32Release - gasOscillators[ u8Index ].u32ADSRTimer ) / gasOscillators[ u8Index ].u32Release;
-        }
-        else
-        {
-          u16ADSR = 0u;
-        }
-        if( gasOscillators[ u8Index ].u32ADSRTimer < gasOscillators[ u8Index ].u32Release )
-        {
-          gasOscillators[ u8Index ].u32ADSRTimer++;
+          u16Block = (U16)i32Wait;
         }
         break;
+      }
+      ExecuteCommand( &sCommand );
+      u32Read++;
+      MEMORY_BARRIER();
+      gu32CommandRead = u32Read;
     }
-    gasOscillators[ u8Index ].u16ADSROutput = u16ADSR;
+
+    RenderBlock( pi16Buffer, u16Block, u16GainQ15 );
+    gu32SampleTime += u16Block;
+    pi16Buffer += 2u*u16Block;
+    u16Frames -= u16Block;
   }
-  
-  // Mixer
-  for( u8Index = 0u; u8Index < NUMBER_OF_OSCILLATORS; u8Index++ )
+}
+
+ /*! *******************************************************************
+ * \brief  Returns the sample time of the renderer
+ * \param  -
+ * \return Number of frames rendered so far
+ *********************************************************************/
+U32 SoundSynth_GetTime( void )
+{
+  return gu32SampleTime;
+}
+
+ /*! *******************************************************************
+ * \brief  Returns the free space in the command queue
+ * \param  -
+ * \return Number of commands that can be queued
+ *********************************************************************/
+U32 SoundSynth_GetQueueSpace( void )
+{
+  return SOUNDSYNTH_COMMAND_QUEUE - ( gu32CommandWrite - gu32CommandRead );
+}
+
+ /*! *******************************************************************
+ * \brief  Starts a note on a free (or stolen) voice
+ * \param  u32PhaseIncrease: phase increase per sample
+ * \param  u8Instrument: instrument slot
+ * \param  ePriority: priority class of the note
+ * \param  u32Time: sample time of the start, see SoundSynth_GetTime()
+ * \return Handle of the note, or SYNTH_NOTE_NONE if the command queue is full
+ * \note   The times of the queued commands must not decrease. A time in the
+ *         past starts the note at the beginning of the next block.
+ *********************************************************************/
+SYNTH_NOTE SoundSynth_NoteOn( U32 u32PhaseIncrease, U8 u8Instrument, E_SYNTH_PRIORITY ePriority, U32 u32Time )
+{
+  S_SYNTH_COMMAND sCommand;
+  SYNTH_NOTE hNote = ( ghLastNote + 1u ) & ~NOTE_RENDER_FLAG;
+
+  if( SYNTH_NOTE_NONE == hNote )
   {
-    u32Phase = gasOscillators[ u8Index ].u32Phase>>16u;
-    u16ADSR = gasOscillators[ u8Index ].u16ADSROutput;
-#warning "ˇˇEz itt nem jó, mert az előjelkiterjesztés hiányzik!"
-    i16Sample += (U32)gasOscillators[ u8Index ].pi16WaveTable[ u32Phase ]*u16ADSR / (NUMBER_OF_OSCILLATORS*65536u);
+    hNote++;
+  }
+
+  memset( &sCommand, 0, sizeof( sCommand ) );
+  sCommand.u32Time = u32Time;
+  sCommand.u32PhaseIncrease = u32PhaseIncrease;
+  sCommand.hNote = hNote;
+  sCommand.u8Command = (U8)SYNTH_COMMAND_NOTEON;
+  sCommand.u8Instrument = u8Instrument;
+  sCommand.u8Priority = (U8)ePriority;
+  if( TRUE != PushCommand( &sCommand ) )
+  {
+    return SYNTH_NOTE_NONE;
+  }
+  ghLastNote = hNote;
+
+  return hNote;
+}
+
+ /*! *******************************************************************
+ * \brief  Releases a note
+ * \param  hNote: handle of the note
+ * \param  u32Time: sample time of the release, see SoundSynth_GetTime()
+ * \return -
+ * \note   Does nothing if the voice of the note was stolen meanwhile.
+ *         The release is lost if the command queue is full.
+ *********************************************************************/
+void SoundSynth_NoteOff( SYNTH_NOTE hNote, U32 u32Time )
+{
+  S_SYNTH_COMMAND sCommand;
+
+  if( SYNTH_NOTE_NONE != hNote )
+  {
+    memset( &sCommand, 0, sizeof( sCommand ) );
+    sCommand.u32Time = u32Time;
+    sCommand.hNote = hNote;
+    sCommand.u8Command = (U8)SYNTH_COMMAND_NOTEOFF;
+    (void)PushCommand( &sCommand );
   }
-  
-  return i16Sample;
 }
 
  /*! *******************************************************************
- * \brief  Press a note, and start the envelope generator
+ * \brief  Starts a note immediately, from the audio render context
  * \param  u32PhaseIncrease: phase increase per sample
- * \param  u8Oscillator: index of the oscillator
+ * \param  u8Instrument: instrument slot
+ * \param  ePriority: priority class of the note
+ * \return Handle of the note
+ * \note   For the sequencer running inside the renderer, must not be called from the main loop
+ *********************************************************************/
+SYNTH_NOTE SoundSynth_RenderNoteOn( U32 u32PhaseIncrease, U8 u8Instrument, E_SYNTH_PRIORITY ePriority )
+{
+  ghLastRenderNote = ( ghLastRenderNote + 1u ) | NOTE_RENDER_FLAG;
+  StartNote( ghLastRenderNote, u32PhaseIncrease, u8Instrument, ePriority );
+
+  return ghLastRenderNote;
+}
+
+ /*! *******************************************************************
+ * \brief  Releases a note immediately, from the audio render context
+ * \param  hNote: handle of the note
+ * \return -
+ * \note   For the sequencer running inside the renderer, must not be called from the main loop
+ *********************************************************************/
+void SoundSynth_RenderNoteOff( SYNTH_NOTE hNote )
+{
+  if( SYNTH_NOTE_NONE != hNote )
+  {
+    ReleaseNote( hNote );
+  }
+}
+
+ /*! *******************************************************************
+ * \brief  Bends the pitch of a note, from the audio render context
+ * \param  hNote: handle of the note
+ * \param  i16Bend: pitch bend (1/SYNTH_PITCH_SEMITONE semitones), 0 is the original pitch
  * \return -
+ * \note   For the sequencer running inside the renderer, must not be called from the main loop
  *********************************************************************/
-void SoundSynth_Press( U32 u32PhaseIncrease, U8 u8Oscillator )
+void SoundSynth_RenderSetPitchBend( SYNTH_NOTE hNote, I16 i16Bend )
 {
-  if( u8Oscillator < NUMBER_OF_OSCILLATORS )
+  U8 u8Voice;
+  S_SYNTH_OSCILLATOR* psOscillator;
+
+  for( u8Voice = 0u; u8Voice < NUMBER_OF_OSCILLATORS; u8Voice++ )
   {
-    __disable_irq();
-    gasOscillators[ u8Oscillator ].u32PhaseIncrease = u32PhaseIncrease;
-    gasOscillators[ u8Oscillator ].u32ADSRTimer = 0u;
-    gasOscillators[ u8Oscillator ].eADSRState = ADSR_ATTACK;
-    __enable_irq();
+    psOscillator = &gasOscillators[ u8Voice ];
+    if( ( SYNTH_NOTE_NONE != hNote ) && ( hNote == psOscillator->hNote ) && ( ADSR_IDLE != psOscillator->eADSRState ) )
+    {
+      psOscillator->i16PitchBend = i16Bend;
+      UpdatePitch( psOscillator, 0u );
+    }
   }
 }
 
  /*! *******************************************************************
- * \brief  Release the sound on an oscillator
- * \param  u8Oscillator: index of the oscillator
+ * \brief  Sets the vibrato of a note, from the audio render context
+ * \param  hNote: handle of the note
+ * \param  u16Depth: peak pitch deviation (1/SYNTH_PITCH_SEMITONE semitones), 0 turns the vibrato off
+ * \param  u16Rate: vibrato frequency (1/100 Hz)
  * \return -
+ * \note   For the sequencer running inside the renderer, must not be called from the main loop.
+ *         The vibrato is a sine wave, its phase is kept when only the depth changes.
  *********************************************************************/
-void SoundSynth_Release( U8 u8Oscillator )
+void SoundSynth_RenderSetVibrato( SYNTH_NOTE hNote, U16 u16Depth, U16 u16Rate )
 {
-  if( u8Oscillator < NUMBER_OF_OSCILLATORS )
+  U8 u8Voice;
+  S_SYNTH_OSCILLATOR* psOscillator;
+  U32 u32LfoIncrease;
+
+  // One LFO period is 2^32
+  u32LfoIncrease = (U32)( ( (U64)u16Rate<<32u )/( 100u*SOUNDSYNTH_INTERNAL_RATE ) );
+
+  for( u8Voice = 0u; u8Voice < NUMBER_OF_OSCILLATORS; u8Voice++ )
   {
-    __disable_irq();
-    gasOscillators[ u8Oscillator ].u32ADSRTimer = 0u;
-    gasOscillators[ u8Oscillator ].eADSRState = ADSR_RELEASE;
-    __enable_irq();
+    psOscillator = &gasOscillators[ u8Voice ];
+    if( ( SYNTH_NOTE_NONE != hNote ) && ( hNote == psOscillator->hNote ) && ( ADSR_IDLE != psOscillator->eADSRState ) )
+    {
+      psOscillator->u16VibratoDepth = u16Depth;
+      psOscillator->u32LfoIncrease = u32LfoIncrease;
+      UpdatePitch( psOscillator, 0u );
+    }
   }
 }
 
  /*! *******************************************************************
- * \brief  Sets the instrument sample table on a given oscillator
- * \param  u8Oscillator: index of the oscillator
+ * \brief  Sets the sample table of an instrument
+ * \param  u8Instrument: instrument slot
  * \param  pi16WaveTable: pointer to the beginning of the sample
- * \param  u16WaveTableSize: wave table size in bytes
+ * \param  u16WaveTableSize: wave table size in words, must be a power of two
+ * \param  psEnvelope: envelope prepared by SoundSynth_PrepareEnvelope(), must
+ *         stay valid; NULL keeps the envelope of the slot
+ * \return -
+ * \note   Goes through the command queue, takes effect from the next note.
+ *         The table holds one period, the pitch does not depend on its size.
+ *         It is not band-limited, so high notes may alias.
+ *********************************************************************/
+void SoundSynth_SetInstrument( U8 u8Instrument, I16 PACKED_STRUCT* pi16WaveTable, U16 u16WaveTableSize, S_SYNTH_ENVELOPE const* psEnvelope )
+{
+  S_SYNTH_COMMAND sCommand;
+
+  memset( &sCommand, 0, sizeof( sCommand ) );
+  sCommand.u32Time = gu32SampleTime;
+  sCommand.pi16WaveTable = (I16 const*)pi16WaveTable;
+  sCommand.u16WaveTableSize = u16WaveTableSize;
+  sCommand.psEnvelope = psEnvelope;
+  sCommand.u8Command = (U8)SYNTH_COMMAND_SETINSTRUMENT;
+  sCommand.u8Instrument = u8Instrument;
+  (void)PushCommand( &sCommand );
+}
+
+ /*! *******************************************************************
+ * \brief  Sets the band-limited wavetable of an instrument
+ * \param  u8Instrument: instrument slot
+ * \param  psWaveTable: wavetable with its mip levels, must stay valid
+ * \return -
+ * \note   Goes through the command queue, takes effect from the next note
+ *********************************************************************/
+void SoundSynth_SetWaveTable( U8 u8Instrument, S_WAVETABLE const* psWaveTable )
+{
+  S_SYNTH_COMMAND sCommand;
+
+  memset( &sCommand, 0, sizeof( sCommand ) );
+  sCommand.u32Time = gu32SampleTime;
+  sCommand.psWaveTable = psWaveTable;
+  sCommand.u8Command = (U8)SYNTH_COMMAND_SETWAVETABLE;
+  sCommand.u8Instrument = u8Instrument;
+  (void)PushCommand( &sCommand );
+}
+
+ /*! *******************************************************************
+ * \brief  Makes an instrument play a one-shot ADPCM sample
+ * \param  u8Instrument: instrument slot
+ * \param  psSample: the encoded sample, must stay valid
  * \return -
+ * \note   Goes through the command queue, takes effect from the next note.
+ *         The phase increase of the notes is the playback rate, see
+ *         SYNTH_PLAYBACK_RATE(). The note ends with the sample, or at the
+ *         end of the release.
  *********************************************************************/
-void SoundSynth_SetInstrument( U8 u8Oscillator, I16 PACKED_STRUCT* pi16WaveTable, U16 u16WaveTableSize )
+void SoundSynth_SetSample( U8 u8Instrument, S_ADPCM_SAMPLE const* psSample )
 {
-#warning "TODO: set ADSR parameters too"
-  if( u8Oscillator < NUMBER_OF_OSCILLATORS )
+  S_SYNTH_COMMAND sCommand;
+
+  memset( &sCommand, 0, sizeof( sCommand ) );
+  sCommand.u32Time = gu32SampleTime;
+  sCommand.psSample = psSample;
+  sCommand.u8Command = (U8)SYNTH_COMMAND_SETSAMPLE;
+  sCommand.u8Instrument = u8Instrument;
+  (void)PushCommand( &sCommand );
+}
+
+ /*! *******************************************************************
+ * \brief  Makes an instrument play shift register noise
+ * \param  u8Instrument: instrument slot
+ * \param  u8Bits: length of the shift register (SYNTH_NOISE_BITS_MIN..SYNTH_NOISE_BITS_MAX),
+ *         short registers repeat quickly and sound metallic
+ * \return -
+ * \note   Goes through the command queue, takes effect from the next note.
+ *         The phase increase of the notes is the clock of the shift
+ *         register, see SYNTH_NOISE_CLOCK(); at most one shift per sample.
+ *********************************************************************/
+void SoundSynth_SetNoise( U8 u8Instrument, U8 u8Bits )
+{
+  S_SYNTH_COMMAND sCommand;
+
+  memset( &sCommand, 0, sizeof( sCommand ) );
+  sCommand.u32Time = gu32SampleTime;
+  sCommand.u8NoiseBits = u8Bits;
+  sCommand.u8Command = (U8)SYNTH_COMMAND_SETNOISE;
+  sCommand.u8Instrument = u8Instrument;
+  (void)PushCommand( &sCommand );
+}
+
+ /*! *******************************************************************
+ * \brief  Sets the envelope of an instrument
+ * \param  u8Instrument: instrument slot
+ * \param  psEnvelope: envelope prepared by SoundSynth_PrepareEnvelope(), must stay valid
+ * \return -
+ * \note   Goes through the command queue, takes effect from the next note
+ *********************************************************************/
+void SoundSynth_SetEnvelope( U8 u8Instrument, S_SYNTH_ENVELOPE const* psEnvelope )
+{
+  S_SYNTH_COMMAND sCommand;
+
+  memset( &sCommand, 0, sizeof( sCommand ) );
+  sCommand.u32Time = gu32SampleTime;
+  sCommand.psEnvelope = psEnvelope;
+  sCommand.u8Command = (U8)SYNTH_COMMAND_SETENVELOPE;
+  sCommand.u8Instrument = u8Instrument;
+  (void)PushCommand( &sCommand );
+}
+
+ /*! *******************************************************************
+ * \brief  Converts the parameters of an envelope for the renderer
+ * \param  psEnvelope: the envelope is filled in here
+ * \param  u32Attack: attack time in samples
+ * \param  u32Decay: decay time in samples
+ * \param  u16Sustain: sustain level
+ * \param  u32Release: release time in samples
+ * \param  eCurve: shape of the envelope stages
+ * \return -
+ * \note   Callable from anywhere, only the given envelope is written. The
+ *         times are given at SAMPLE_RATE. Does the divisions of the stages
+ *         once, so starting a note costs the same with any envelope.
+ *********************************************************************/
+void SoundSynth_PrepareEnvelope( S_SYNTH_ENVELOPE* psEnvelope, U32 u32Attack, U32 u32Decay, U16 u16Sustain, U32 u32Release, E_SYNTH_CURVE eCurve )
+{
+  I32 i32Sustain = (I32)u16Sustain<<ENVELOPE_LEVEL_SHIFT;
+
+  psEnvelope->eCurve = eCurve;
+  psEnvelope->u16Sustain = u16Sustain;
+  PrepareStage( &psEnvelope->sAttack, u32Attack>>SOUNDSYNTH_RATE_SHIFT, ENVELOPE_LEVEL_MAX );
+  PrepareStage( &psEnvelope->sDecay, u32Decay>>SOUNDSYNTH_RATE_SHIFT, i32Sustain - ENVELOPE_LEVEL_MAX );
+  PrepareStage( &psEnvelope->sRelease, u32Release>>SOUNDSYNTH_RATE_SHIFT, -i32Sustain );
+}
+
+ /*! *******************************************************************
+ * \brief  Sets the voice and the envelope of an instrument, from the audio
+ *         render context
+ * \param  u8Instrument: instrument slot
+ * \param  psPatch: the patch, must stay valid while the slot is played
+ * \return -
+ * \note   For the sequencer running inside the renderer, must not be called
+ *         from the main loop. Takes effect from the next note.
+ *********************************************************************/
+void SoundSynth_RenderSetPatch( U8 u8Instrument, S_SYNTH_PATCH const* psPatch )
+{
+  S_SYNTH_INSTRUMENT* psInstrument;
+
+  if( u8Instrument < SOUNDSYNTH_INSTRUMENTS )
   {
-    __disable_irq();
-    gasOscillators[ u8Oscillator ].pi16WaveTable = (I16 const*)pi16WaveTable;
-    gasOscillators[ u8Oscillator ].u16WaveTableSize = u16WaveTableSize;
-    gasOscillators[ u8Oscillator ].u32Phase = 0u;
-    gasOscillators[ u8Oscillator ].u32PhaseIncrease = 0u;
-    gasOscillators[ u8Oscillator ].u32ADSRTimer = 0xFFFFFFFFu;
-    gasOscillators[ u8Oscillator ].eADSRState = ADSR_RELEASE;
-    __enable_irq();
+    psInstrument = &gasInstruments[ u8Instrument ];
+    if( NULL != psPatch->psWaveTable )
+    {
+      psInstrument->psWaveTable = psPatch->psWaveTable;
+    }
+    else
+    {
+      psInstrument->sCustomWaveTable.u8Levels = 1u;
+      psInstrument->sCustomWaveTable.asLevels[ 0u ].pi16Samples = psPatch->pi16WaveTable;
+      psInstrument->sCustomWaveTable.asLevels[ 0u ].u16Size = psPatch->u16WaveTableSize;
+      psInstrument->psWaveTable = &psInstrument->sCustomWaveTable;
+    }
+    psInstrument->psSample = NULL;
+    psInstrument->u8NoiseBits = psPatch->u8NoiseBits;
+    psInstrument->psEnvelope = &psPatch->sEnvelope;
   }
 }
 
@@ -17,18 +17,100 @@
 //--------------------------------------------------------------------------------------------------------/
 // Include files
 //--------------------------------------------------------------------------------------------------------/
+#include "sound_wavetables.h"
+#include "adpcm.h"
 
 
 //--------------------------------------------------------------------------------------------------------/
 // Definitions
 //--------------------------------------------------------------------------------------------------------/
-#define NUMBER_OF_OSCILLATORS           (4u)  //!< Number of oscillators of the synthesizer
+#define NUMBER_OF_OSCILLATORS          (12u)  //!< Number of oscillators (voices) of the synthesizer
 #define SAMPLE_RATE                 (44100u)  //!< Sampling rate in Hz
+#ifndef SOUNDSYNTH_RATE_SHIFT
+#define SOUNDSYNTH_RATE_SHIFT           (0u)  //!< Voices are rendered at SAMPLE_RATE/2^n (0: 44.1 kHz, 1: 22.05 kHz, 2: 11.025 kHz) and upsampled
+#endif
+#define SOUNDSYNTH_INTERNAL_RATE  ( SAMPLE_RATE>>SOUNDSYNTH_RATE_SHIFT )  //!< Rendering rate of the voices in Hz
+#define SOUNDSYNTH_BLOCK_FRAMES       (128u)  //!< Maximum number of frames rendered in one pass
+#define SOUNDSYNTH_MIX_HEADROOM         (2u)  //!< Mixer headroom in bits: one voice at full scale gives 1/2^n of the output range
+#define SOUNDSYNTH_INSTRUMENTS         (16u)  //!< Number of instrument slots
+#define SOUNDSYNTH_COMMAND_QUEUE       (32u)  //!< Size of the command queue, must be a power of two
+#define SYNTH_WAVETABLE_SIZE          (512u)  //!< Reference wave table size: a phase increase of 65536 plays SAMPLE_RATE/SYNTH_WAVETABLE_SIZE Hz with any table
+#define SYNTH_SAMPLE_MAX_RATE           (2u)  //!< Fastest playback of a sample, in source samples per output sample
+#define SYNTH_PITCH_SEMITONE          (256u)  //!< Pitch bend and vibrato depth units in a semitone
+#define SYNTH_NOISE_BITS_MIN            (3u)  //!< Shortest noise shift register
+#define SYNTH_NOISE_BITS_MAX           (16u)  //!< Longest noise shift register
+
+#define SYNTH_INSTRUMENT_SINE           (0u)  //!< Instrument slot of the sustained sine wave
+#define SYNTH_INSTRUMENT_CHIME          (1u)  //!< Instrument slot of the sound effect chime
+#define SYNTH_INSTRUMENT_SQUARE         (2u)  //!< Instrument slot of the sustained band-limited square wave
+#define SYNTH_INSTRUMENT_SAW            (3u)  //!< Instrument slot of the sustained band-limited sawtooth wave
+#define SYNTH_INSTRUMENT_LOCK           (4u)  //!< Instrument slot of the tetromino lock sample
+#define SYNTH_INSTRUMENT_LINECLEAR      (5u)  //!< Instrument slot of the line clear sample
+#define SYNTH_INSTRUMENT_DRUM           (6u)  //!< Instrument slot of the drums: long shift register noise
+#define SYNTH_INSTRUMENT_CYMBAL         (7u)  //!< Instrument slot of the hi-hats and cymbals: short, metallic shift register noise
+#define SYNTH_INSTRUMENT_MODULE         (8u)  //!< First instrument slot of the instruments defined by the tracker module
+#define SOUNDSYNTH_MODULE_INSTRUMENTS  ( SOUNDSYNTH_INSTRUMENTS - SYNTH_INSTRUMENT_MODULE )  //!< Number of instruments a tracker module can define
+
+//! \brief Phase increase of a sample instrument that plays a sample recorded at u32Hz
+#define SYNTH_PLAYBACK_RATE( u32Hz )  ( (U32)( ( (U64)(u32Hz)<<16u )/SAMPLE_RATE ) )
+
+//! \brief Phase increase of a noise instrument that clocks the shift register at u32Hz
+#define SYNTH_NOISE_CLOCK( u32Hz )  SYNTH_PLAYBACK_RATE( u32Hz )
+
+#define SYNTH_NOTE_NONE                 (0u)  //!< Invalid note handle
 
 
 //--------------------------------------------------------------------------------------------------------/
 // Types
 //--------------------------------------------------------------------------------------------------------/
+//! \brief Shape of the envelope stages
+typedef enum
+{
+  SYNTH_CURVE_LINEAR,
+  SYNTH_CURVE_EXPONENTIAL
+} E_SYNTH_CURVE;
+
+//! \brief Priority classes of the notes: a note can only steal the voice of a note with the same or lower priority
+typedef enum
+{
+  SYNTH_PRIORITY_MUSIC,
+  SYNTH_PRIORITY_SFX
+} E_SYNTH_PRIORITY;
+
+typedef U16 SYNTH_NOTE;  //!< Note handle
+
+//! \brief One stage of a prepared envelope
+typedef struct
+{
+  U32 u32Samples;        //!< Length of the stage at SOUNDSYNTH_INTERNAL_RATE
+  I32 i32Delta;          //!< Level change over the stage from the level it normally starts at
+  I32 i32LevelStep;      //!< Level change per sample for i32Delta
+  U16 u16StepFraction;   //!< Fraction of the level step (1/65536 of the level LSB)
+} S_SYNTH_STAGE;
+
+//! \brief Envelope of an instrument, filled in by SoundSynth_PrepareEnvelope()
+//! \note  The divisions of the stages are done when the envelope is prepared.
+//!        The attack starts from silence, the decay from full scale and the
+//!        release from the sustain level; only a stage that starts from another
+//!        level (e.g. a note released in its attack) is calculated by the renderer.
+typedef struct
+{
+  E_SYNTH_CURVE eCurve;    //!< Shape of the envelope stages
+  U16 u16Sustain;          //!< Sustain level
+  S_SYNTH_STAGE sAttack;   //!< Attack stage
+  S_SYNTH_STAGE sDecay;    //!< Decay stage
+  S_SYNTH_STAGE sRelease;  //!< Release stage
+} S_SYNTH_ENVELOPE;
+
+//! \brief Voice and envelope of an instrument, e.g. one defined by a tracker module
+typedef struct
+{
+  S_WAVETABLE const* psWaveTable;  //!< Band-limited wavetable, NULL if pi16WaveTable is played
+  I16 const*  pi16WaveTable;       //!< Single level wavetable: one period
+  U16         u16WaveTableSize;    //!< Size of pi16WaveTable in words, must be a power of two
+  U8          u8NoiseBits;         //!< Length of the noise shift register, 0: not a noise instrument
+  S_SYNTH_ENVELOPE sEnvelope;      //!< Prepared envelope
+} S_SYNTH_PATCH;
 
 
 //--------------------------------------------------------------------------------------------------------/
@@ -40,12 +122,26 @@
 // Interface functions
 //--------------------------------------------------------------------------------------------------------/
 void SoundSynth_Init( void );
-I16 SoundSynth_Sample( void );
+void SoundSynth_Render( I16* pi16Buffer, U16 u16Frames, U16 u16GainQ15 );
 
 // Functions that are callable from main loop
-void SoundSynth_Press( U32 u32PhaseIncrease, U8 u8Oscillator );
-void SoundSynth_Release( U8 u8Oscillator );
-void SoundSynth_SetInstrument( U8 u8Oscillator, I16 PACKED_STRUCT* pi16WaveTable, U16 u16WaveTableSize );
+U32 SoundSynth_GetTime( void );
+U32 SoundSynth_GetQueueSpace( void );
+SYNTH_NOTE SoundSynth_NoteOn( U32 u32PhaseIncrease, U8 u8Instrument, E_SYNTH_PRIORITY ePriority, U32 u32Time );
+void SoundSynth_NoteOff( SYNTH_NOTE hNote, U32 u32Time );
+void SoundSynth_SetInstrument( U8 u8Instrument, I16 PACKED_STRUCT* pi16WaveTable, U16 u16WaveTableSize, S_SYNTH_ENVELOPE const* psEnvelope );
+void SoundSynth_SetWaveTable( U8 u8Instrument, S_WAVETABLE const* psWaveTable );
+void SoundSynth_SetSample( U8 u8Instrument, S_ADPCM_SAMPLE const* psSample );
+void SoundSynth_SetNoise( U8 u8Instrument, U8 u8Bits );
+void SoundSynth_SetEnvelope( U8 u8Instrument, S_SYNTH_ENVELOPE const* psEnvelope );
+void SoundSynth_PrepareEnvelope( S_SYNTH_ENVELOPE* psEnvelope, U32 u32Attack, U32 u32Decay, U16 u16Sustain, U32 u32Release, E_SYNTH_CURVE eCurve );
+
+// Functions that are called from the audio render context
+SYNTH_NOTE SoundSynth_RenderNoteOn( U32 u32PhaseIncrease, U8 u8Instrument, E_SYNTH_PRIORITY ePriority );
+void SoundSynth_RenderNoteOff( SYNTH_NOTE hNote );
+void SoundSynth_RenderSetPitchBend( SYNTH_NOTE hNote, I16 i16Bend );
+void SoundSynth_RenderSetVibrato( SYNTH_NOTE hNote, U16 u16Depth, U16 u16Rate );
+void SoundSynth_RenderSetPatch( U8 u8Instrument, S_SYNTH_PATCH const* psPatch );
 
 
 #endif  // SOUND_SYNTH_H
@@ -60,7 +60,280 @@ const I16 gcai16SineWaveTable[ 512u ] =
   -5998, -5602, -5205, -4808, -4410, -4011, -3612, -3212, -2811, -2410, -2009, -1608, -1206, -804, -402, 0
 };
 
+//! \brief Sine wave: it has no harmonics, so one level is enough for every octave
+const S_WAVETABLE gcsSineWaveTable =
+{
+  1u,
+  {
+    { gcai16SineWaveTable, 512u }
+  }
+};
+
+// The band-limited tables below are generated by tools/wavegen
+
+//! \brief Mip level 0 of the sawtooth wave: 128 harmonics
+static const I16 gcai16SawWaveTable0[ 512u ] =
+{
+  0, 40, 219, 397, 435, 477, 658, 834, 871, 914, 1097, 1271, 1306, 1351, 1536, 1709, 
+  1742, 1789, 1975, 2146, 2177, 2226, 2414, 2583, 2613, 2663, 2853, 3020, 3048, 3100, 3292, 3457, 
+  3483, 3537, 3731, 3894, 3919, 3974, 4170, 4332, 4354, 4412, 4609, 4769, 4790, 4849, 5048, 5206, 
+  5225, 5286, 5487, 5643, 5660, 5723, 5926, 6080, 6095, 6160, 6365, 6517, 6531, 6597, 6804, 6955, 
+  6966, 7035, 7243, 7392, 7401, 7472, 7682, 7829, 7836, 7909, 8121, 8266, 8271, 8346, 8561, 8703, 
+  8706, 8783, 9000, 9140, 9141, 9220, 9440, 9577, 9576, 9658, 9879, 10015, 10011, 10095, 10319, 10452, 
+  10445, 10532, 10758, 10889, 10880, 10969, 11198, 11326, 11315, 11406, 11638, 11763, 11749, 11844, 12078, 12200, 
+  12183, 12281, 12518, 12637, 12618, 12718, 12958, 13075, 13052, 13155, 13398, 13512, 13486, 13592, 13838, 13949, 
+  13920, 14029, 14279, 14386, 14353, 14467, 14720, 14823, 14787, 14904, 15161, 15260, 15220, 15341, 15602, 15697, 
+  15653, 15778, 16043, 16135, 16086, 16215, 16485, 16572, 16518, 16653, 16927, 17009, 16951, 17090, 17369, 17446, 
+  17382, 17527, 17812, 17883, 17814, 17964, 18255, 18320, 18245, 18402, 18699, 18757, 18675, 18839, 19143, 19194, 
+  19105, 19276, 19588, 19631, 19534, 19713, 20033, 20068, 19962, 20151, 20480, 20505, 20390, 20588, 20927, 20942, 
+  20816, 21025, 21376, 21379, 21241, 21463, 21827, 21816, 21664, 21900, 22279, 22253, 22085, 22338, 22733, 22690, 
+  22503, 22775, 23191, 23126, 22918, 23213, 23652, 23563, 23329, 23651, 24118, 23999, 23734, 24090, 24591, 24435, 
+  24132, 24528, 25073, 24870, 24518, 24968, 25569, 25304, 24887, 25409, 26085, 25736, 25230, 25852, 26637, 26165, 
+  25525, 26301, 27253, 26585, 25729, 26765, 28009, 26978, 25705, 27285, 29174, 27235, 24823, 28250, 32767, 24376, 
+  0, -24376, -32767, -28250, -24823, -27235, -29174, -27285, -25705, -26978, -28009, -26765, -25729, -26585, -27253, -26301, 
+  -25525, -26165, -26637, -25852, -25230, -25736, -26085, -25409, -24887, -25304, -25569, -24968, -24518, -24870, -25073, -24528, 
+  -24132, -24435, -24591, -24090, -23734, -23999, -24118, -23651, -23329, -23563, -23652, -23213, -22918, -23126, -23191, -22775, 
+  -22503, -22690, -22733, -22338, -22085, -22253, -22279, -21900, -21664, -21816, -21827, -21463, -21241, -21379, -21376, -21025, 
+  -20816, -20942, -20927, -20588, -20390, -20505, -20480, -20151, -19962, -20068, -20033, -19713, -19534, -19631, -19588, -19276, 
+  -19105, -19194, -19143, -18839, -18675, -18757, -18699, -18402, -18245, -18320, -18255, -17964, -17814, -17883, -17812, -17527, 
+  -17382, -17446, -17369, -17090, -16951, -17009, -16927, -16653, -16518, -16572, -16485, -16215, -16086, -16135, -16043, -15778, 
+  -15653, -15697, -15602, -15341, -15220, -15260, -15161, -14904, -14787, -14823, -14720, -14467, -14353, -14386, -14279, -14029, 
+  -13920, -13949, -13838, -13592, -13486, -13512, -13398, -13155, -13052, -13075, -12958, -12718, -12618, -12637, -12518, -12281, 
+  -12183, -12200, -12078, -11844, -11749, -11763, -11638, -11406, -11315, -11326, -11198, -10969, -10880, -10889, -10758, -10532, 
+  -10445, -10452, -10319, -10095, -10011, -10015, -9879, -9658, -9576, -9577, -9440, -9220, -9141, -9140, -9000, -8783, 
+  -8706, -8703, -8561, -8346, -8271, -8266, -8121, -7909, -7836, -7829, -7682, -7472, -7401, -7392, -7243, -7035, 
+  -6966, -6955, -6804, -6597, -6531, -6517, -6365, -6160, -6095, -6080, -5926, -5723, -5660, -5643, -5487, -5286, 
+  -5225, -5206, -5048, -4849, -4790, -4769, -4609, -4412, -4354, -4332, -4170, -3974, -3919, -3894, -3731, -3537, 
+  -3483, -3457, -3292, -3100, -3048, -3020, -2853, -2663, -2613, -2583, -2414, -2226, -2177, -2146, -1975, -1789, 
+  -1742, -1709, -1536, -1351, -1306, -1271, -1097, -914, -871, -834, -658, -477, -435, -397, -219, -40, 
+};
+
+//! \brief Mip level 1 of the sawtooth wave: 64 harmonics
+static const I16 gcai16SawWaveTable1[ 256u ] =
+{
+  0, 81, 441, 794, 867, 955, 1322, 1668, 1735, 1829, 2203, 2542, 2602, 2704, 3084, 3417, 
+  3470, 3578, 3966, 4291, 4337, 4452, 4847, 5165, 5204, 5327, 5729, 6040, 6070, 6201, 6611, 6914, 
+  6937, 7075, 7493, 7788, 7803, 7950, 8376, 8662, 8669, 8824, 9259, 9537, 9534, 9698, 10143, 10411, 
+  10399, 10573, 11027, 11285, 11263, 11447, 11912, 12159, 12126, 12322, 12798, 13033, 12989, 13196, 13684, 13908, 
+  13850, 14071, 14572, 14782, 14710, 14945, 15462, 15656, 15568, 15820, 16353, 16530, 16425, 16695, 17247, 17404, 
+  17278, 17570, 18143, 18277, 18129, 18444, 19043, 19151, 18975, 19320, 19949, 20024, 19815, 20195, 20860, 20897, 
+  20648, 21071, 21781, 21770, 21470, 21948, 22716, 22641, 22274, 22826, 23672, 23511, 23052, 23706, 24662, 24376, 
+  23784, 24593, 25717, 25233, 24422, 25494, 26912, 26063, 24834, 26450, 28515, 26758, 24387, 27853, 32548, 24336, 
+  0, -24336, -32548, -27853, -24387, -26758, -28515, -26450, -24834, -26063, -26912, -25494, -24422, -25233, -25717, -24593, 
+  -23784, -24376, -24662, -23706, -23052, -23511, -23672, -22826, -22274, -22641, -22716, -21948, -21470, -21770, -21781, -21071, 
+  -20648, -20897, -20860, -20195, -19815, -20024, -19949, -19320, -18975, -19151, -19043, -18444, -18129, -18277, -18143, -17570, 
+  -17278, -17404, -17247, -16695, -16425, -16530, -16353, -15820, -15568, -15656, -15462, -14945, -14710, -14782, -14572, -14071, 
+  -13850, -13908, -13684, -13196, -12989, -13033, -12798, -12322, -12126, -12159, -11912, -11447, -11263, -11285, -11027, -10573, 
+  -10399, -10411, -10143, -9698, -9534, -9537, -9259, -8824, -8669, -8662, -8376, -7950, -7803, -7788, -7493, -7075, 
+  -6937, -6914, -6611, -6201, -6070, -6040, -5729, -5327, -5204, -5165, -4847, -4452, -4337, -4291, -3966, -3578, 
+  -3470, -3417, -3084, -2704, -2602, -2542, -2203, -1829, -1735, -1668, -1322, -955, -867, -794, -441, -81, 
+};
+
+//! \brief Mip level 2 of the sawtooth wave: 32 harmonics
+static const I16 gcai16SawWaveTable2[ 128u ] =
+{
+  0, 163, 888, 1585, 1721, 1912, 2664, 3334, 3442, 3661, 4441, 5082, 5162, 5410, 6220, 6831, 
+  6879, 7159, 8000, 8579, 8595, 8908, 9784, 10327, 10306, 10657, 11572, 12075, 12012, 12407, 13367, 13822, 
+  13711, 14157, 15170, 15569, 15399, 15908, 16987, 17315, 17071, 17660, 18824, 19058, 18716, 19415, 20696, 20799, 
+  20314, 21176, 22633, 22530, 21820, 22951, 24709, 24234, 23099, 24782, 27193, 25803, 23520, 27059, 32107, 24255, 
+  0, -24255, -32107, -27059, -23520, -25803, -27193, -24782, -23099, -24234, -24709, -22951, -21820, -22530, -22633, -21176, 
+  -20314, -20799, -20696, -19415, -18716, -19058, -18824, -17660, -17071, -17315, -16987, -15908, -15399, -15569, -15170, -14157, 
+  -13711, -13822, -13367, -12407, -12012, -12075, -11572, -10657, -10306, -10327, -9784, -8908, -8595, -8579, -8000, -7159, 
+  -6879, -6831, -6220, -5410, -5162, -5082, -4441, -3661, -3442, -3334, -2664, -1912, -1721, -1585, -888, -163, 
+};
+
+//! \brief Mip level 3 of the sawtooth wave: 16 harmonics
+static const I16 gcai16SawWaveTable3[ 64u ] =
+{
+  0, 335, 1803, 3162, 3387, 3833, 5414, 6657, 6765, 7334, 9040, 10151, 10121, 10836, 12696, 13640, 
+  13435, 14345, 16413, 17120, 16659, 17869, 20268, 20573, 19657, 21448, 24529, 23891, 21799, 25474, 31219, 24092, 
+  0, -24092, -31219, -25474, -21799, -23891, -24529, -21448, -19657, -20573, -20268, -17869, -16659, -17120, -16413, -14345, 
+  -13435, -13640, -12696, -10836, -10121, -10151, -9040, -7334, -6765, -6657, -5414, -3833, -3387, -3162, -1803, -335, 
+};
+
+//! \brief Mip level 4 of the sawtooth wave: 8 harmonics
+static const I16 gcai16SawWaveTable4[ 64u ] =
+{
+  0, 98, 705, 2002, 3717, 5303, 6284, 6573, 6538, 6772, 7718, 9363, 11228, 12656, 13240, 13111, 
+  12892, 13327, 14791, 16998, 19115, 20252, 20057, 19046, 18412, 19365, 22312, 26350, 29416, 29097, 23757, 13428, 
+  0, -13428, -23757, -29097, -29416, -26350, -22312, -19365, -18412, -19046, -20057, -20252, -19115, -16998, -14791, -13327, 
+  -12892, -13111, -13240, -12656, -11228, -9363, -7718, -6772, -6538, -6573, -6284, -5303, -3717, -2002, -705, -98, 
+};
+
+//! \brief Mip level 5 of the sawtooth wave: 4 harmonics
+static const I16 gcai16SawWaveTable5[ 64u ] =
+{
+  0, 28, 217, 698, 1551, 2786, 4342, 6097, 7887, 9537, 10889, 11835, 12339, 12444, 12273, 12011, 
+  11874, 12078, 12792, 14112, 16028, 18417, 21047, 23598, 25699, 26974, 27095, 25824, 23052, 18822, 13330, 6911, 
+  0, -6911, -13330, -18822, -23052, -25824, -27095, -26974, -25699, -23598, -21047, -18417, -16028, -14112, -12792, -12078, 
+  -11874, -12011, -12273, -12444, -12339, -11835, -10889, -9537, -7887, -6097, -4342, -2786, -1551, -698, -217, -28, 
+};
+
+//! \brief Mip level 6 of the sawtooth wave: 2 harmonics
+static const I16 gcai16SawWaveTable6[ 64u ] =
+{
+  0, 8, 67, 223, 519, 991, 1668, 2565, 3689, 5034, 6582, 8304, 10158, 12097, 14061, 15988, 
+  17812, 19463, 20877, 21992, 22753, 23113, 23038, 22503, 21500, 20034, 18123, 15801, 13114, 10118, 6883, 3483, 
+  0, -3483, -6883, -10118, -13114, -15801, -18123, -20034, -21500, -22503, -23038, -23113, -22753, -21992, -20877, -19463, 
+  -17812, -15988, -14061, -12097, -10158, -8304, -6582, -5034, -3689, -2565, -1668, -991, -519, -223, -67, -8, 
+};
+
+//! \brief Mip level 7 of the sawtooth wave: 1 harmonics
+static const I16 gcai16SawWaveTable7[ 64u ] =
+{
+  0, 1746, 3475, 5170, 6816, 8396, 9896, 11300, 12595, 13769, 14810, 15708, 16456, 17045, 17469, 17726, 
+  17812, 17726, 17469, 17045, 16456, 15708, 14810, 13769, 12595, 11300, 9896, 8396, 6816, 5170, 3475, 1746, 
+  0, -1746, -3475, -5170, -6816, -8396, -9896, -11300, -12595, -13769, -14810, -15708, -16456, -17045, -17469, -17726, 
+  -17812, -17726, -17469, -17045, -16456, -15708, -14810, -13769, -12595, -11300, -9896, -8396, -6816, -5170, -3475, -1746, 
+};
+
+//! \brief Band-limited sawtooth wave, one mip level per octave
+const S_WAVETABLE gcsSawWaveTable =
+{
+  8u,
+  {
+    { gcai16SawWaveTable0, 512u },
+    { gcai16SawWaveTable1, 256u },
+    { gcai16SawWaveTable2, 128u },
+    { gcai16SawWaveTable3, 64u },
+    { gcai16SawWaveTable4, 64u },
+    { gcai16SawWaveTable5, 64u },
+    { gcai16SawWaveTable6, 64u },
+    { gcai16SawWaveTable7, 64u }
+  }
+};
+
+//! \brief Mip level 0 of the square wave: 128 harmonics
+static const I16 gcai16SquareWaveTable0[ 512u ] =
+{
+  0, 22458, 30342, 26351, 23233, 25490, 27440, 25865, 24445, 25656, 26773, 25789, 24868, 25697, 26481, 25764, 
+  25081, 25713, 26318, 25753, 25209, 25720, 26214, 25747, 25295, 25725, 26143, 25744, 25356, 25727, 26090, 25742, 
+  25401, 25729, 26051, 25740, 25436, 25730, 26020, 25739, 25464, 25731, 25995, 25739, 25486, 25732, 25974, 25738, 
+  25505, 25733, 25957, 25738, 25520, 25733, 25943, 25737, 25533, 25733, 25931, 25737, 25545, 25734, 25921, 25737, 
+  25554, 25734, 25912, 25736, 25562, 25734, 25904, 25736, 25570, 25734, 25897, 25736, 25576, 25734, 25892, 25736, 
+  25581, 25734, 25887, 25736, 25586, 25734, 25882, 25736, 25590, 25735, 25878, 25736, 25594, 25735, 25875, 25736, 
+  25597, 25735, 25872, 25736, 25599, 25735, 25870, 25735, 25601, 25735, 25868, 25735, 25603, 25735, 25866, 25735, 
+  25605, 25735, 25865, 25735, 25606, 25735, 25864, 25735, 25607, 25735, 25863, 25735, 25607, 25735, 25863, 25735, 
+  25607, 25735, 25863, 25735, 25607, 25735, 25863, 25735, 25607, 25735, 25864, 25735, 25606, 25735, 25865, 25735, 
+  25605, 25735, 25866, 25735, 25603, 25735, 25868, 25735, 25601, 25735, 25870, 25735, 25599, 25736, 25872, 25735, 
+  25597, 25736, 25875, 25735, 25594, 25736, 25878, 25735, 25590, 25736, 25882, 25734, 25586, 25736, 25887, 25734, 
+  25581, 25736, 25892, 25734, 25576, 25736, 25897, 25734, 25570, 25736, 25904, 25734, 25562, 25736, 25912, 25734, 
+  25554, 25737, 25921, 25734, 25545, 25737, 25931, 25733, 25533, 25737, 25943, 25733, 25520, 25738, 25957, 25733, 
+  25505, 25738, 25974, 25732, 25486, 25739, 25995, 25731, 25464, 25739, 26020, 25730, 25436, 25740, 26051, 25729, 
+  25401, 25742, 26090, 25727, 25356, 25744, 26143, 25725, 25295, 25747, 26214, 25720, 25209, 25753, 26318, 25713, 
+  25081, 25764, 26481, 25697, 24868, 25789, 26773, 25656, 24445, 25865, 27440, 25490, 23233, 26351, 30342, 22458, 
+  0, -22458, -30342, -26351, -23233, -25490, -27440, -25865, -24445, -25656, -26773, -25789, -24868, -25697, -26481, -25764, 
+  -25081, -25713, -26318, -25753, -25209, -25720, -26214, -25747, -25295, -25725, -26143, -25744, -25356, -25727, -26090, -25742, 
+  -25401, -25729, -26051, -25740, -25436, -25730, -26020, -25739, -25464, -25731, -25995, -25739, -25486, -25732, -25974, -25738, 
+  -25505, -25733, -25957, -25738, -25520, -25733, -25943, -25737, -25533, -25733, -25931, -25737, -25545, -25734, -25921, -25737, 
+  -25554, -25734, -25912, -25736, -25562, -25734, -25904, -25736, -25570, -25734, -25897, -25736, -25576, -25734, -25892, -25736, 
+  -25581, -25734, -25887, -25736, -25586, -25734, -25882, -25736, -25590, -25735, -25878, -25736, -25594, -25735, -25875, -25736, 
+  -25597, -25735, -25872, -25736, -25599, -25735, -25870, -25735, -25601, -25735, -25868, -25735, -25603, -25735, -25866, -25735, 
+  -25605, -25735, -25865, -25735, -25606, -25735, -25864, -25735, -25607, -25735, -25863, -25735, -25607, -25735, -25863, -25735, 
+  -25607, -25735, -25863, -25735, -25607, -25735, -25863, -25735, -25607, -25735, -25864, -25735, -25606, -25735, -25865, -25735, 
+  -25605, -25735, -25866, -25735, -25603, -25735, -25868, -25735, -25601, -25735, -25870, -25735, -25599, -25736, -25872, -25735, 
+  -25597, -25736, -25875, -25735, -25594, -25736, -25878, -25735, -25590, -25736, -25882, -25734, -25586, -25736, -25887, -25734, 
+  -25581, -25736, -25892, -25734, -25576, -25736, -25897, -25734, -25570, -25736, -25904, -25734, -25562, -25736, -25912, -25734, 
+  -25554, -25737, -25921, -25734, -25545, -25737, -25931, -25733, -25533, -25737, -25943, -25733, -25520, -25738, -25957, -25733, 
+  -25505, -25738, -25974, -25732, -25486, -25739, -25995, -25731, -25464, -25739, -26020, -25730, -25436, -25740, -26051, -25729, 
+  -25401, -25742, -26090, -25727, -25356, -25744, -26143, -25725, -25295, -25747, -26214, -25720, -25209, -25753, -26318, -25713, 
+  -25081, -25764, -26481, -25697, -24868, -25789, -26773, -25656, -24445, -25865, -27440, -25490, -23233, -26351, -30342, -22458, 
+};
+
+//! \brief Mip level 1 of the square wave: 64 harmonics
+static const I16 gcai16SquareWaveTable1[ 256u ] =
+{
+  0, 22459, 30343, 26350, 23230, 25491, 27445, 25864, 24438, 25656, 26781, 25788, 24858, 25697, 26492, 25764, 
+  25068, 25713, 26332, 25753, 25193, 25721, 26232, 25747, 25275, 25725, 26164, 25743, 25332, 25728, 26116, 25741, 
+  25373, 25730, 26080, 25740, 25404, 25731, 26054, 25739, 25427, 25732, 26033, 25738, 25445, 25733, 26018, 25737, 
+  25458, 25733, 26007, 25737, 25468, 25734, 25999, 25736, 25474, 25734, 25994, 25736, 25478, 25735, 25991, 25735, 
+  25479, 25735, 25991, 25735, 25478, 25736, 25994, 25734, 25474, 25736, 25999, 25734, 25468, 25737, 26007, 25733, 
+  25458, 25737, 26018, 25733, 25445, 25738, 26033, 25732, 25427, 25739, 26054, 25731, 25404, 25740, 26080, 25730, 
+  25373, 25741, 26116, 25728, 25332, 25743, 26164, 25725, 25275, 25747, 26232, 25721, 25193, 25753, 26332, 25713, 
+  25068, 25764, 26492, 25697, 24858, 25788, 26781, 25656, 24438, 25864, 27445, 25491, 23230, 26350, 30343, 22459, 
+  0, -22459, -30343, -26350, -23230, -25491, -27445, -25864, -24438, -25656, -26781, -25788, -24858, -25697, -26492, -25764, 
+  -25068, -25713, -26332, -25753, -25193, -25721, -26232, -25747, -25275, -25725, -26164, -25743, -25332, -25728, -26116, -25741, 
+  -25373, -25730, -26080, -25740, -25404, -25731, -26054, -25739, -25427, -25732, -26033, -25738, -25445, -25733, -26018, -25737, 
+  -25458, -25733, -26007, -25737, -25468, -25734, -25999, -25736, -25474, -25734, -25994, -25736, -25478, -25735, -25991, -25735, 
+  -25479, -25735, -25991, -25735, -25478, -25736, -25994, -25734, -25474, -25736, -25999, -25734, -25468, -25737, -26007, -25733, 
+  -25458, -25737, -26018, -25733, -25445, -25738, -26033, -25732, -25427, -25739, -26054, -25731, -25404, -25740, -26080, -25730, 
+  -25373, -25741, -26116, -25728, -25332, -25743, -26164, -25725, -25275, -25747, -26232, -25721, -25193, -25753, -26332, -25713, 
+  -25068, -25764, -26492, -25697, -24858, -25788, -26781, -25656, -24438, -25864, -27445, -25491, -23230, -26350, -30343, -22459, 
+};
+
+//! \brief Mip level 2 of the square wave: 32 harmonics
+static const I16 gcai16SquareWaveTable2[ 128u ] =
+{
+  0, 22461, 30350, 26348, 23217, 25493, 27464, 25862, 24413, 25658, 26813, 25786, 24818, 25699, 26539, 25761, 
+  25013, 25716, 26396, 25750, 25121, 25724, 26315, 25743, 25182, 25729, 26270, 25739, 25214, 25733, 26249, 25736, 
+  25224, 25736, 26249, 25733, 25214, 25739, 26270, 25729, 25182, 25743, 26315, 25724, 25121, 25750, 26396, 25716, 
+  25013, 25761, 26539, 25699, 24818, 25786, 26813, 25658, 24413, 25862, 27464, 25493, 23217, 26348, 30350, 22461, 
+  0, -22461, -30350, -26348, -23217, -25493, -27464, -25862, -24413, -25658, -26813, -25786, -24818, -25699, -26539, -25761, 
+  -25013, -25716, -26396, -25750, -25121, -25724, -26315, -25743, -25182, -25729, -26270, -25739, -25214, -25733, -26249, -25736, 
+  -25224, -25736, -26249, -25733, -25214, -25739, -26270, -25729, -25182, -25743, -26315, -25724, -25121, -25750, -26396, -25716, 
+  -25013, -25761, -26539, -25699, -24818, -25786, -26813, -25658, -24413, -25862, -27464, -25493, -23217, -26348, -30350, -22461, 
+};
+
+//! \brief Mip level 3 of the square wave: 16 harmonics
+static const I16 gcai16SquareWaveTable3[ 64u ] =
+{
+  0, 22469, 30375, 26340, 23166, 25502, 27543, 25852, 24303, 25669, 26958, 25773, 24632, 25715, 26775, 25741, 
+  24715, 25741, 26775, 25715, 24632, 25773, 26958, 25669, 24303, 25852, 27543, 25502, 23166, 26340, 30375, 22469, 
+  0, -22469, -30375, -26340, -23166, -25502, -27543, -25852, -24303, -25669, -26958, -25773, -24632, -25715, -26775, -25741, 
+  -24715, -25741, -26775, -25715, -24632, -25773, -26958, -25669, -24303, -25852, -27543, -25502, -23166, -26340, -30375, -22469, 
+};
 
+//! \brief Mip level 4 of the square wave: 8 harmonics
+static const I16 gcai16SquareWaveTable4[ 64u ] =
+{
+  0, 12441, 22501, 28605, 30476, 29115, 26303, 23859, 22949, 23748, 25549, 27241, 27910, 27276, 25783, 24318, 
+  23717, 24318, 25783, 27276, 27910, 27241, 25549, 23748, 22949, 23859, 26303, 29115, 30476, 28605, 22501, 12441, 
+  0, -12441, -22501, -28605, -30476, -29115, -26303, -23859, -22949, -23748, -25549, -27241, -27910, -27276, -25783, -24318, 
+  -23717, -24318, -25783, -27276, -27910, -27241, -25549, -23748, -22949, -23859, -26303, -29115, -30476, -28605, -22501, -12441, 
+};
+
+//! \brief Mip level 5 of the square wave: 4 harmonics
+static const I16 gcai16SquareWaveTable5[ 64u ] =
+{
+  0, 6382, 12461, 17955, 22630, 26316, 28917, 30420, 30893, 30478, 29376, 27827, 26093, 24427, 23056, 22157, 
+  21845, 22157, 23056, 24427, 26093, 27827, 29376, 30478, 30893, 30420, 28917, 26316, 22630, 17955, 12461, 6382, 
+  0, -6382, -12461, -17955, -22630, -26316, -28917, -30420, -30893, -30478, -29376, -27827, -26093, -24427, -23056, -22157, 
+  -21845, -22157, -23056, -24427, -26093, -27827, -29376, -30478, -30893, -30420, -28917, -26316, -22630, -17955, -12461, -6382, 
+};
+
+//! \brief Mip level 6 of the square wave: 2 harmonics
+static const I16 gcai16SquareWaveTable6[ 64u ] =
+{
+  0, 3212, 6393, 9512, 12539, 15446, 18204, 20787, 23170, 25329, 27245, 28898, 30273, 31356, 32137, 32609, 
+  32767, 32609, 32137, 31356, 30273, 28898, 27245, 25329, 23170, 20787, 18204, 15446, 12539, 9512, 6393, 3212, 
+  0, -3212, -6393, -9512, -12539, -15446, -18204, -20787, -23170, -25329, -27245, -28898, -30273, -31356, -32137, -32609, 
+  -32767, -32609, -32137, -31356, -30273, -28898, -27245, -25329, -23170, -20787, -18204, -15446, -12539, -9512, -6393, -3212, 
+};
+
+//! \brief Mip level 7 of the square wave: 1 harmonics
+static const I16 gcai16SquareWaveTable7[ 64u ] =
+{
+  0, 3212, 6393, 9512, 12539, 15446, 18204, 20787, 23170, 25329, 27245, 28898, 30273, 31356, 32137, 32609, 
+  32767, 32609, 32137, 31356, 30273, 28898, 27245, 25329, 23170, 20787, 18204, 15446, 12539, 9512, 6393, 3212, 
+  0, -3212, -6393, -9512, -12539, -15446, -18204, -20787, -23170, -25329, -27245, -28898, -30273, -31356, -32137, -32609, 
+  -32767, -32609, -32137, -31356, -30273, -28898, -27245, -25329, -23170, -20787, -18204, -15446, -12539, -9512, -6393, -3212, 
+};
+
+//! \brief Band-limited square wave, one mip level per octave
+const S_WAVETABLE gcsSquareWaveTable =
+{
+  8u,
+  {
+    { gcai16SquareWaveTable0, 512u },
+    { gcai16SquareWaveTable1, 256u },
+    { gcai16SquareWaveTable2, 128u },
+    { gcai16SquareWaveTable3, 64u },
+    { gcai16SquareWaveTable4, 64u },
+    { gcai16SquareWaveTable5, 64u },
+    { gcai16SquareWaveTable6, 64u },
+    { gcai16SquareWaveTable7, 64u }
+  }
+};
 
 
 //-----------------------------------------------< EOF >--------------------------------------------------/
@@ -22,12 +22,37 @@
 //--------------------------------------------------------------------------------------------------------/
 // Definitions
 //--------------------------------------------------------------------------------------------------------/
+#define WAVETABLE_MAX_LEVELS  (8u)  //!< Maximum number of mip levels in a wave table
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Types
+//--------------------------------------------------------------------------------------------------------/
+//! \brief One mip level of a wave table
+typedef struct
+{
+  I16 const*  pi16Samples;  //!< One period of the waveform
+  U16         u16Size;      //!< Size in words, must be a power of two
+} S_WAVETABLE_LEVEL;
+
+//! \brief Band-limited wave table
+//! \note  Level N is played when the phase increase is at least 2^N*65536,
+//!        so it may only contain harmonics that stay below the Nyquist
+//!        frequency up to a phase increase of 2^(N+1)*65536.
+typedef struct
+{
+  U8                 u8Levels;                             //!< Number of valid levels
+  S_WAVETABLE_LEVEL  asLevels[ WAVETABLE_MAX_LEVELS ];     //!< Levels from the lowest octave up
+} S_WAVETABLE;
 
 
 //--------------------------------------------------------------------------------------------------------/
 // Extern values
 //--------------------------------------------------------------------------------------------------------/
 extern const I16 gcai16SineWaveTable[ 512u ];
+extern const S_WAVETABLE gcsSineWaveTable;
+extern const S_WAVETABLE gcsSawWaveTable;
+extern const S_WAVETABLE gcsSquareWaveTable;
 
 
 #endif  // SOUND_WAVETABLES_H
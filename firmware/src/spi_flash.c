@@ -24,6 +24,7 @@
 //--------------------------------------------------------------------------------------------------------/
 // Definitions
 //--------------------------------------------------------------------------------------------------------/
+#define SPI_FLASH_GUARDED_CHUNK  (256u)  //!< Bytes read at once while the USB interrupt is masked
 
 
 //--------------------------------------------------------------------------------------------------------/
@@ -393,6 +394,36 @@ void SPIFlash_Read_Polling( U32 u32StartAddress, U8* pu8Buffer, U32 u32Length )
   HAL_GPIO_WritePin( FLASH_nCS_GPIO_Port, FLASH_nCS_Pin, GPIO_PIN_SET );
 }
 
+ /*! *******************************************************************
+ * \brief  Read data from SPI flash in the main loop
+ * \param  u32StartAddress: address to start reading from
+ * \param  pu8Buffer: buffer to read to
+ * \param  u32Length: buffer size
+ * \return -
+ * \note   The USB mass storage callbacks access the flash in the OTG_FS
+ *         interrupt, which must not cut a transfer in two: it is masked
+ *         while a chunk is read, so it waits at most one chunk.
+ *********************************************************************/
+void SPIFlash_ReadGuarded_Polling( U32 u32StartAddress, U8* pu8Buffer, U32 u32Length )
+{
+  U32 u32Chunk;
+  BOOL bEnabled = ( 0u != NVIC_GetEnableIRQ( OTG_FS_IRQn ) ) ? TRUE : FALSE;  // USB may not be initialized yet
+
+  while( u32Length > 0u )
+  {
+    u32Chunk = ( u32Length < SPI_FLASH_GUARDED_CHUNK ) ? u32Length : SPI_FLASH_GUARDED_CHUNK;
+    NVIC_DisableIRQ( OTG_FS_IRQn );
+    SPIFlash_Read_Polling( u32StartAddress, pu8Buffer, u32Chunk );
+    if( TRUE == bEnabled )
+    {
+      NVIC_EnableIRQ( OTG_FS_IRQn );
+    }
+    u32StartAddress += u32Chunk;
+    pu8Buffer += u32Chunk;
+    u32Length -= u32Chunk;
+  }
+}
+
  /*! *******************************************************************
  * \brief
  * \param
@@ -41,6 +41,7 @@ void SPIFlash_Write_Polling( U32 u32StartAddress, U8* pu8Buffer, U32 u32Length )
 void SPIFlash_ChipErase_Polling( void );
 void SPIFlash_EraseSector_Polling( U32 u32SectorAddress );
 void SPIFlash_Read_Polling( U32 u32StartAddress, U8* pu8Buffer, U32 u32Length );
+void SPIFlash_ReadGuarded_Polling( U32 u32StartAddress, U8* pu8Buffer, U32 u32Length );
 
 
 #endif  // SPI_FLASH_H
@@ -14,13 +14,14 @@
 //--------------------------------------------------------------------------------------------------------/
 // Include files
 //--------------------------------------------------------------------------------------------------------/
-#include <stdio.h>  // for snprintf
 #include <string.h>  // for memset, etc.
 #include "main.h"
 #include "types.h"
 #include "buttons.h"
 #include "lcd_driver.h"
 #include "display.h"
+#include "sound.h"
+#include "music.h"
 
 // Own include
 #include "system.h"
@@ -31,7 +32,9 @@
 //--------------------------------------------------------------------------------------------------------/
 #define MENUITEM_Y_OFFSET  (14u)  //!< Y offset of the first menu item on screen
 #define MENUITEM_X_OFFSET  (10u)  //!< X offset of the first menu item on screen
-#define MENU_ITEMS          (4u)  //!< Number of menu items in the main menu
+#define MENU_ITEMS          (6u)  //!< Number of menu items in the main menu
+#define MENU_VISIBLE_ITEMS  (4u)  //!< Number of menu items that fit on the screen below the header
+#define AUDIO_VALUE_X      (40u)  //!< X offset of the values on the audio statistics page
 
 
 //--------------------------------------------------------------------------------------------------------/
@@ -45,6 +48,37 @@
 //! \brief Runtime global variables
 volatile S_RUNTIMEGLOBALS gsRuntimeGlobals;
 
+//! \brief Cached glyphs of the bar plot range values
+static S_DISPLAY_NUMBER gsBarMinNumber;
+static S_DISPLAY_NUMBER gsBarMaxNumber;
+
+//! \brief Names of the main menu items
+static U8* const gcapu8MenuItems[ MENU_ITEMS ] =
+{
+  "Backlight",
+  "Volume",
+  "Contrast",
+  "Audio",
+  "Music",
+  "Turn off"
+};
+
+//! \brief Names of the songs, by the index of Music_Select()
+static U8* const gcapu8SongNames[ MUSIC_SONGS ] =
+{
+  "Tetris",
+  "Track 1",
+  "Track 2",
+  "Track 3",
+  "Track 4"
+};
+
+//! \brief Cached glyphs of the audio statistics values
+static S_DISPLAY_NUMBER gsAudioLoadNumber;
+static S_DISPLAY_NUMBER gsAudioPeakNumber;
+static S_DISPLAY_NUMBER gsAudioLateNumber;
+static S_DISPLAY_NUMBER gsAudioUnderrunNumber;
+
 
 //--------------------------------------------------------------------------------------------------------/
 // Static function declarations
@@ -66,13 +100,10 @@ static void BarPlot( U8 u8Y, U8 u8RangeMin, U8 u8RangeMax, U8 u8Value )
 {
   U8 u8Index;
   U8 u8Bars;
-  U8 au8String[ 4u ];
   
   // Minimum and maximum values
-  snprintf( (char*)au8String, sizeof( au8String ), "%u", u8RangeMin );
-  Display_PrintString( au8String, 0u, u8Y, TRUE );
-  snprintf( (char*)au8String, sizeof( au8String ), "%u", u8RangeMax );
-  Display_PrintString( au8String, 85u-(3u*8u), u8Y, TRUE );
+  Display_PrintNumber( &gsBarMinNumber, u8RangeMin, 0u, u8Y );
+  Display_PrintNumber( &gsBarMaxNumber, u8RangeMax, 85u-(3u*8u), u8Y );
   // Box
   Display_DrawLine( 3u*8u,       u8Y,    83u-(3u*8u), u8Y,    TRUE );
   Display_DrawLine( 3u*8u,       u8Y+7u, 83u-(3u*8u), u8Y+7u, TRUE );
@@ -87,10 +118,32 @@ static void BarPlot( U8 u8Y, U8 u8RangeMin, U8 u8RangeMax, U8 u8Value )
 }
 
  /*! *******************************************************************
- * \brief
- * \param
- * \return
+ * \brief  Draw the audio render time statistics on the screen
+ * \param  -
+ * \return -
+ * \note   The loads are in percent of the play time of a sound buffer half;
+ *         lost blocks are underruns. The cycle counts can be watched in
+ *         gsSoundStats with the debugger.
  *********************************************************************/
+static void AudioStats( void )
+{
+  S_SOUND_STATS sStats;
+  
+  Sound_GetStats( &sStats );
+  
+  Display_PrintString( "Load", 0u, MENUITEM_Y_OFFSET,       TRUE );
+  Display_PrintNumber( &gsAudioLoadNumber, Sound_GetLoadPercent( &sStats, Sound_GetAverageCycles( &sStats ) ),
+                       AUDIO_VALUE_X, MENUITEM_Y_OFFSET );
+  Display_PrintChar( '%', 76u, MENUITEM_Y_OFFSET, TRUE );
+  Display_PrintString( "Peak", 0u, MENUITEM_Y_OFFSET + 8u,  TRUE );
+  Display_PrintNumber( &gsAudioPeakNumber, Sound_GetLoadPercent( &sStats, sStats.u32MaxCycles ),
+                       AUDIO_VALUE_X, MENUITEM_Y_OFFSET + 8u );
+  Display_PrintChar( '%', 76u, MENUITEM_Y_OFFSET + 8u, TRUE );
+  Display_PrintString( "Late", 0u, MENUITEM_Y_OFFSET + 16u, TRUE );
+  Display_PrintNumber( &gsAudioLateNumber, sStats.u32LateBlocks, AUDIO_VALUE_X, MENUITEM_Y_OFFSET + 16u );
+  Display_PrintString( "Lost", 0u, MENUITEM_Y_OFFSET + 24u, TRUE );  // underruns
+  Display_PrintNumber( &gsAudioUnderrunNumber, sStats.u32Underruns, AUDIO_VALUE_X, MENUITEM_Y_OFFSET + 24u );
+}
 
 
 //--------------------------------------------------------------------------------------------------------/
@@ -110,6 +163,13 @@ void System_Init( void )
   gsRuntimeGlobals.bBackLightActive = FALSE;
   gsRuntimeGlobals.u8LCDContrast = 0x42u;
   gsRuntimeGlobals.u8Volume = 0xFFu;  // full volume
+  
+  Display_InitNumber( &gsBarMinNumber );
+  Display_InitNumber( &gsBarMaxNumber );
+  Display_InitNumber( &gsAudioLoadNumber );
+  Display_InitNumber( &gsAudioPeakNumber );
+  Display_InitNumber( &gsAudioLateNumber );
+  Display_InitNumber( &gsAudioUnderrunNumber );
 }
 
  /*! *******************************************************************
@@ -121,7 +181,11 @@ BOOL System_Cycle( void )
 {
   BOOL bReturn = TRUE;
   static U8 u8MenuItem = 0u;
+  static U8 u8FirstItem = 0u;  // first menu item on the screen
+  U8 u8Index;
   static BOOL bSelected = FALSE;
+  static U8 u8Song = 0u;  // song shown on the music page
+  static E_TRACKER_LOAD_RESULT eSongResult = TRACKER_LOAD_OK;
   
   // Check menu button
   if( BUTTON_PRESSED == Buttons_GetEvent( BUTTON_MENU ) )
@@ -129,6 +193,7 @@ BOOL System_Cycle( void )
     // Open/close system menu
     gsRuntimeGlobals.bMenuActive = ( FALSE == gsRuntimeGlobals.bMenuActive ) ? TRUE : FALSE;
     u8MenuItem = 0u;
+    u8FirstItem = 0u;
     bSelected = FALSE;
   }
   
@@ -147,14 +212,24 @@ BOOL System_Cycle( void )
       Display_DrawLine( 0, 12, 6*8+2, 12, TRUE );
       Display_DrawLine( 6*8+2, 0, 6*8+2, 12, TRUE );
 
+      // Scroll the menu so that the selected item is on the screen
+      if( u8MenuItem < u8FirstItem )
+      {
+        u8FirstItem = u8MenuItem;
+      }
+      if( u8MenuItem >= ( u8FirstItem + MENU_VISIBLE_ITEMS ) )
+      {
+        u8FirstItem = u8MenuItem - MENU_VISIBLE_ITEMS + 1u;
+      }
+      
       // Print menu items
-      Display_PrintString( "Backlight", MENUITEM_X_OFFSET, MENUITEM_Y_OFFSET,       TRUE );
-      Display_PrintString( "Volume",    MENUITEM_X_OFFSET, MENUITEM_Y_OFFSET + 8u,  TRUE );
-      Display_PrintString( "Contrast",  MENUITEM_X_OFFSET, MENUITEM_Y_OFFSET + 16u, TRUE );
-      Display_PrintString( "Turn off",  MENUITEM_X_OFFSET, MENUITEM_Y_OFFSET + 24u, TRUE );
+      for( u8Index = 0u; u8Index < MENU_VISIBLE_ITEMS; u8Index++ )
+      {
+        Display_PrintString( gcapu8MenuItems[ u8FirstItem + u8Index ], MENUITEM_X_OFFSET, MENUITEM_Y_OFFSET + 8u*u8Index, TRUE );
+      }
       
       // Print arrow
-      Display_PrintChar( 175u, 0u, MENUITEM_Y_OFFSET + 8u*u8MenuItem, TRUE );
+      Display_PrintChar( 175u, 0u, MENUITEM_Y_OFFSET + 8u*( u8MenuItem - u8FirstItem ), TRUE );
       
       // Check up and down buttons and increase/decrease the menu item variable
       if( BUTTON_PRESSED == Buttons_GetEvent( BUTTON_UP ) )
@@ -263,7 +338,67 @@ BOOL System_Cycle( void )
           bSelected = FALSE;
         }
       }
-      else if( 3u == u8MenuItem )  // Turn off
+      else if( 3u == u8MenuItem )  // Audio statistics
+      {
+        // Display header
+        Display_PrintString( "Audio", 2, 2, TRUE );
+        Display_DrawLine( 0, 0, 5*8+2, 0, TRUE );
+        Display_DrawLine( 0, 0, 0, 12, TRUE );
+        Display_DrawLine( 0, 12, 5*8+2, 12, TRUE );
+        Display_DrawLine( 5*8+2, 0, 5*8+2, 12, TRUE );
+        // Show the render time statistics
+        AudioStats();
+        // Restart the statistics by pressing left
+        if( BUTTON_PRESSED == Buttons_GetEvent( BUTTON_LEFT ) )
+        {
+          Sound_ResetStats();
+        }
+        // Exit by pressing either one of the fire buttons
+        if( ( BUTTON_PRESSED == Buttons_GetEvent( BUTTON_FIRE_A ) )
+         || ( BUTTON_PRESSED == Buttons_GetEvent( BUTTON_FIRE_B ) ) )
+        {
+          bSelected = FALSE;
+        }
+      }
+      else if( 4u == u8MenuItem )  // Music
+      {
+        // Display header
+        Display_PrintString( "Music", 2, 2, TRUE );
+        Display_DrawLine( 0, 0, 5*8+2, 0, TRUE );
+        Display_DrawLine( 0, 0, 0, 12, TRUE );
+        Display_DrawLine( 0, 12, 5*8+2, 12, TRUE );
+        Display_DrawLine( 5*8+2, 0, 5*8+2, 12, TRUE );
+        // Show the song to be chosen, and whether it could be loaded
+        Display_PrintChar( '<', 0u, 25u, TRUE );
+        Display_PrintString( gcapu8SongNames[ u8Song ], MENUITEM_X_OFFSET, 25u, TRUE );
+        Display_PrintChar( '>', 76u, 25u, TRUE );
+        if( Music_GetSong() == u8Song )
+        {
+          Display_PrintString( "Playing", MENUITEM_X_OFFSET, 35u, TRUE );
+        }
+        else if( TRACKER_LOAD_OK != eSongResult )
+        {
+          Display_PrintString( "No song", MENUITEM_X_OFFSET, 35u, TRUE );
+        }
+        // Step through the songs, each one is played right away
+        if( BUTTON_PRESSED == Buttons_GetEvent( BUTTON_LEFT ) )
+        {
+          u8Song = ( u8Song > 0u ) ? ( u8Song - 1u ) : ( MUSIC_SONGS - 1u );
+          eSongResult = Music_Select( u8Song );
+        }
+        if( BUTTON_PRESSED == Buttons_GetEvent( BUTTON_RIGHT ) )
+        {
+          u8Song = ( u8Song < ( MUSIC_SONGS - 1u ) ) ? ( u8Song + 1u ) : 0u;
+          eSongResult = Music_Select( u8Song );
+        }
+        // Exit by pressing either one of the fire buttons
+        if( ( BUTTON_PRESSED == Buttons_GetEvent( BUTTON_FIRE_A ) )
+         || ( BUTTON_PRESSED == Buttons_GetEvent( BUTTON_FIRE_B ) ) )
+        {
+          bSelected = FALSE;
+        }
+      }
+      else if( 5u == u8MenuItem )  // Turn off
       {
         Display_PrintString( "Bye!", 0u, 0u, TRUE );
         // Turn power off
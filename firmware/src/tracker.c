@@ -14,6 +14,8 @@
 //--------------------------------------------------------------------------------------------------------/
 // Include files
 //--------------------------------------------------------------------------------------------------------/
+#include <stddef.h>
+#include <string.h>
 #include "types.h"
 #include "sound_synth.h"
 
@@ -28,30 +30,195 @@
   #define NUMBEROF_INSTRUMENTS  (1u)  //!< This symbol is normally defined by the linker
 #endif  // NUMBEROF_INSTRUMENTS
 
+#define TRACKER_MAX_INSTRUCTIONS  (256u)  //!< Maximum number of instructions executed without waiting
+
+#if defined( __ICCARM__ )
+  #pragma section = "TRACKER_MODULE"
+  #define TRACKER_LINKED_MODULE_SIZE  ( (U32)__section_size( "TRACKER_MODULE" ) )  //!< The linker puts the module in its own section
+#else
+  #define TRACKER_LINKED_MODULE_SIZE  gu32TrackerModuleSize  //!< Host programs give the size of the module
+#endif
+#define TRACKER_SEEK_NONE       (0xFFFFu)  //!< Seek request to the beginning of the song
+
+#define TRACKER_STREAM_MASK          ( TRACKER_STREAM_BLOCKS - 1u )  //!< Index mask of the block ring
+#define TRACKER_STREAM_EPOCH_SHIFT   (24u)                           //!< The epoch of the loaded blocks is in the highest byte of their count
+#define TRACKER_STREAM_COUNT_MASK    (0x00FFFFFFu)                   //!< The number of loaded blocks is in the lower bytes
+#define TRACKER_INSTRUCTION_MAX_SIZE ( 1u + TRACKER_VARINT_MAX_BYTES )  //!< Longest compact instruction
+#define TRACKER_MS_TO_SAMPLES( u32Ms )  ( (U32)(u32Ms)*SAMPLE_RATE/1000u )  //!< Envelope times of the module instruments
+
+#if ( 0u != ( TRACKER_STREAM_BLOCKS & TRACKER_STREAM_MASK ) )
+  #error "The number of stream blocks must be a power of two"
+#endif
+#if ( 0u != ( TRACKER_STREAM_TABLES_SIZE & 3u ) )
+  #error "The stream tables must be a multiple of 4 bytes, so both buffers stay word aligned"
+#endif
+
 
 //--------------------------------------------------------------------------------------------------------/
 // Types
 //--------------------------------------------------------------------------------------------------------/
+//! \brief A validated module
+typedef struct
+{
+  U8 const* pu8Data;          //!< The module, NULL if there is none
+  U32       u32Size;          //!< Size of the module in bytes
+  U32       u32CodeStart;     //!< Offset of the first instruction
+  BOOL      bCompact;         //!< The module is in the compact format (version 2)
+  U8        u8NumberOfNotes;  //!< Number of entries in the note table
+  U16       u16SeekEntries;   //!< Number of entries in the seek table, 0 if the module has none
+  U32       u32SeekTable;     //!< Offset of the first entry of the seek table
+  U32       u32CodeEnd;       //!< Offset after the END of the song
+  U32       u32Resident;      //!< The first bytes of the module are in pu8Data, the rest is streamed
+  pTrackerReadFunction pfRead;  //!< Reads the streamed part of the module, NULL if all of it is in pu8Data
+  U32       u32Address;       //!< Address of the streamed module for pfRead
+  U8        u8NumberOfInstruments;  //!< Number of instruments defined by the module
+  U32       u32Instruments;   //!< Offset of the first S_TRACKER_INSTRUMENT
+  S_SYNTH_PATCH* psPatches;   //!< The instruments converted for the synthesizer
+  U8        u8NumberOfPatterns;  //!< Number of entries in the pattern table
+  U32       u32Patterns;      //!< Offset of the first entry of the pattern table
+} S_TRACKER_MODULE;
+
+//! \brief A pattern being played
+typedef struct
+{
+  U32 u32Return;   //!< Offset of the instruction after the CALL
+  U32 u32Pattern;  //!< Offset of the first instruction of the pattern
+  U8  u8Repeats;   //!< The pattern is played this many times more
+} S_TRACKER_CALL;
 
+//! \brief Where the byte code of a streamed module is read from
+typedef struct
+{
+  pTrackerReadFunction pfRead;  //!< Reads the module, NULL if nothing is streamed
+  U32 u32Address;               //!< Address of the module for pfRead
+  U32 u32Offset;                //!< Offset of the next byte to be read
+  U32 u32LoopStart;             //!< The byte code is read in a loop, like it is played: offset of the first instruction,
+  U32 u32LoopEnd;               //!< and the offset after END
+} S_TRACKER_STREAM;
 
 //--------------------------------------------------------------------------------------------------------/
 // Global variables
 //--------------------------------------------------------------------------------------------------------/
 //! \brief The tracker module, that must be linked to this project externally!
 extern U8 gau8TrackerModule[];
-S_MODULE_HEADER* const gpsTrackerModule = (S_MODULE_HEADER*)gau8TrackerModule;         //!< Pointer to the beginning of the music module
+#if !defined( __ICCARM__ )
+extern U32 gu32TrackerModuleSize;
+#endif
+
+//! \brief The module being played
+static S_TRACKER_MODULE gsModule;
+
+//! \brief Module loaded from the main loop, taken over at the next audio block
+static S_TRACKER_MODULE gsLoadedModule;
+
+//! \brief Offset of the next instruction in the module
+static U32 gu32CodePosition;
+
+//! \brief Patterns being played, the innermost is the last
+static S_TRACKER_CALL gasCallStack[ TRACKER_CALL_DEPTH ];
+static U8 gu8CallDepth;
+
+//! \brief Frames until the next instruction
+static U32 gu32WaitFrames;
+
+//! \brief Remainder of the ms to frames conversion (1/( 1000*gu32Tempo ) frames)
+static U32 gu32WaitRemainder;
+
+//! \brief Tempo multiplier the waits are scaled with (Q16)
+static U32 gu32Tempo;
+
+//! \brief Tempo set from the main loop, taken over at the next audio block
+static volatile U32 gu32TempoRequest;
+
+//! \brief Song position at the end of the current wait (ms of the module)
+static U32 gu32SongMs;
+
+//! \brief Song position at the last audio block, for the main loop (ms of the module)
+static volatile U32 gu32PositionMs;
+
+//! \brief The song is being played
+static BOOL gbPlaying;
+
+//! \brief Requests from the main loop, handled in the audio render context
+static volatile BOOL gbStartRequest;
+static volatile BOOL gbStopRequest;
+static volatile BOOL gbSeekRequest;
+static volatile BOOL gbLoadRequest;
+
+//! \brief Seek table entry to be started from, or TRACKER_SEEK_NONE
+static volatile U16 gu16SeekEntry;
+
+//! \brief Note played on each channel
+static SYNTH_NOTE gahChannelNotes[ TRACKER_NUMBER_OF_CHANNELS ];
+
+//! \brief Instrument slot of each channel
+static U8 gau8ChannelInstruments[ TRACKER_NUMBER_OF_CHANNELS ];
+
+//! \brief Pitch bend of each channel (1/SYNTH_PITCH_SEMITONE semitones)
+static I16 gai16ChannelBends[ TRACKER_NUMBER_OF_CHANNELS ];
+
+//! \brief Vibrato of each channel, as in the operand of TRACKER_OPCODE_VIBRATO
+static U32 gau32ChannelVibratos[ TRACKER_NUMBER_OF_CHANNELS ];
+
+//! \brief Instruments of the modules: one set for the module played, one for the module loaded
+static S_SYNTH_PATCH gaasPatches[ 2u ][ SOUNDSYNTH_MODULE_INSTRUMENTS ];
+
+//! \brief Resident part of streamed modules: one for the module played, one for the module loaded
+//! \note  Word aligned, the wavetables of the instruments are read from it as I16
+ALIGNED_WORD static U8 gau8StreamTables[ 2u ][ TRACKER_STREAM_TABLES_SIZE ];
 
-//! \brief Timestamp of next instruction execution
-U32 gu32NextTimeCallMs;
+//! \brief Ring of the byte code read ahead: single producer (main loop), single consumer (renderer)
+static U8 gau8StreamBlocks[ TRACKER_STREAM_BLOCKS ][ TRACKER_STREAM_BLOCK_SIZE ];
 
-//! \brief Index of the next instruction in the track
-U32 gu32NextInstructionIdx;
+//! \brief Stream restarted by the render context, taken over by the main loop at the next epoch
+static S_TRACKER_STREAM gsStreamRequest;
+
+//! \brief Stream being read by the main loop
+static S_TRACKER_STREAM gsStream;
+
+static volatile U8  gu8StreamEpoch;       //!< Incremented at every restart of the stream, written by the consumer only
+static volatile U32 gu32StreamLoaded;     //!< Epoch and number of the blocks loaded, written by the producer only
+static volatile U32 gu32StreamReleased;   //!< Blocks below this index are free, written by the consumer only
+static U32 gu32StreamRead;                //!< Bytes of the stream decoded
+static volatile BOOL gbStreamInvalid;     //!< The flash of the streamed module was written since it was loaded
+
+//! \brief Number of times the stream was not read ahead enough, can be watched with the debugger
+static U32 gu32StreamStalls;
+
+//! \brief Block of a streamed module read by the validator, and its offset
+static U8  gau8CheckBlock[ TRACKER_STREAM_BLOCK_SIZE ];
+static U32 gu32CheckBlockOffset;
+
+//! \brief Length (ms) and call depth of the patterns checked by the validator
+static U32 gau32CheckPatternMs[ TRACKER_MAX_PATTERNS ];
+static U8  gau8CheckPatternDepths[ TRACKER_MAX_PATTERNS ];
 
 
 //--------------------------------------------------------------------------------------------------------/
 // Static function declarations
 //--------------------------------------------------------------------------------------------------------/
 static void ExecuteOpCode( U8 u8Channel, E_TRACKER_OPCODE eOpCode, U32 u32Operand );
+static U16 ReadU16( U8 const* pu8Data );
+static U32 ReadU32( U8 const* pu8Data );
+static U8  ReadCodeByte( void );
+static U32 ReadVarInt( void );
+static void FetchInstruction( U8* pu8Channel, E_TRACKER_OPCODE* peOpCode, U32* pu32Operand );
+static void ReleaseChannels( void );
+static void ResetChannels( void );
+static void SetInstruments( void );
+static void RestoreSnapshot( U16 u16Entry );
+static void UpdateTempo( void );
+static void RestartCode( U32 u32Offset );
+static BOOL IsCodeLoaded( void );
+static U8  CheckByte( S_TRACKER_MODULE const* psModule, U32 u32Offset );
+static BOOL CheckInstruction( S_TRACKER_MODULE const* psModule, U32* pu32Position, U32 u32End, U8* pu8Channel, E_TRACKER_OPCODE* peOpCode, U32* pu32Operand );
+static BOOL CheckSnapshot( S_TRACKER_MODULE const* psModule, U32 u32Offset, U32 u32SnapshotStart );
+static BOOL CheckTime( U32* pu32TimeMs, U8 u8Channel, E_TRACKER_OPCODE eOpCode, U32 u32Operand );
+static E_TRACKER_LOAD_RESULT CheckPatterns( S_TRACKER_MODULE const* psModule, U32 u32TablesEnd );
+static E_TRACKER_LOAD_RESULT CheckSong( S_TRACKER_MODULE* psModule, U32 u32SnapshotStart );
+static E_TRACKER_LOAD_RESULT CheckInstruments( S_TRACKER_MODULE const* psModule );
+static E_TRACKER_LOAD_RESULT CheckModule( S_TRACKER_MODULE* psModule );
+static void PrepareInstruments( S_TRACKER_MODULE* psModule );
 
 
 //--------------------------------------------------------------------------------------------------------/
@@ -63,29 +230,93 @@ static void ExecuteOpCode( U8 u8Channel, E_TRACKER_OPCODE eOpCode, U32 u32Operan
  * \param  eOpCode: given opcode
  * \param  u32Operand: operand to the opcode
  * \return -
- * \note   Also calculates the next opcode time
+ * \note   Also calculates the next opcode time. The module is validated
+ *         at loading, so the channel and the operand need no checks.
  *********************************************************************/
 static void ExecuteOpCode( U8 u8Channel, E_TRACKER_OPCODE eOpCode, U32 u32Operand )
 {
+  S_TRACKER_CALL* psCall;
+  U64 u64Frames;
+
   switch( eOpCode )
   {
     case TRACKER_OPCODE_NOP:  // No operation
       break;
       
     case TRACKER_OPCODE_KEYON:  // Hit a note
-      SoundSynth_Press( u32Operand, u8Channel );
+      // One note per channel, like before
+      SoundSynth_RenderNoteOff( gahChannelNotes[ u8Channel ] );
+      gahChannelNotes[ u8Channel ] = SoundSynth_RenderNoteOn( u32Operand, gau8ChannelInstruments[ u8Channel ], SYNTH_PRIORITY_MUSIC );
+      // The new note inherits the modulation of the channel
+      if( 0 != gai16ChannelBends[ u8Channel ] )
+      {
+        SoundSynth_RenderSetPitchBend( gahChannelNotes[ u8Channel ], gai16ChannelBends[ u8Channel ] );
+      }
+      if( 0u != (U16)gau32ChannelVibratos[ u8Channel ] )
+      {
+        SoundSynth_RenderSetVibrato( gahChannelNotes[ u8Channel ], (U16)gau32ChannelVibratos[ u8Channel ], (U16)( gau32ChannelVibratos[ u8Channel ]>>16u ) );
+      }
       break;
 
     case TRACKER_OPCODE_KEYOFF:  // Release a note
-      SoundSynth_Release( u8Channel );
+      SoundSynth_RenderNoteOff( gahChannelNotes[ u8Channel ] );
+      gahChannelNotes[ u8Channel ] = SYNTH_NOTE_NONE;
       break;
       
     case TRACKER_OPCODE_WAITMS: // Wait for a given time
-      gu32NextTimeCallMs += u32Operand;
+      // Converted to frames at the tempo; the remainder is carried over, so the song does not drift
+      u64Frames = ( (U64)u32Operand*SAMPLE_RATE<<16u ) + gu32WaitRemainder;
+      gu32WaitFrames += (U32)( u64Frames/( 1000u*gu32Tempo ) );
+      gu32WaitRemainder = (U32)( u64Frames%( 1000u*gu32Tempo ) );
+      gu32SongMs += u32Operand;
+      break;
+
+    case TRACKER_OPCODE_INSTRUMENTCHANGE:  // Change instrument of the channel
+      gau8ChannelInstruments[ u8Channel ] = (U8)u32Operand;
+      break;
+
+    case TRACKER_OPCODE_INSTRUMENTBIND:  // Instrument of the module to the channel
+      gau8ChannelInstruments[ u8Channel ] = SYNTH_INSTRUMENT_MODULE + (U8)u32Operand;
+      break;
+
+    case TRACKER_OPCODE_PITCHBEND:  // Bend the pitch of the channel
+      gai16ChannelBends[ u8Channel ] = (I16)u32Operand;
+      SoundSynth_RenderSetPitchBend( gahChannelNotes[ u8Channel ], gai16ChannelBends[ u8Channel ] );
+      break;
+
+    case TRACKER_OPCODE_VIBRATO:  // Vibrato of the channel
+      gau32ChannelVibratos[ u8Channel ] = u32Operand;
+      SoundSynth_RenderSetVibrato( gahChannelNotes[ u8Channel ], (U16)u32Operand, (U16)( u32Operand>>16u ) );
+      break;
+
+    case TRACKER_OPCODE_CALL:  // Play a pattern, the channel field is the number of repeats
+      psCall = &gasCallStack[ gu8CallDepth++ ];
+      psCall->u32Return = gu32CodePosition;
+      psCall->u32Pattern = ReadU16( &gsModule.pu8Data[ gsModule.u32Patterns + sizeof( U16 )*u32Operand ] );
+      psCall->u8Repeats = u8Channel;
+      gu32CodePosition = psCall->u32Pattern;
+      break;
+
+    case TRACKER_OPCODE_RETURN:  // End of the pattern
+      psCall = &gasCallStack[ gu8CallDepth - 1u ];
+      if( 0u != psCall->u8Repeats )
+      {
+        psCall->u8Repeats--;
+        gu32CodePosition = psCall->u32Pattern;
+      }
+      else
+      {
+        // The patterns are resident, the stream of a streamed module continues where the CALL was read
+        gu32CodePosition = psCall->u32Return;
+        gu8CallDepth--;
+      }
       break;
 
     case TRACKER_OPCODE_END:  // End of track
-      gu32NextInstructionIdx = 0u;
+      // The song loops, with the channel settings of its beginning
+      ResetChannels();
+      gu32CodePosition = gsModule.u32CodeStart;
+      gu32SongMs = 0u;
       break;
 
     default:  // This should not happen
@@ -94,11 +325,884 @@ static void ExecuteOpCode( U8 u8Channel, E_TRACKER_OPCODE eOpCode, U32 u32Operan
   }
 }
 
+/*! *******************************************************************
+ * \brief  Takes over the tempo set from the main loop
+ * \param  -
+ * \return -
+ * \note   The pending wait and its remainder are converted to the new
+ *         tempo, so the song position is kept exactly.
+ *********************************************************************/
+static void UpdateTempo( void )
+{
+  U32 u32Tempo = gu32TempoRequest;
+  U64 u64Wait;
+
+  if( u32Tempo != gu32Tempo )
+  {
+    u64Wait = (U64)gu32WaitFrames*( 1000u*gu32Tempo ) + gu32WaitRemainder;
+    gu32WaitFrames = (U32)( u64Wait/( 1000u*u32Tempo ) );
+    gu32WaitRemainder = (U32)( u64Wait%( 1000u*u32Tempo ) );
+    gu32Tempo = u32Tempo;
+  }
+}
+
+/*! *******************************************************************
+ * \brief  Continues the byte code from the given offset
+ * \param  u32Offset: offset of the next instruction
+ * \return -
+ * \note   The stream of a streamed module is restarted there: the blocks
+ *         read ahead are dropped, and the main loop reads the new ones.
+ *         The song is held until the first block is read.
+ *********************************************************************/
+static void RestartCode( U32 u32Offset )
+{
+  gu32CodePosition = u32Offset;
+  gu8CallDepth = 0u;
+  // A resident module stops the stream
+  gsStreamRequest.pfRead = gsModule.pfRead;
+  gsStreamRequest.u32Address = gsModule.u32Address;
+  gsStreamRequest.u32Offset = u32Offset;
+  gsStreamRequest.u32LoopStart = gsModule.u32CodeStart;
+  gsStreamRequest.u32LoopEnd = gsModule.u32CodeEnd;
+  gu32StreamRead = 0u;
+  gu32StreamReleased = 0u;
+  // The producer takes the request over at the next epoch, and drops what it reads for the old one
+  gu8StreamEpoch++;
+}
+
+/*! *******************************************************************
+ * \brief  Checks that the next instruction can be decoded
+ * \param  -
+ * \return TRUE if the instruction is resident, or its bytes are read ahead
+ * \note   Counts the stalls, when the main loop could not keep the ring
+ *         filled. Waiting for the first blocks after a restart is not a stall.
+ *********************************************************************/
+static BOOL IsCodeLoaded( void )
+{
+  U32 u32Loaded;
+
+  if( gu32CodePosition < gsModule.u32Resident )
+  {
+    return TRUE;
+  }
+  u32Loaded = gu32StreamLoaded;
+  if( ( u32Loaded>>TRACKER_STREAM_EPOCH_SHIFT ) != gu8StreamEpoch )
+  {
+    return FALSE;
+  }
+  // The stream loops with the song, so there are always bytes after the instruction
+  if( ( ( u32Loaded & TRACKER_STREAM_COUNT_MASK )*TRACKER_STREAM_BLOCK_SIZE - gu32StreamRead ) < TRACKER_INSTRUCTION_MAX_SIZE )
+  {
+    gu32StreamStalls++;
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/*! *******************************************************************
+ * \brief  Reads a 16-bit little endian number
+ * \param  pu8Data: the number, may be unaligned
+ * \return The number
+ *********************************************************************/
+static U16 ReadU16( U8 const* pu8Data )
+{
+  return (U16)pu8Data[ 0u ] | (U16)( (U16)pu8Data[ 1u ]<<8u );
+}
+
+/*! *******************************************************************
+ * \brief  Reads a 32-bit little endian number
+ * \param  pu8Data: the number, may be unaligned
+ * \return The number
+ *********************************************************************/
+static U32 ReadU32( U8 const* pu8Data )
+{
+  return (U32)pu8Data[ 0u ]
+       | ( (U32)pu8Data[ 1u ]<<8u )
+       | ( (U32)pu8Data[ 2u ]<<16u )
+       | ( (U32)pu8Data[ 3u ]<<24u );
+}
+
+/*! *******************************************************************
+ * \brief  Reads the next byte of the byte code
+ * \param  -
+ * \return The byte
+ * \note   The byte code of a streamed module is read from the ring,
+ *         IsCodeLoaded() must be checked before every instruction.
+ *********************************************************************/
+static U8 ReadCodeByte( void )
+{
+  U8 u8Byte;
+
+  if( gu32CodePosition < gsModule.u32Resident )
+  {
+    u8Byte = gsModule.pu8Data[ gu32CodePosition ];
+  }
+  else
+  {
+    u8Byte = gau8StreamBlocks[ ( gu32StreamRead/TRACKER_STREAM_BLOCK_SIZE ) & TRACKER_STREAM_MASK ][ gu32StreamRead%TRACKER_STREAM_BLOCK_SIZE ];
+    gu32StreamRead++;
+  }
+  gu32CodePosition++;
+
+  return u8Byte;
+}
+
+/*! *******************************************************************
+ * \brief  Reads a variable length number from the byte code
+ * \param  -
+ * \return The number
+ * \note   7 bits per byte from the lowest; the highest bit of a byte is
+ *         set if more bytes follow. At most TRACKER_VARINT_MAX_BYTES are read.
+ *********************************************************************/
+static U32 ReadVarInt( void )
+{
+  U32 u32Value = 0u;
+  U8  u8Byte;
+  U8  u8Index;
+
+  for( u8Index = 0u; u8Index < TRACKER_VARINT_MAX_BYTES; u8Index++ )
+  {
+    u8Byte = ReadCodeByte();
+    u32Value |= (U32)( u8Byte & 0x7Fu )<<( 7u*u8Index );
+    if( 0u == ( u8Byte & 0x80u ) )
+    {
+      break;
+    }
+  }
+
+  return u32Value;
+}
+
+/*! *******************************************************************
+ * \brief  Decodes the next instruction of the module
+ * \param  pu8Channel: the channel of the instruction is returned here
+ * \param  peOpCode: the opcode is returned here
+ * \param  pu32Operand: the operand is returned here
+ * \return -
+ * \note   Streams the module: the only state is the offset of the next
+ *         instruction. The module is validated at loading, so there are
+ *         no bound checks here. Version 1 modules are always resident.
+ *         The channel of a CALL is its number of repeats.
+ *********************************************************************/
+static void FetchInstruction( U8* pu8Channel, E_TRACKER_OPCODE* peOpCode, U32* pu32Operand )
+{
+  S_TRACKER_INSTRUCTION const* psInstruction;
+  U8  u8Code;
+  U8  u8Note;
+  U32 u32Value;
+
+  if( TRUE != gsModule.bCompact )
+  {
+    psInstruction = (S_TRACKER_INSTRUCTION const*)&gsModule.pu8Data[ gu32CodePosition ];
+    *pu8Channel = psInstruction->u8Channel;
+    *peOpCode = (E_TRACKER_OPCODE)psInstruction->u8OpCode;
+    *pu32Operand = psInstruction->u32Operand;
+    gu32CodePosition += sizeof( S_TRACKER_INSTRUCTION );
+    return;
+  }
+
+  u8Code = ReadCodeByte();
+  *pu8Channel = u8Code & TRACKER_CODE_CHANNEL_MASK;
+  *peOpCode = (E_TRACKER_OPCODE)( u8Code>>TRACKER_CODE_OPCODE_SHIFT );
+  *pu32Operand = 0u;
+  switch( *peOpCode )
+  {
+    case TRACKER_OPCODE_NOP:
+    case TRACKER_OPCODE_KEYOFF:
+    case TRACKER_OPCODE_RETURN:
+      break;
+
+    case TRACKER_OPCODE_KEYON:
+      // Phase increase from the note table
+      u8Note = ReadCodeByte();
+      *pu32Operand = ReadU32( &gsModule.pu8Data[ sizeof( S_MODULE_HEADER_V2 ) + sizeof( U32 )*u8Note ] );
+      break;
+
+    case TRACKER_OPCODE_INSTRUMENTCHANGE:
+    case TRACKER_OPCODE_INSTRUMENTBIND:
+    case TRACKER_OPCODE_CALL:
+      *pu32Operand = ReadCodeByte();
+      break;
+
+    case TRACKER_OPCODE_WAITMS:
+    case TRACKER_OPCODE_VIBRATO:
+      *pu32Operand = ReadVarInt();
+      break;
+
+    case TRACKER_OPCODE_PITCHBEND:
+      u32Value = ReadVarInt();
+      *pu32Operand = ( u32Value>>1u ) ^ ( 0u - ( u32Value & 1u ) );
+      break;
+
+    default:  // TRACKER_CODE_END
+      *peOpCode = TRACKER_OPCODE_END;
+      break;
+  }
+}
+
+/*! *******************************************************************
+ * \brief  Releases the notes of all channels
+ * \param  -
+ * \return -
+ *********************************************************************/
+static void ReleaseChannels( void )
+{
+  U8 u8Channel;
+
+  for( u8Channel = 0u; u8Channel < TRACKER_NUMBER_OF_CHANNELS; u8Channel++ )
+  {
+    SoundSynth_RenderNoteOff( gahChannelNotes[ u8Channel ] );
+    gahChannelNotes[ u8Channel ] = SYNTH_NOTE_NONE;
+  }
+}
+
  /*! *******************************************************************
- * \brief
- * \param
- * \return
+ * \brief  Sets the default instrument and clears the pitch bend and the
+ *         vibrato of all channels
+ * \param  -
+ * \return -
+ *********************************************************************/
+static void ResetChannels( void )
+{
+  U8 u8Channel;
+
+  for( u8Channel = 0u; u8Channel < TRACKER_NUMBER_OF_CHANNELS; u8Channel++ )
+  {
+    gau8ChannelInstruments[ u8Channel ] = ( TRACKER_PERCUSSION_CHANNEL == u8Channel ) ? SYNTH_INSTRUMENT_DRUM : SYNTH_INSTRUMENT_SINE;
+    gai16ChannelBends[ u8Channel ] = 0;
+    gau32ChannelVibratos[ u8Channel ] = 0u;
+  }
+}
+
+ /*! *******************************************************************
+ * \brief  Gives the instruments of the module to the synthesizer
+ * \param  -
+ * \return -
+ * \note   They were converted at loading, so this only sets the slots
+ *********************************************************************/
+static void SetInstruments( void )
+{
+  U8 u8Instrument;
+
+  for( u8Instrument = 0u; u8Instrument < gsModule.u8NumberOfInstruments; u8Instrument++ )
+  {
+    SoundSynth_RenderSetPatch( SYNTH_INSTRUMENT_MODULE + u8Instrument, &gsModule.psPatches[ u8Instrument ] );
+  }
+}
+
+ /*! *******************************************************************
+ * \brief  Continues the song from an entry of the seek table
+ * \param  u16Entry: index of the seek table entry
+ * \return -
+ * \note   The channels must be reset before. Executes the snapshot of the
+ *         entry, so the notes that sound at that point are keyed on again.
+ *         The snapshots are resident, only the byte code is streamed.
+ *********************************************************************/
+static void RestoreSnapshot( U16 u16Entry )
+{
+  E_TRACKER_OPCODE eOpCode;
+  U32 u32Operand;
+  U32 u32Entry;
+  U32 u32Executed;
+  U8  u8Channel;
+
+  u32Entry = gsModule.u32SeekTable + sizeof( S_TRACKER_SEEK_ENTRY )*u16Entry;
+  gu32CodePosition = ReadU32( &gsModule.pu8Data[ u32Entry + offsetof( S_TRACKER_SEEK_ENTRY, u32SnapshotOffset ) ] );
+  for( u32Executed = 0u; u32Executed < TRACKER_MAX_INSTRUCTIONS; u32Executed++ )
+  {
+    FetchInstruction( &u8Channel, &eOpCode, &u32Operand );
+    if( TRACKER_OPCODE_END == eOpCode )
+    {
+      break;
+    }
+    ExecuteOpCode( u8Channel, eOpCode, u32Operand );
+  }
+  RestartCode( ReadU32( &gsModule.pu8Data[ u32Entry + offsetof( S_TRACKER_SEEK_ENTRY, u32CodeOffset ) ] ) );
+}
+
+ /*! *******************************************************************
+ * \brief  Reads a byte of a module being loaded
+ * \param  psModule: the module
+ * \param  u32Offset: offset of the byte, must be within the module
+ * \return The byte
+ * \note   The streamed part is read a block at a time. Called from the
+ *         main loop only, as the ring belongs to the module being played.
+ *********************************************************************/
+static U8 CheckByte( S_TRACKER_MODULE const* psModule, U32 u32Offset )
+{
+  U32 u32Length;
+
+  if( u32Offset < psModule->u32Resident )
+  {
+    return psModule->pu8Data[ u32Offset ];
+  }
+  if( ( u32Offset - gu32CheckBlockOffset ) >= TRACKER_STREAM_BLOCK_SIZE )
+  {
+    u32Length = psModule->u32Size - u32Offset;
+    if( u32Length > TRACKER_STREAM_BLOCK_SIZE )
+    {
+      u32Length = TRACKER_STREAM_BLOCK_SIZE;
+    }
+    psModule->pfRead( psModule->u32Address + u32Offset, gau8CheckBlock, u32Length );
+    gu32CheckBlockOffset = u32Offset;
+  }
+
+  return gau8CheckBlock[ u32Offset - gu32CheckBlockOffset ];
+}
+
+ /*! *******************************************************************
+ * \brief  Decodes and checks an instruction of a module being loaded
+ * \param  psModule: the module
+ * \param  pu32Position: offset of the instruction, advanced past it if it is valid
+ * \param  u32End: the instruction must end before this offset
+ * \param  pu8Channel: the channel is returned here (number of repeats for a CALL)
+ * \param  peOpCode: the opcode is returned here
+ * \param  pu32Operand: the operand is returned here (note index for a compact KEYON)
+ * \return TRUE if the instruction is valid
+ *********************************************************************/
+static BOOL CheckInstruction( S_TRACKER_MODULE const* psModule, U32* pu32Position, U32 u32End, U8* pu8Channel, E_TRACKER_OPCODE* peOpCode, U32* pu32Operand )
+{
+  U32 u32Position = *pu32Position;
+  S_TRACKER_INSTRUCTION const* psInstruction;
+  U8  u8Byte;
+  U8  u8Index;
+
+  if( u32Position >= u32End )
+  {
+    return FALSE;
+  }
+
+  if( TRUE != psModule->bCompact )
+  {
+    if( ( u32End - u32Position ) < sizeof( S_TRACKER_INSTRUCTION ) )
+    {
+      return FALSE;
+    }
+    psInstruction = (S_TRACKER_INSTRUCTION const*)&psModule->pu8Data[ u32Position ];
+    if( psInstruction->u8Channel >= TRACKER_NUMBER_OF_CHANNELS )
+    {
+      return FALSE;
+    }
+    *pu8Channel = psInstruction->u8Channel;
+    *peOpCode = (E_TRACKER_OPCODE)psInstruction->u8OpCode;
+    *pu32Operand = psInstruction->u32Operand;
+    u32Position += sizeof( S_TRACKER_INSTRUCTION );
+  }
+  else
+  {
+    u8Byte = CheckByte( psModule, u32Position++ );
+    *pu8Channel = u8Byte & TRACKER_CODE_CHANNEL_MASK;
+    *peOpCode = (E_TRACKER_OPCODE)( u8Byte>>TRACKER_CODE_OPCODE_SHIFT );
+    if( TRACKER_CODE_END == *peOpCode )
+    {
+      *peOpCode = TRACKER_OPCODE_END;
+    }
+    *pu32Operand = 0u;
+    switch( *peOpCode )
+    {
+      case TRACKER_OPCODE_KEYON:
+      case TRACKER_OPCODE_INSTRUMENTCHANGE:
+      case TRACKER_OPCODE_INSTRUMENTBIND:
+      case TRACKER_OPCODE_CALL:
+        if( u32Position >= u32End )
+        {
+          return FALSE;
+        }
+        *pu32Operand = CheckByte( psModule, u32Position++ );
+        break;
+
+      case TRACKER_OPCODE_WAITMS:
+      case TRACKER_OPCODE_PITCHBEND:
+      case TRACKER_OPCODE_VIBRATO:
+        // The number must end within TRACKER_VARINT_MAX_BYTES, and fit in 32 bits
+        for( u8Index = 0u; ; u8Index++ )
+        {
+          if( ( u32Position >= u32End ) || ( u8Index >= TRACKER_VARINT_MAX_BYTES ) )
+          {
+            return FALSE;
+          }
+          u8Byte = CheckByte( psModule, u32Position++ );
+          *pu32Operand |= (U32)( u8Byte & 0x7Fu )<<( 7u*u8Index );
+          if( 0u == ( u8Byte & 0x80u ) )
+          {
+            break;
+          }
+        }
+        if( ( ( TRACKER_VARINT_MAX_BYTES - 1u ) == u8Index ) && ( u8Byte > ( 0x7Fu>>( 7u*TRACKER_VARINT_MAX_BYTES - 32u ) ) ) )
+        {
+          return FALSE;
+        }
+        break;
+
+      default:  // No operand
+        break;
+    }
+  }
+
+  switch( *peOpCode )
+  {
+    case TRACKER_OPCODE_NOP:
+    case TRACKER_OPCODE_KEYOFF:
+    case TRACKER_OPCODE_WAITMS:
+    case TRACKER_OPCODE_PITCHBEND:
+    case TRACKER_OPCODE_VIBRATO:
+    case TRACKER_OPCODE_END:
+      break;
+
+    case TRACKER_OPCODE_KEYON:
+      if( ( TRUE == psModule->bCompact ) && ( *pu32Operand >= psModule->u8NumberOfNotes ) )
+      {
+        return FALSE;
+      }
+      break;
+
+    case TRACKER_OPCODE_INSTRUMENTCHANGE:
+      // The slots of the module instruments are only reached by INSTRUMENTBIND
+      if( *pu32Operand >= SYNTH_INSTRUMENT_MODULE )
+      {
+        return FALSE;
+      }
+      break;
+
+    case TRACKER_OPCODE_INSTRUMENTBIND:
+      if( *pu32Operand >= psModule->u8NumberOfInstruments )
+      {
+        return FALSE;
+      }
+      break;
+
+    case TRACKER_OPCODE_CALL:
+      // Version 1 modules have no patterns
+      if( *pu32Operand >= psModule->u8NumberOfPatterns )
+      {
+        return FALSE;
+      }
+      break;
+
+    case TRACKER_OPCODE_RETURN:
+      if( TRUE != psModule->bCompact )
+      {
+        return FALSE;
+      }
+      break;
+
+    default:  // Unknown opcode
+      return FALSE;
+  }
+
+  *pu32Position = u32Position;
+  return TRUE;
+}
+
+ /*! *******************************************************************
+ * \brief  Checks a snapshot of the seek table of a module being loaded
+ * \param  psModule: the module
+ * \param  u32Offset: offset of the snapshot
+ * \param  u32SnapshotStart: offset of the first snapshot
+ * \return TRUE if the snapshot is valid
+ * \note   A snapshot is closed by END within TRACKER_MAX_INSTRUCTIONS, and
+ *         does not wait or call patterns.
+ *********************************************************************/
+static BOOL CheckSnapshot( S_TRACKER_MODULE const* psModule, U32 u32Offset, U32 u32SnapshotStart )
+{
+  E_TRACKER_OPCODE eOpCode;
+  U32 u32Operand;
+  U32 u32Index;
+  U8  u8Channel;
+
+  if( u32Offset < u32SnapshotStart )
+  {
+    return FALSE;
+  }
+  for( u32Index = 0u; u32Index < TRACKER_MAX_INSTRUCTIONS; u32Index++ )
+  {
+    if( ( FALSE == CheckInstruction( psModule, &u32Offset, psModule->u32CodeStart, &u8Channel, &eOpCode, &u32Operand ) )
+     || ( TRACKER_OPCODE_WAITMS == eOpCode ) || ( TRACKER_OPCODE_CALL == eOpCode ) || ( TRACKER_OPCODE_RETURN == eOpCode ) )
+    {
+      return FALSE;
+    }
+    if( TRACKER_OPCODE_END == eOpCode )
+    {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+ /*! *******************************************************************
+ * \brief  Advances the song position by an instruction of a module being loaded
+ * \param  pu32TimeMs: the song position (ms)
+ * \param  u8Channel: channel of the instruction (number of repeats for a CALL)
+ * \param  eOpCode: opcode of the instruction
+ * \param  u32Operand: operand of the instruction
+ * \return FALSE if the song position does not fit in 32 bits
+ * \note   A CALL takes the length of its pattern, times the number it is
+ *         played. The patterns it may call are checked before.
+ *********************************************************************/
+static BOOL CheckTime( U32* pu32TimeMs, U8 u8Channel, E_TRACKER_OPCODE eOpCode, U32 u32Operand )
+{
+  U64 u64Length = 0u;
+
+  if( TRACKER_OPCODE_WAITMS == eOpCode )
+  {
+    u64Length = u32Operand;
+  }
+  else if( TRACKER_OPCODE_CALL == eOpCode )
+  {
+    u64Length = (U64)gau32CheckPatternMs[ u32Operand ]*( u8Channel + 1u );
+  }
+  if( ( *pu32TimeMs + u64Length ) > 0xFFFFFFFFu )
+  {
+    return FALSE;
+  }
+  *pu32TimeMs += (U32)u64Length;
+
+  return TRUE;
+}
+
+ /*! *******************************************************************
+ * \brief  Checks the patterns of a module being loaded
+ * \param  psModule: the module
+ * \param  u32TablesEnd: offset after the tables, where the patterns may start
+ * \return TRACKER_LOAD_OK if every pattern is valid
+ * \note   A pattern is closed by RETURN before the byte code of the song,
+ *         so it is resident in streamed modules too. It may call only the
+ *         patterns before it, so there is no recursion, and the calls
+ *         nest at most TRACKER_CALL_DEPTH deep. The length of each pattern
+ *         is kept for checking the song.
+ *********************************************************************/
+static E_TRACKER_LOAD_RESULT CheckPatterns( S_TRACKER_MODULE const* psModule, U32 u32TablesEnd )
+{
+  E_TRACKER_OPCODE eOpCode;
+  U32 u32Operand;
+  U32 u32Position;
+  U8  u8Channel;
+  U8  u8Pattern;
+
+  for( u8Pattern = 0u; u8Pattern < psModule->u8NumberOfPatterns; u8Pattern++ )
+  {
+    u32Position = ReadU16( &psModule->pu8Data[ psModule->u32Patterns + sizeof( U16 )*u8Pattern ] );
+    if( u32Position < u32TablesEnd )
+    {
+      return TRACKER_LOAD_BAD_OFFSET;
+    }
+    gau32CheckPatternMs[ u8Pattern ] = 0u;
+    gau8CheckPatternDepths[ u8Pattern ] = 1u;
+    do
+    {
+      if( ( FALSE == CheckInstruction( psModule, &u32Position, psModule->u32CodeStart, &u8Channel, &eOpCode, &u32Operand ) )
+       || ( TRACKER_OPCODE_END == eOpCode ) )
+      {
+        return TRACKER_LOAD_BAD_INSTRUCTION;
+      }
+      if( TRACKER_OPCODE_CALL == eOpCode )
+      {
+        if( ( u32Operand >= u8Pattern ) || ( gau8CheckPatternDepths[ u32Operand ] >= TRACKER_CALL_DEPTH ) )
+        {
+          return TRACKER_LOAD_BAD_INSTRUCTION;
+        }
+        if( gau8CheckPatternDepths[ u32Operand ] >= gau8CheckPatternDepths[ u8Pattern ] )
+        {
+          gau8CheckPatternDepths[ u8Pattern ] = gau8CheckPatternDepths[ u32Operand ] + 1u;
+        }
+      }
+      if( FALSE == CheckTime( &gau32CheckPatternMs[ u8Pattern ], u8Channel, eOpCode, u32Operand ) )
+      {
+        return TRACKER_LOAD_BAD_INSTRUCTION;
+      }
+    } while( TRACKER_OPCODE_RETURN != eOpCode );
+  }
+
+  return TRACKER_LOAD_OK;
+}
+
+ /*! *******************************************************************
+ * \brief  Checks the instructions and the seek table of a module being loaded
+ * \param  psModule: the module, the end of its song is filled in
+ * \param  u32SnapshotStart: offset of the first snapshot
+ * \return TRACKER_LOAD_OK if the song is valid
+ * \note   Walks the song up to its END. The seek table entries must point
+ *         to instructions of the song in order, with the time of the song
+ *         at that instruction. They are never inside a pattern.
+ *********************************************************************/
+static E_TRACKER_LOAD_RESULT CheckSong( S_TRACKER_MODULE* psModule, U32 u32SnapshotStart )
+{
+  E_TRACKER_OPCODE eOpCode;
+  U32 u32Operand;
+  U32 u32Position = psModule->u32CodeStart;
+  U32 u32TimeMs = 0u;
+  U32 u32Entry;
+  U16 u16Entry = 0u;
+  U8  u8Channel;
+
+  do
+  {
+    if( u16Entry < psModule->u16SeekEntries )
+    {
+      u32Entry = psModule->u32SeekTable + sizeof( S_TRACKER_SEEK_ENTRY )*u16Entry;
+      if( u32Position == ReadU32( &psModule->pu8Data[ u32Entry + offsetof( S_TRACKER_SEEK_ENTRY, u32CodeOffset ) ] ) )
+      {
+        if( ( u32TimeMs != ReadU32( &psModule->pu8Data[ u32Entry + offsetof( S_TRACKER_SEEK_ENTRY, u32TimeMs ) ] ) )
+         || ( FALSE == CheckSnapshot( psModule, ReadU32( &psModule->pu8Data[ u32Entry + offsetof( S_TRACKER_SEEK_ENTRY, u32SnapshotOffset ) ] ), u32SnapshotStart ) ) )
+        {
+          return TRACKER_LOAD_BAD_SEEK_TABLE;
+        }
+        u16Entry++;
+      }
+    }
+    if( u32Position >= psModule->u32Size )
+    {
+      return TRACKER_LOAD_NO_END;
+    }
+    // The song position must fit in 32 bits, and the song is not a pattern
+    if( ( FALSE == CheckInstruction( psModule, &u32Position, psModule->u32Size, &u8Channel, &eOpCode, &u32Operand ) )
+     || ( FALSE == CheckTime( &u32TimeMs, u8Channel, eOpCode, u32Operand ) )
+     || ( TRACKER_OPCODE_RETURN == eOpCode ) )
+    {
+      return TRACKER_LOAD_BAD_INSTRUCTION;
+    }
+  } while( TRACKER_OPCODE_END != eOpCode );
+
+  if( u16Entry != psModule->u16SeekEntries )
+  {
+    return TRACKER_LOAD_BAD_SEEK_TABLE;
+  }
+  psModule->u32CodeEnd = u32Position;
+
+  return TRACKER_LOAD_OK;
+}
+
+ /*! *******************************************************************
+ * \brief  Checks the instruments of a module being loaded
+ * \param  psModule: the module, its code start is already checked
+ * \return TRACKER_LOAD_OK if every instrument can be played
+ * \note   A wavetable of the module must be before the byte code, so it
+ *         is resident in streamed modules too.
  *********************************************************************/
+static E_TRACKER_LOAD_RESULT CheckInstruments( S_TRACKER_MODULE const* psModule )
+{
+  U8 const* pu8Entry;
+  U32 u32Reference;
+  U16 u16Size;
+  U8  u8Instrument;
+
+  for( u8Instrument = 0u; u8Instrument < psModule->u8NumberOfInstruments; u8Instrument++ )
+  {
+    pu8Entry = &psModule->pu8Data[ psModule->u32Instruments + sizeof( S_TRACKER_INSTRUMENT )*u8Instrument ];
+    if( pu8Entry[ offsetof( S_TRACKER_INSTRUMENT, u8Curve ) ] > (U8)SYNTH_CURVE_EXPONENTIAL )
+    {
+      return TRACKER_LOAD_BAD_INSTRUMENT;
+    }
+    u32Reference = ReadU16( &pu8Entry[ offsetof( S_TRACKER_INSTRUMENT, u16Reference ) ] );
+    u16Size = ReadU16( &pu8Entry[ offsetof( S_TRACKER_INSTRUMENT, u16WaveTableSize ) ] );
+    switch( (E_TRACKER_VOICE)pu8Entry[ offsetof( S_TRACKER_INSTRUMENT, u8Voice ) ] )
+    {
+      case TRACKER_VOICE_SINE:
+      case TRACKER_VOICE_SQUARE:
+      case TRACKER_VOICE_SAW:
+        break;
+
+      case TRACKER_VOICE_WAVETABLE:
+        if( ( u16Size < 2u ) || ( u16Size > SYNTH_WAVETABLE_SIZE ) || ( 0u != ( u16Size & ( u16Size - 1u ) ) )
+         || ( 0u != ( u32Reference & 1u ) ) || ( ( u32Reference + sizeof( I16 )*u16Size ) > psModule->u32CodeStart ) )
+        {
+          return TRACKER_LOAD_BAD_INSTRUMENT;
+        }
+        break;
+
+      case TRACKER_VOICE_NOISE:
+        if( ( u32Reference < SYNTH_NOISE_BITS_MIN ) || ( u32Reference > SYNTH_NOISE_BITS_MAX ) )
+        {
+          return TRACKER_LOAD_BAD_INSTRUMENT;
+        }
+        break;
+
+      default:  // Unknown voice
+        return TRACKER_LOAD_BAD_INSTRUMENT;
+    }
+  }
+
+  return TRACKER_LOAD_OK;
+}
+
+ /*! *******************************************************************
+ * \brief  Validates a module, and fills in its description
+ * \param  psModule: the module, with its data, size and stream set
+ * \return TRACKER_LOAD_OK if the module can be played
+ * \note   Modules without the magic are version 1. Their header fields
+ *         were never filled in by mid2trk, so only the instructions are
+ *         checked. Only the byte code of compact modules can be streamed,
+ *         everything before it stays resident.
+ *********************************************************************/
+static E_TRACKER_LOAD_RESULT CheckModule( S_TRACKER_MODULE* psModule )
+{
+  S_MODULE_HEADER_V2 const* psHeader = (S_MODULE_HEADER_V2 const*)psModule->pu8Data;
+  E_TRACKER_LOAD_RESULT eResult;
+  U32 u32Offset;
+
+  if( ( NULL == psModule->pu8Data ) || ( psModule->u32Size < sizeof( S_MODULE_HEADER ) ) )
+  {
+    return TRACKER_LOAD_TOO_SHORT;
+  }
+
+  if( ( psModule->u32Size >= sizeof( S_MODULE_HEADER_V2 ) )
+   && ( 0 == memcmp( psHeader->au8Magic, TRACKER_MODULE_MAGIC, sizeof( psHeader->au8Magic ) ) ) )
+  {
+    if( ( TRACKER_MODULE_VERSION != psHeader->u8Version )
+     || ( 0u != ( psHeader->u8Flags & (U8)~( TRACKER_FLAG_SEEK_TABLE | TRACKER_FLAG_INSTRUMENTS | TRACKER_FLAG_PATTERNS ) ) ) )
+    {
+      return TRACKER_LOAD_BAD_HEADER;
+    }
+    psModule->bCompact = TRUE;
+    psModule->u8NumberOfNotes = psHeader->u8NumberOfNotes;
+    u32Offset = sizeof( S_MODULE_HEADER_V2 ) + sizeof( U32 )*psModule->u8NumberOfNotes;
+    psModule->u8NumberOfInstruments = 0u;
+    psModule->u32Instruments = 0u;
+    if( 0u != ( psHeader->u8Flags & TRACKER_FLAG_INSTRUMENTS ) )
+    {
+      if( ( u32Offset + sizeof( U8 ) ) > psModule->u32Resident )
+      {
+        return ( psModule->u32Resident < psModule->u32Size ) ? TRACKER_LOAD_TOO_BIG : TRACKER_LOAD_BAD_OFFSET;
+      }
+      psModule->u8NumberOfInstruments = psModule->pu8Data[ u32Offset ];
+      if( psModule->u8NumberOfInstruments > SOUNDSYNTH_MODULE_INSTRUMENTS )
+      {
+        return TRACKER_LOAD_BAD_INSTRUMENT;
+      }
+      psModule->u32Instruments = u32Offset + sizeof( U8 );
+      u32Offset = psModule->u32Instruments + sizeof( S_TRACKER_INSTRUMENT )*psModule->u8NumberOfInstruments;
+    }
+    psModule->u16SeekEntries = 0u;
+    psModule->u32SeekTable = 0u;
+    if( 0u != ( psHeader->u8Flags & TRACKER_FLAG_SEEK_TABLE ) )
+    {
+      if( ( u32Offset + sizeof( U16 ) ) > psModule->u32Resident )
+      {
+        return ( psModule->u32Resident < psModule->u32Size ) ? TRACKER_LOAD_TOO_BIG : TRACKER_LOAD_BAD_OFFSET;
+      }
+      psModule->u16SeekEntries = (U16)psModule->pu8Data[ u32Offset ] | ( (U16)psModule->pu8Data[ u32Offset + 1u ]<<8u );
+      psModule->u32SeekTable = u32Offset + sizeof( U16 );
+      u32Offset = psModule->u32SeekTable + sizeof( S_TRACKER_SEEK_ENTRY )*psModule->u16SeekEntries;
+    }
+    psModule->u8NumberOfPatterns = 0u;
+    psModule->u32Patterns = 0u;
+    if( 0u != ( psHeader->u8Flags & TRACKER_FLAG_PATTERNS ) )
+    {
+      if( ( u32Offset + sizeof( U8 ) ) > psModule->u32Resident )
+      {
+        return ( psModule->u32Resident < psModule->u32Size ) ? TRACKER_LOAD_TOO_BIG : TRACKER_LOAD_BAD_OFFSET;
+      }
+      psModule->u8NumberOfPatterns = psModule->pu8Data[ u32Offset ];
+      if( psModule->u8NumberOfPatterns > TRACKER_MAX_PATTERNS )
+      {
+        return TRACKER_LOAD_BAD_HEADER;
+      }
+      psModule->u32Patterns = u32Offset + sizeof( U8 );
+      u32Offset = psModule->u32Patterns + sizeof( U16 )*psModule->u8NumberOfPatterns;
+    }
+    // The snapshots and the patterns are between the tables and the byte code
+    psModule->u32CodeStart = psHeader->u16CodeOffset;
+    if( ( psModule->u32CodeStart < u32Offset ) || ( psModule->u32CodeStart >= psModule->u32Size ) )
+    {
+      return TRACKER_LOAD_BAD_OFFSET;
+    }
+    if( psModule->u32CodeStart > psModule->u32Resident )
+    {
+      return TRACKER_LOAD_TOO_BIG;
+    }
+    if( NULL != psModule->pfRead )
+    {
+      psModule->u32Resident = psModule->u32CodeStart;
+    }
+    eResult = CheckInstruments( psModule );
+    if( TRACKER_LOAD_OK == eResult )
+    {
+      eResult = CheckPatterns( psModule, u32Offset );
+    }
+    if( TRACKER_LOAD_OK != eResult )
+    {
+      return eResult;
+    }
+  }
+  else if( NULL != psModule->pfRead )
+  {
+    return TRACKER_LOAD_BAD_HEADER;
+  }
+  else
+  {
+    psModule->bCompact = FALSE;
+    psModule->u8NumberOfNotes = 0u;
+    psModule->u8NumberOfInstruments = 0u;
+    psModule->u32Instruments = 0u;
+    psModule->u8NumberOfPatterns = 0u;
+    psModule->u32Patterns = 0u;
+    psModule->u16SeekEntries = 0u;
+    psModule->u32SeekTable = 0u;
+    psModule->u32CodeStart = sizeof( S_MODULE_HEADER );
+    u32Offset = psModule->u32CodeStart;
+  }
+
+  return CheckSong( psModule, u32Offset );
+}
+
+ /*! *******************************************************************
+ * \brief  Converts the instruments of a validated module for the synthesizer
+ * \param  psModule: the module, its set of patches is filled in
+ * \return -
+ * \note   Called from the main loop, when no loaded module waits to be
+ *         taken over: the set of the module being played is kept. The
+ *         envelopes are prepared here, so a note of a module instrument
+ *         costs the same as any other.
+ *********************************************************************/
+static void PrepareInstruments( S_TRACKER_MODULE* psModule )
+{
+  S_SYNTH_PATCH* psPatch;
+  U8 const* pu8Entry;
+  U8 u8Instrument;
+
+  psModule->psPatches = ( gaasPatches[ 0u ] == gsModule.psPatches ) ? gaasPatches[ 1u ] : gaasPatches[ 0u ];
+  for( u8Instrument = 0u; u8Instrument < psModule->u8NumberOfInstruments; u8Instrument++ )
+  {
+    pu8Entry = &psModule->pu8Data[ psModule->u32Instruments + sizeof( S_TRACKER_INSTRUMENT )*u8Instrument ];
+    psPatch = &psModule->psPatches[ u8Instrument ];
+    psPatch->psWaveTable = &gcsSineWaveTable;
+    psPatch->pi16WaveTable = NULL;
+    psPatch->u16WaveTableSize = 0u;
+    psPatch->u8NoiseBits = 0u;
+    switch( (E_TRACKER_VOICE)pu8Entry[ offsetof( S_TRACKER_INSTRUMENT, u8Voice ) ] )
+    {
+      case TRACKER_VOICE_SQUARE:
+        psPatch->psWaveTable = &gcsSquareWaveTable;
+        break;
+
+      case TRACKER_VOICE_SAW:
+        psPatch->psWaveTable = &gcsSawWaveTable;
+        break;
+
+      case TRACKER_VOICE_WAVETABLE:
+        // The module is little endian, like the CPU
+        psPatch->psWaveTable = NULL;
+        psPatch->pi16WaveTable = (I16 const*)&psModule->pu8Data[ ReadU16( &pu8Entry[ offsetof( S_TRACKER_INSTRUMENT, u16Reference ) ] ) ];
+        psPatch->u16WaveTableSize = ReadU16( &pu8Entry[ offsetof( S_TRACKER_INSTRUMENT, u16WaveTableSize ) ] );
+        break;
+
+      case TRACKER_VOICE_NOISE:
+        psPatch->u8NoiseBits = (U8)ReadU16( &pu8Entry[ offsetof( S_TRACKER_INSTRUMENT, u16Reference ) ] );
+        break;
+
+      default:  // TRACKER_VOICE_SINE
+        break;
+    }
+    SoundSynth_PrepareEnvelope( &psPatch->sEnvelope,
+                                TRACKER_MS_TO_SAMPLES( ReadU16( &pu8Entry[ offsetof( S_TRACKER_INSTRUMENT, u16AttackMs ) ] ) ),
+                                TRACKER_MS_TO_SAMPLES( ReadU16( &pu8Entry[ offsetof( S_TRACKER_INSTRUMENT, u16DecayMs ) ] ) ),
+                                ReadU16( &pu8Entry[ offsetof( S_TRACKER_INSTRUMENT, u16Sustain ) ] ),
+                                TRACKER_MS_TO_SAMPLES( ReadU16( &pu8Entry[ offsetof( S_TRACKER_INSTRUMENT, u16ReleaseMs ) ] ) ),
+                                (E_SYNTH_CURVE)pu8Entry[ offsetof( S_TRACKER_INSTRUMENT, u8Curve ) ] );
+  }
+}
 
 
 //--------------------------------------------------------------------------------------------------------/
@@ -106,35 +1210,435 @@ static void ExecuteOpCode( U8 u8Channel, E_TRACKER_OPCODE eOpCode, U32 u32Operan
 //--------------------------------------------------------------------------------------------------------/
 /*! *******************************************************************
  * \brief  Initialize tracker module
- * \param  u32TimeMs: current time in ms
+ * \param  -
  * \return -
+ * \note   Must be called before the audio output is started
  *********************************************************************/
-void Tracker_Init( U32 u32TimeMs )
+void Tracker_Init( void )
 {
-  gu32NextInstructionIdx = 0u;
-  gu32NextTimeCallMs = u32TimeMs;
+  U8  u8Channel;
+  S_TRACKER_MODULE sModule;
+
+  for( u8Channel = 0u; u8Channel < TRACKER_NUMBER_OF_CHANNELS; u8Channel++ )
+  {
+    gahChannelNotes[ u8Channel ] = SYNTH_NOTE_NONE;
+  }
+  ResetChannels();
+
+  // The linked module, nothing is played if it is not valid
+  memset( &gsModule, 0, sizeof( gsModule ) );
+  sModule.pu8Data = gau8TrackerModule;
+  sModule.u32Size = TRACKER_LINKED_MODULE_SIZE;
+  sModule.u32Resident = sModule.u32Size;
+  sModule.pfRead = NULL;
+  sModule.u32Address = 0u;
+  if( TRACKER_LOAD_OK == CheckModule( &sModule ) )
+  {
+    PrepareInstruments( &sModule );
+    gsModule = sModule;
+    SetInstruments();
+  }
+  gu32CodePosition = gsModule.u32CodeStart;
+  gu8CallDepth = 0u;
+  gu32WaitFrames = 0u;
+  gu32WaitRemainder = 0u;
+  gu32Tempo = TRACKER_TEMPO_NORMAL;
+  gu32TempoRequest = TRACKER_TEMPO_NORMAL;
+  gu32SongMs = 0u;
+  gu32PositionMs = 0u;
+  gbPlaying = FALSE;
+  gbStartRequest = FALSE;
+  gbStopRequest = FALSE;
+  gbSeekRequest = FALSE;
+  gbLoadRequest = FALSE;
+  gu16SeekEntry = TRACKER_SEEK_NONE;
+  memset( &gsStreamRequest, 0, sizeof( gsStreamRequest ) );
+  memset( &gsStream, 0, sizeof( gsStream ) );
+  gu8StreamEpoch = 0u;
+  gu32StreamLoaded = 0u;
+  gu32StreamReleased = 0u;
+  gu32StreamRead = 0u;
+  gu32StreamStalls = 0u;
+  gbStreamInvalid = FALSE;
 }
 
  /*! *******************************************************************
- * \brief  Plays the song
- * \param  u32TimeMs: current time in ms
+ * \brief  Loads a module to be played
+ * \param  pu8Module: the module, must stay available while it is played
+ * \param  u32Size: size of the module in bytes
+ * \return TRACKER_LOAD_OK if the module is valid, otherwise the module
+ *         played before is kept
+ * \note   Callable from the main loop. The module is validated here once,
+ *         so the player does not check anything. It is taken over at the
+ *         next audio block, and the song stops until Tracker_Start().
+ *********************************************************************/
+E_TRACKER_LOAD_RESULT Tracker_Load( U8 const* pu8Module, U32 u32Size )
+{
+  S_TRACKER_MODULE sModule;
+  E_TRACKER_LOAD_RESULT eResult;
+
+  sModule.pu8Data = pu8Module;
+  sModule.u32Size = u32Size;
+  sModule.u32Resident = u32Size;
+  sModule.pfRead = NULL;
+  sModule.u32Address = 0u;
+  eResult = CheckModule( &sModule );
+  if( TRACKER_LOAD_OK == eResult )
+  {
+    // The render context does not take over the module while it is written
+    gbLoadRequest = FALSE;
+    PrepareInstruments( &sModule );
+    gsLoadedModule = sModule;
+    gbLoadRequest = TRUE;
+  }
+
+  return eResult;
+}
+
+ /*! *******************************************************************
+ * \brief  Loads the module linked to the firmware
+ * \param  -
+ * \return TRACKER_LOAD_OK if the module is valid
+ * \note   Callable from the main loop, like Tracker_Load()
+ *********************************************************************/
+E_TRACKER_LOAD_RESULT Tracker_LoadLinked( void )
+{
+  return Tracker_Load( gau8TrackerModule, TRACKER_LINKED_MODULE_SIZE );
+}
+
+ /*! *******************************************************************
+ * \brief  Loads a module to be streamed, e.g. from the SPI flash
+ * \param  pfRead: reads the module, called from the main loop only
+ * \param  u32Address: address of the module for pfRead
+ * \param  u32Size: size of the module in bytes, may be more than the module
+ *         if it is closed by END before
+ * \return TRACKER_LOAD_OK if the module is valid, otherwise the module
+ *         played before is kept
+ * \note   Callable from the main loop, like Tracker_Load(). Everything up
+ *         to the byte code is read to RAM, and the byte code is validated
+ *         by reading it through. While the module is played, the byte code
+ *         is read ahead by Tracker_Service(), so the render context never
+ *         waits for the flash.
+ *********************************************************************/
+E_TRACKER_LOAD_RESULT Tracker_LoadStream( pTrackerReadFunction pfRead, U32 u32Address, U32 u32Size )
+{
+  S_TRACKER_MODULE sModule;
+  E_TRACKER_LOAD_RESULT eResult;
+  BOOL bLoadRequest = gbLoadRequest;
+  U8*  pu8Tables;
+
+  // The module waiting to be taken over is kept from the render context, as its tables may be overwritten
+  gbLoadRequest = FALSE;
+  gbStreamInvalid = FALSE;
+  pu8Tables = ( gau8StreamTables[ 0u ] == gsModule.pu8Data ) ? gau8StreamTables[ 1u ] : gau8StreamTables[ 0u ];
+
+  sModule.pu8Data = pu8Tables;
+  sModule.u32Size = u32Size;
+  sModule.u32Resident = ( u32Size < TRACKER_STREAM_TABLES_SIZE ) ? u32Size : TRACKER_STREAM_TABLES_SIZE;
+  sModule.pfRead = pfRead;
+  sModule.u32Address = u32Address;
+  if( NULL == pfRead )
+  {
+    gbLoadRequest = bLoadRequest;
+    return TRACKER_LOAD_TOO_SHORT;
+  }
+  pfRead( u32Address, pu8Tables, sModule.u32Resident );
+  gu32CheckBlockOffset = 0u - TRACKER_STREAM_BLOCK_SIZE;  // nothing is read yet
+  eResult = CheckModule( &sModule );
+  if( TRACKER_LOAD_OK == eResult )
+  {
+    PrepareInstruments( &sModule );
+    gsLoadedModule = sModule;
+    gbLoadRequest = TRUE;
+  }
+  else if( gsLoadedModule.pu8Data != pu8Tables )
+  {
+    gbLoadRequest = bLoadRequest;
+  }
+
+  return eResult;
+}
+
+ /*! *******************************************************************
+ * \brief  Reads ahead the byte code of the streamed module
+ * \param  -
  * \return -
+ * \note   Must be called often enough from the main loop: the ring holds
+ *         TRACKER_STREAM_BLOCKS*TRACKER_STREAM_BLOCK_SIZE bytes, that is
+ *         seconds of music for most songs. Does nothing if the module being
+ *         played is resident.
  *********************************************************************/
-void Tracker_Play( U32 u32TimeMs )
+void Tracker_Service( void )
+{
+  U8  u8Epoch = gu8StreamEpoch;
+  U32 u32Loaded = gu32StreamLoaded;
+  U32 u32Length;
+  U32 u32Chunk;
+  U8* pu8Block;
+
+  if( ( u32Loaded>>TRACKER_STREAM_EPOCH_SHIFT ) != u8Epoch )
+  {
+    // Restarted by the render context: it does not change the request while this runs
+    gsStream = gsStreamRequest;
+    if( u8Epoch != gu8StreamEpoch )
+    {
+      return;  // restarted again while it was copied, taken over at the next call
+    }
+    u32Loaded = (U32)u8Epoch<<TRACKER_STREAM_EPOCH_SHIFT;
+  }
+  if( NULL == gsStream.pfRead )
+  {
+    return;
+  }
+
+  while( ( ( u32Loaded & TRACKER_STREAM_COUNT_MASK ) - gu32StreamReleased ) < TRACKER_STREAM_BLOCKS )
+  {
+    pu8Block = gau8StreamBlocks[ u32Loaded & TRACKER_STREAM_MASK ];
+    for( u32Length = 0u; u32Length < TRACKER_STREAM_BLOCK_SIZE; u32Length += u32Chunk )
+    {
+      // After the END the song continues from its beginning
+      if( gsStream.u32Offset >= gsStream.u32LoopEnd )
+      {
+        gsStream.u32Offset = gsStream.u32LoopStart;
+      }
+      u32Chunk = gsStream.u32LoopEnd - gsStream.u32Offset;
+      if( u32Chunk > ( TRACKER_STREAM_BLOCK_SIZE - u32Length ) )
+      {
+        u32Chunk = TRACKER_STREAM_BLOCK_SIZE - u32Length;
+      }
+      gsStream.pfRead( gsStream.u32Address + gsStream.u32Offset, &pu8Block[ u32Length ], u32Chunk );
+      gsStream.u32Offset += u32Chunk;
+    }
+    // The block is written before the count, so the renderer never sees half-loaded blocks.
+    // If the stream was restarted meanwhile, the old epoch makes the renderer ignore it.
+    u32Loaded++;
+    gu32StreamLoaded = u32Loaded;
+  }
+}
+
+ /*! *******************************************************************
+ * \brief  Starts the song from the beginning
+ * \param  -
+ * \return -
+ * \note   Callable from the main loop, takes effect at the next audio block
+ *********************************************************************/
+void Tracker_Start( void )
+{
+  gbStartRequest = TRUE;
+}
+
+ /*! *******************************************************************
+ * \brief  Stops the song, and releases its notes
+ * \param  -
+ * \return -
+ * \note   Callable from the main loop, takes effect at the next audio block
+ *********************************************************************/
+void Tracker_Stop( void )
+{
+  gbStopRequest = TRUE;
+}
+
+ /*! *******************************************************************
+ * \brief  Plays the song from the given position
+ * \param  u32Ms: position in the song (ms)
+ * \return The position the song is played from (ms)
+ * \note   Callable from the main loop, takes effect at the next audio block.
+ *         Starts from the last seek table entry not after u32Ms, found by
+ *         binary search. Without a seek table the song starts from its
+ *         beginning.
+ *********************************************************************/
+U32 Tracker_Seek( U32 u32Ms )
+{
+  // The module being played is not changed by the render context, unless a loaded one waits
+  S_TRACKER_MODULE const* psModule = ( TRUE == gbLoadRequest ) ? &gsLoadedModule : &gsModule;
+  U16 u16Low = 0u;
+  U16 u16High = psModule->u16SeekEntries;
+  U16 u16Middle;
+  U32 u32Time = 0u;
+
+  // Find the first entry after u32Ms
+  while( u16Low < u16High )
+  {
+    u16Middle = u16Low + ( u16High - u16Low )/2u;
+    if( ReadU32( &psModule->pu8Data[ psModule->u32SeekTable + sizeof( S_TRACKER_SEEK_ENTRY )*u16Middle ] ) <= u32Ms )
+    {
+      u16Low = u16Middle + 1u;
+    }
+    else
+    {
+      u16High = u16Middle;
+    }
+  }
+
+  if( 0u == u16Low )
+  {
+    gu16SeekEntry = TRACKER_SEEK_NONE;
+  }
+  else
+  {
+    u32Time = ReadU32( &psModule->pu8Data[ psModule->u32SeekTable + sizeof( S_TRACKER_SEEK_ENTRY )*( u16Low - 1u ) ] );
+    gu16SeekEntry = u16Low - 1u;
+  }
+  gbSeekRequest = TRUE;
+
+  return u32Time;
+}
+
+ /*! *******************************************************************
+ * \brief  Sets the tempo of the song
+ * \param  u32TempoQ16: multiplier of the original speed (Q16), limited to
+ *         TRACKER_TEMPO_MIN..TRACKER_TEMPO_MAX
+ * \return -
+ * \note   Callable from the main loop, takes effect at the next audio block.
+ *         The waits of the module are scaled on the fly, so the same module
+ *         can be played at any speed. The tempo is kept by Start and Seek.
+ *********************************************************************/
+void Tracker_SetTempo( U32 u32TempoQ16 )
+{
+  if( u32TempoQ16 < TRACKER_TEMPO_MIN )
+  {
+    u32TempoQ16 = TRACKER_TEMPO_MIN;
+  }
+  else if( u32TempoQ16 > TRACKER_TEMPO_MAX )
+  {
+    u32TempoQ16 = TRACKER_TEMPO_MAX;
+  }
+  gu32TempoRequest = u32TempoQ16;
+}
+
+ /*! *******************************************************************
+ * \brief  Returns the position in the song
+ * \param  -
+ * \return Position in the time of the module (ms), independent of the tempo
+ * \note   Callable from the main loop. Updated at every audio block, and
+ *         restarts from 0 when the song loops.
+ *********************************************************************/
+U32 Tracker_GetPosition( void )
+{
+  return gu32PositionMs;
+}
+
+ /*! *******************************************************************
+ * \brief  Tells that the flash of the streamed module is being written
+ * \param  -
+ * \return -
+ * \note   Callable from interrupts, before the flash is changed. A streamed
+ *         module is not played anymore, as it was validated before; it can
+ *         be loaded again when the writing is over.
+ *********************************************************************/
+void Tracker_InvalidateStream( void )
+{
+  gbStreamInvalid = TRUE;
+}
+
+ /*! *******************************************************************
+ * \brief  Plays the song
+ * \param  u16Frames: number of frames to be rendered
+ * \return Number of frames to render before the next call (at most u16Frames)
+ * \note   Called from the audio render context. Executes the instructions
+ *         that are due, so they take effect on the exact frame.
+ *********************************************************************/
+U16 Tracker_Tick( U16 u16Frames )
 {
-  S_TRACKER_INSTRUCTION* psInstructions = (S_TRACKER_INSTRUCTION*)&(gau8TrackerModule[ sizeof( S_MODULE_HEADER ) ]);
   E_TRACKER_OPCODE eOpCode;
   U32 u32Operand;
+  U32 u32Executed = 0u;
   U8  u8Channel;
-  
-  while( u32TimeMs >= gu32NextTimeCallMs )
+  U64 u64Remaining;
+
+  if( TRUE == gbLoadRequest )
+  {
+    gbLoadRequest = FALSE;
+    ReleaseChannels();
+    ResetChannels();
+    gsModule = gsLoadedModule;
+    SetInstruments();
+    RestartCode( gsModule.u32CodeStart );
+    gu32WaitFrames = 0u;
+    gu32WaitRemainder = 0u;
+    gu32SongMs = 0u;
+    gu32PositionMs = 0u;
+    gbPlaying = FALSE;
+  }
+  if( TRUE == gbStopRequest )
+  {
+    gbStopRequest = FALSE;
+    ReleaseChannels();
+    gbPlaying = FALSE;
+  }
+  if( TRUE == gbStartRequest )
+  {
+    gbStartRequest = FALSE;
+    ReleaseChannels();
+    ResetChannels();
+    RestartCode( gsModule.u32CodeStart );
+    gu32WaitFrames = 0u;
+    gu32WaitRemainder = 0u;
+    gu32SongMs = 0u;
+    gbPlaying = ( NULL != gsModule.pu8Data ) ? TRUE : FALSE;
+  }
+  if( TRUE == gbSeekRequest )
+  {
+    gbSeekRequest = FALSE;
+    ReleaseChannels();
+    ResetChannels();
+    gu32SongMs = 0u;
+    if( gu16SeekEntry < gsModule.u16SeekEntries )
+    {
+      RestoreSnapshot( gu16SeekEntry );
+      gu32SongMs = ReadU32( &gsModule.pu8Data[ gsModule.u32SeekTable + sizeof( S_TRACKER_SEEK_ENTRY )*gu16SeekEntry ] );
+    }
+    else
+    {
+      RestartCode( gsModule.u32CodeStart );
+    }
+    gu32WaitFrames = 0u;
+    gu32WaitRemainder = 0u;
+    gbPlaying = ( NULL != gsModule.pu8Data ) ? TRUE : FALSE;
+  }
+  if( ( TRUE == gbPlaying ) && ( TRUE == gbStreamInvalid ) && ( NULL != gsModule.pfRead ) )
+  {
+    // The byte code is not valid anymore, nothing is played until a module is loaded
+    ReleaseChannels();
+    gbPlaying = FALSE;
+  }
+  if( TRUE != gbPlaying )
   {
-    u8Channel = psInstructions[ gu32NextInstructionIdx ].u8Channel;
-    eOpCode = (E_TRACKER_OPCODE)psInstructions[ gu32NextInstructionIdx ].u8OpCode;
-    u32Operand = psInstructions[ gu32NextInstructionIdx ].u32Operand;
-    gu32NextInstructionIdx++;
+    return u16Frames;
+  }
+  UpdateTempo();
+
+  while( 0u == gu32WaitFrames )
+  {
+    if( u32Executed >= TRACKER_MAX_INSTRUCTIONS )
+    {
+      // A song without waits would lock up the audio
+      gu32WaitFrames = u16Frames;
+      break;
+    }
+    if( FALSE == IsCodeLoaded() )
+    {
+      // The song is held until the main loop reads the stream
+      gu32WaitFrames = u16Frames;
+      break;
+    }
+    FetchInstruction( &u8Channel, &eOpCode, &u32Operand );
+    gu32StreamReleased = gu32StreamRead/TRACKER_STREAM_BLOCK_SIZE;
+    u32Executed++;
     ExecuteOpCode( u8Channel, eOpCode, u32Operand );
   }
+
+  if( gu32WaitFrames < u16Frames )
+  {
+    u16Frames = (U16)gu32WaitFrames;
+  }
+  gu32WaitFrames -= u16Frames;
+
+  // Position at the end of the rendered frames: the end of the wait, less what is left of it
+  u64Remaining = ( (U64)gu32WaitFrames*( 1000u*gu32Tempo ) + gu32WaitRemainder )/( (U64)SAMPLE_RATE<<16u );
+  gu32PositionMs = ( u64Remaining < gu32SongMs ) ? ( gu32SongMs - (U32)u64Remaining ) : 0u;
+
+  return u16Frames;
 }
 
  /*! *******************************************************************
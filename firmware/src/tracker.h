@@ -22,6 +22,33 @@
 //--------------------------------------------------------------------------------------------------------/
 // Definitions
 //--------------------------------------------------------------------------------------------------------/
+#define TRACKER_NUMBER_OF_CHANNELS     (16u)  //!< Number of channels of the tracker, one note each
+#define TRACKER_PERCUSSION_CHANNEL      (9u)  //!< Channel of the percussion (MIDI channel 10), starts with the drum instrument
+
+#define TRACKER_MODULE_MAGIC           "TRK"  //!< First bytes of a module in the compact format (version 2 and later)
+#define TRACKER_MODULE_VERSION          (2u)  //!< Version of the compact module format
+#define TRACKER_CODE_OPCODE_SHIFT       (4u)  //!< Compact format: the opcode is in the upper nibble of the first byte of an instruction
+#define TRACKER_CODE_CHANNEL_MASK    (0x0Fu)  //!< Compact format: the channel is in the lower nibble of the first byte of an instruction
+#define TRACKER_CODE_END             (0x0Fu)  //!< Compact format: opcode nibble of TRACKER_OPCODE_END
+#define TRACKER_VARINT_MAX_BYTES        (5u)  //!< Longest variable length number: 7 bits per byte, 32 bits
+#define TRACKER_FLAG_SEEK_TABLE      (0x01u)  //!< Compact format: the module has a seek table
+#define TRACKER_FLAG_INSTRUMENTS     (0x02u)  //!< Compact format: the module defines instruments
+#define TRACKER_FLAG_PATTERNS        (0x04u)  //!< Compact format: the module has patterns, called from the song
+
+#define TRACKER_MAX_PATTERNS           (64u)  //!< Most patterns of a module
+#define TRACKER_CALL_DEPTH              (4u)  //!< Patterns can call other patterns, this deep
+#define TRACKER_MAX_PLAYS              (16u)  //!< A CALL plays its pattern at most this many times in a row
+
+#define TRACKER_TEMPO_NORMAL       (0x10000u)  //!< Tempo multiplier of the original speed of the song (Q16)
+#define TRACKER_TEMPO_MIN          (0x04000u)  //!< Slowest tempo: quarter speed
+#define TRACKER_TEMPO_MAX          (0x40000u)  //!< Fastest tempo: quadruple speed
+
+#define TRACKER_STREAM_BLOCK_SIZE     (128u)  //!< Streamed modules: bytes of the byte code read at once
+#define TRACKER_STREAM_BLOCKS           (8u)  //!< Streamed modules: blocks read ahead of the player, must be a power of two
+#define TRACKER_STREAM_TABLES_SIZE   (2048u)  //!< Streamed modules: the header, the tables and the snapshots are kept in RAM, up to this size
+
+//! \brief Operand of TRACKER_OPCODE_VIBRATO
+#define TRACKER_VIBRATO( u16Depth, u16Rate )  ( ( (U32)(u16Rate)<<16u ) | (U16)(u16Depth) )
 
 
 //--------------------------------------------------------------------------------------------------------/
@@ -34,14 +61,47 @@ typedef enum
   TRACKER_OPCODE_KEYON,             //!< Hit a note
   TRACKER_OPCODE_KEYOFF,            //!< Release a note
   TRACKER_OPCODE_WAITMS,            //!< Wait for a given time (ms)
-//  TRACKER_OPCODE_INSTRUMENTCHANGE,  //!< Change instrument to a different one
+  TRACKER_OPCODE_INSTRUMENTCHANGE,  //!< Change the instrument slot of the channel, from its next note
+  TRACKER_OPCODE_PITCHBEND,         //!< Bend the pitch of the channel: I16 in 1/SYNTH_PITCH_SEMITONE semitones
+  TRACKER_OPCODE_VIBRATO,           //!< Vibrato of the channel: depth (1/SYNTH_PITCH_SEMITONE semitones) in the lower, rate (1/100 Hz) in the upper half-word
+  TRACKER_OPCODE_INSTRUMENTBIND,    //!< Bind an instrument defined by the module to the channel, from its next note
+  TRACKER_OPCODE_CALL,              //!< Play a pattern of the module, repeated the number of times in the channel field plus 1
+  TRACKER_OPCODE_RETURN,            //!< End of a pattern
   TRACKER_OPCODE_END = 0xFFu        //!< End of track
 } E_TRACKER_OPCODE;
 
+//! \brief Result of loading a module
+typedef enum
+{
+  TRACKER_LOAD_OK = 0,            //!< The module is valid
+  TRACKER_LOAD_TOO_SHORT,         //!< The module is shorter than its header
+  TRACKER_LOAD_BAD_HEADER,        //!< Unknown version or flags
+  TRACKER_LOAD_BAD_OFFSET,        //!< The tables or the byte code are not within the module
+  TRACKER_LOAD_BAD_SEEK_TABLE,    //!< A seek table entry does not match the song, or its snapshot is bad
+  TRACKER_LOAD_BAD_INSTRUCTION,   //!< Unknown opcode, bad operand, or an instruction runs past the end
+  TRACKER_LOAD_NO_END,            //!< The song is not closed with END
+  TRACKER_LOAD_TOO_BIG,           //!< The tables of a streamed module do not fit in TRACKER_STREAM_TABLES_SIZE
+  TRACKER_LOAD_BAD_INSTRUMENT,    //!< An instrument of the module has an unknown voice or curve, or a bad wavetable
+} E_TRACKER_LOAD_RESULT;
+
+//! \brief Voice types of the instruments defined by a module
+typedef enum
+{
+  TRACKER_VOICE_SINE = 0u,   //!< The sine wavetable of the synthesizer
+  TRACKER_VOICE_SQUARE,      //!< The band-limited square wavetable of the synthesizer
+  TRACKER_VOICE_SAW,         //!< The band-limited sawtooth wavetable of the synthesizer
+  TRACKER_VOICE_WAVETABLE,   //!< A wavetable in the module
+  TRACKER_VOICE_NOISE,       //!< Shift register noise
+  TRACKER_VOICES             //!< Number of voice types
+} E_TRACKER_VOICE;
+
+//! \brief Reads a part of a streamed module, like SPIFlash_Read_Polling()
+typedef void( *pTrackerReadFunction )( U32 u32Address, U8* pu8Buffer, U32 u32Length );
+
 PACKED_TYPES_BEGIN
 
-//! \brief Tracker module header format
-//! \note  Should be aligned to a half-word address!
+//! \brief Tracker module header format (version 1)
+//! \note  Should be aligned to a half-word address! Followed by S_TRACKER_INSTRUCTIONs.
 typedef PACKED_STRUCT struct
 {
   U16 u16MsPerBeat;                            //!< Timing information ("BPM")
@@ -50,7 +110,40 @@ typedef PACKED_STRUCT struct
   U8  u8NumberOfNotes;                         //!< Number of musical notes used
 } S_MODULE_HEADER;
 
-//! \brief Tracker instruction
+//! \brief Header of a module in the compact format
+//! \note  The note table follows the header: u8NumberOfNotes phase increases,
+//!        32-bit little endian each. Then comes the byte code, each instruction is
+//!        a byte of ( opcode<<TRACKER_CODE_OPCODE_SHIFT ) | channel, and its operand:
+//!        - KEYON, INSTRUMENTCHANGE, INSTRUMENTBIND, CALL: one byte, index of the note table,
+//!          the instrument slot, the index of the instrument of the module, or of the pattern
+//!        - WAITMS, VIBRATO: variable length number, 7 bits per byte from the lowest,
+//!          the highest bit of a byte is set if more bytes follow
+//!        - PITCHBEND: variable length number of the zigzag coded value: ( n<<1 ) ^ ( n>>31 )
+//!        - NOP, KEYOFF, RETURN, END (TRACKER_CODE_END): no operand
+//!        The channel field of a CALL is the number of times the pattern is repeated
+//!        after it is played once, so a CALL is also a loop.
+//!        With TRACKER_FLAG_INSTRUMENTS the note table is followed by the instruments:
+//!        their number (at most SOUNDSYNTH_MODULE_INSTRUMENTS) in a byte, then the
+//!        S_TRACKER_INSTRUMENTs.
+//!        With TRACKER_FLAG_SEEK_TABLE the seek table comes next: a 16-bit little
+//!        endian number of entries, the S_TRACKER_SEEK_ENTRYs by increasing time.
+//!        With TRACKER_FLAG_PATTERNS the pattern table follows: the number of patterns
+//!        (at most TRACKER_MAX_PATTERNS) in a byte, then their 16-bit little endian
+//!        offsets. A pattern is byte code before the byte code of the song, closed by
+//!        RETURN; it may call the patterns before it in the table.
+//!        The snapshots come after the tables. A snapshot is byte code that restores
+//!        the channels (instruments, modulation, sounding notes), closed by END.
+//!        Everything before the byte code stays in RAM when the module is streamed.
+typedef PACKED_STRUCT struct
+{
+  U8  au8Magic[ 3u ];                          //!< TRACKER_MODULE_MAGIC
+  U8  u8Version;                               //!< TRACKER_MODULE_VERSION
+  U16 u16CodeOffset;                           //!< Offset of the byte code from the beginning of the module
+  U8  u8NumberOfNotes;                         //!< Number of entries in the note table
+  U8  u8Flags;                                 //!< TRACKER_FLAG_..., the other bits are 0
+} S_MODULE_HEADER_V2;
+
+//! \brief Tracker instruction (version 1)
 typedef PACKED_STRUCT struct
 {
   U8  u8Channel;   //!< Index of the channel the instruction is performed at
@@ -58,6 +151,30 @@ typedef PACKED_STRUCT struct
   U32 u32Operand;  //!< Operand of the instruction
 } S_TRACKER_INSTRUCTION;
 
+//! \brief Instrument defined by a compact module, little endian
+//! \note  The times are converted to envelope steps when the module is loaded.
+//!        A wavetable in the module holds one period of 16-bit little endian
+//!        samples, at an even offset before the byte code.
+typedef PACKED_STRUCT struct
+{
+  U8  u8Voice;            //!< Voice type according to E_TRACKER_VOICE
+  U8  u8Curve;            //!< Shape of the envelope stages: 0 linear, 1 exponential
+  U16 u16Reference;       //!< TRACKER_VOICE_WAVETABLE: offset of the wavetable; TRACKER_VOICE_NOISE: length of the shift register
+  U16 u16WaveTableSize;   //!< TRACKER_VOICE_WAVETABLE: samples in the wavetable, a power of two up to SYNTH_WAVETABLE_SIZE
+  U16 u16AttackMs;        //!< Attack time (ms)
+  U16 u16DecayMs;         //!< Decay time (ms)
+  U16 u16Sustain;         //!< Sustain level, 0xFFFF is full scale
+  U16 u16ReleaseMs;       //!< Release time (ms)
+} S_TRACKER_INSTRUMENT;
+
+//! \brief Entry of the seek table of a compact module, little endian
+typedef PACKED_STRUCT struct
+{
+  U32 u32TimeMs;          //!< Song position of the entry
+  U32 u32CodeOffset;      //!< Offset of the instruction at that position from the beginning of the module
+  U32 u32SnapshotOffset;  //!< Offset of the snapshot of the channels from the beginning of the module
+} S_TRACKER_SEEK_ENTRY;
+
 PACKED_TYPES_END
 
 
@@ -69,8 +186,24 @@ PACKED_TYPES_END
 //--------------------------------------------------------------------------------------------------------/
 // Interface functions
 //--------------------------------------------------------------------------------------------------------/
-void Tracker_Init( U32 u32TimeMs );
-void Tracker_Play( U32 u32TimeMs );
+void Tracker_Init( void );
+
+// Functions that are callable from main loop
+void Tracker_Start( void );
+void Tracker_Stop( void );
+E_TRACKER_LOAD_RESULT Tracker_Load( U8 const* pu8Module, U32 u32Size );
+E_TRACKER_LOAD_RESULT Tracker_LoadLinked( void );
+E_TRACKER_LOAD_RESULT Tracker_LoadStream( pTrackerReadFunction pfRead, U32 u32Address, U32 u32Size );
+void Tracker_Service( void );
+U32  Tracker_Seek( U32 u32Ms );
+void Tracker_SetTempo( U32 u32TempoQ16 );
+U32  Tracker_GetPosition( void );
+
+// Functions that are callable from interrupts
+void Tracker_InvalidateStream( void );
+
+// Functions that are called from the audio render context
+U16 Tracker_Tick( U16 u16Frames );
 
 
 #endif  // TRACKER_H
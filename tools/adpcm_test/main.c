@@ -0,0 +1,189 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+#include "platform.h"
+#include "adpcm.h"
+
+#define ADPCM_TEST_VECTOR_BYTES        (16u)  //!< Encoded bytes of a short vector
+#define ADPCM_TEST_VECTOR_SAMPLES  ( 1u + 2u*ADPCM_TEST_VECTOR_BYTES )  //!< Samples of a short vector: the header sample and two per byte
+#define ADPCM_TEST_BLOCKS               (4u)  //!< Blocks of the long vector
+#define ADPCM_TEST_SAMPLES  ( 3u*ADPCM_BLOCK_SAMPLES + 100u )  //!< Samples of the long vector, the last block is partial
+#define ADPCM_TEST_HASH        (0xD9E2E6F5u)  //!< FNV-1a hash of the reference decoding of the long vector
+#define ADPCM_TEST_SEED        (0x2545F491u)  //!< Seed of the data of the long vector
+#define ADPCM_TEST_MAX_CHUNK          (300u)  //!< Largest number of samples decoded at once
+
+//! \brief A block with a few bytes of data, and its reference decoding
+typedef struct
+{
+  I16 i16First;                                  //!< Sample in the block header
+  U8  u8StepIndex;                               //!< Step index in the block header
+  U8  au8Data[ ADPCM_TEST_VECTOR_BYTES ];        //!< Encoded samples, low nibble first
+  I16 ai16Expected[ ADPCM_TEST_VECTOR_SAMPLES ]; //!< The header sample, then the decoded nibbles
+} S_ADPCM_VECTOR;
+
+//! \brief Reference vectors
+//! \note  Decoded by the IMA/DVI reference decoder of Jack Jansen (audioop.adpcm2lin
+//!        of CPython), which shares no code with adpcm.c. That decoder takes the high
+//!        nibble first, so it was given the bytes with their nibbles swapped.
+static S_ADPCM_VECTOR const gcasVectors[] =
+{
+  // All 16 codes from the smallest step
+  { 0, 0u,
+    { 0x10u, 0x32u, 0x54u, 0x76u, 0x98u, 0xBAu, 0xDCu, 0xFEu, 0x10u, 0x32u, 0x54u, 0x76u, 0x98u, 0xBAu, 0xDCu, 0xFEu },
+    { 0, 0, 1, 4, 8, 15, 27, 47, 88, 82, 66,
+      41, 10, -28, -84, -181, -380, -352, -274, -156, -6, 170,
+      430, 882, 1807, 1675, 1315, 768, 72, -742, -1946, -4029, -8289 } },
+  // Largest positive codes, saturates at 32767
+  { 30000, 20u,
+    { 0x77u, 0x77u, 0x77u, 0x77u, 0x77u, 0x77u, 0x77u, 0x77u, 0x77u, 0x77u, 0x77u, 0x77u, 0x77u, 0x77u, 0x77u, 0x77u },
+    { 30000, 30093, 30292, 30722, 31647, 32767, 32767, 32767, 32767, 32767, 32767,
+      32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+      32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767 } },
+  // Largest negative codes, saturates at -32768
+  { -30000, 40u,
+    { 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu },
+    { -30000, -30631, -31988, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+      -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+      -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768 } },
+  // Small codes from the largest step, the step shrinks
+  { 1234, 88u,
+    { 0x00u, 0x88u, 0x31u, 0xB9u, 0x00u, 0x88u, 0x31u, 0xB9u, 0x00u, 0x88u, 0x31u, 0xB9u, 0x00u, 0x88u, 0x31u, 0xB9u },
+    { 1234, 5329, 9053, 5668, 2591, 10985, 28790, 21853, 7138, 9049, 10786,
+      9207, 7772, 11687, 19992, 16757, 9894, 10785, 11595, 10859, 10190, 12015,
+      15889, 14380, 11178, 11593, 11971, 11628, 11316, 12168, 13975, 13272, 11780 } },
+  // Step index held at 0
+  { -1, 0u,
+    { 0x08u, 0x80u, 0x1Au, 0x2Bu, 0x08u, 0x80u, 0x1Au, 0x2Bu, 0x08u, 0x80u, 0x1Au, 0x2Bu, 0x08u, 0x80u, 0x1Au, 0x2Bu },
+    { -1, -1, -1, -1, -1, -4, -3, -7, -4, -4, -4,
+      -4, -4, -7, -6, -10, -7, -7, -7, -7, -7, -10,
+      -9, -13, -10, -10, -10, -10, -10, -13, -12, -16, -13 } },
+};
+
+static U8  gau8Blocks[ ADPCM_TEST_BLOCKS*ADPCM_BLOCK_SIZE ];  //!< Blocks of the long vector
+static U32 gu32Random = ADPCM_TEST_SEED;  //!< State of the xorshift generator
+
+/*! *******************************************************************
+ * \brief  32-bit xorshift generator, the same data on every host
+ * \param  -
+ * \return Next random number
+ *********************************************************************/
+static U32 Random( void )
+{
+  gu32Random ^= gu32Random<<13;
+  gu32Random ^= gu32Random>>17;
+  gu32Random ^= gu32Random<<5;
+  return gu32Random;
+}
+
+/*! *******************************************************************
+ * \brief  Decodes a whole sample in chunks of random size
+ * \param  psSample: the encoded sample
+ * \param  pi16Output: output, psSample->u32Samples samples
+ * \return FALSE if the decoder stopped early
+ *********************************************************************/
+static BOOL DecodeAll( S_ADPCM_SAMPLE const* psSample, I16* pi16Output )
+{
+  S_ADPCM_DECODER sDecoder;
+  U32 u32Index = 0u;
+  U16 u16Decoded;
+
+  ADPCM_Start( &sDecoder, psSample );
+  while( u32Index < psSample->u32Samples )
+  {
+    u16Decoded = ADPCM_Decode( &sDecoder, &pi16Output[ u32Index ], (U16)( 1u + Random() % ADPCM_TEST_MAX_CHUNK ) );
+    if( 0u == u16Decoded )
+    {
+      return FALSE;
+    }
+    u32Index += u16Decoded;
+  }
+  // At the end nothing more comes
+  return ( 0u == ADPCM_Decode( &sDecoder, pi16Output, 1u ) ) ? TRUE : FALSE;
+}
+
+/*! *******************************************************************
+ * \brief  FNV-1a hash of the samples, little endian
+ * \param  pi16Samples: the samples
+ * \param  u32Samples: number of samples
+ * \return The hash
+ *********************************************************************/
+static U32 Hash( I16 const* pi16Samples, U32 u32Samples )
+{
+  U32 u32Hash = 0x811C9DC5u;
+  U32 u32Index;
+
+  for( u32Index = 0u; u32Index < u32Samples; u32Index++ )
+  {
+    u32Hash = ( u32Hash ^ ( (U16)pi16Samples[ u32Index ] & 0xFFu ) )*0x01000193u;
+    u32Hash = ( u32Hash ^ ( (U16)pi16Samples[ u32Index ]>>8u ) )*0x01000193u;
+  }
+  return u32Hash;
+}
+
+int main( void )
+{
+  static I16 ai16Output[ ADPCM_TEST_SAMPLES ];
+  U8   au8Block[ ADPCM_BLOCK_SIZE ];
+  S_ADPCM_SAMPLE sSample;
+  S_ADPCM_VECTOR const* psVector;
+  U32  u32Vector;
+  U32  u32Index;
+  U32  u32Hash;
+  BOOL bFailed = FALSE;
+
+  printf( "ADPCM_TEST by Hekk_Elek[Strlen]\n" );
+  printf( "Build time: %s, %s\n\n", __DATE__, __TIME__ );
+
+  // Short vectors: one block, the samples after the vector are not decoded
+  for( u32Vector = 0u; u32Vector < sizeof( gcasVectors )/sizeof( gcasVectors[ 0u ] ); u32Vector++ )
+  {
+    psVector = &gcasVectors[ u32Vector ];
+    memset( au8Block, 0xA5, sizeof( au8Block ) );
+    au8Block[ 0u ] = (U8)psVector->i16First;
+    au8Block[ 1u ] = (U8)( (U16)psVector->i16First>>8u );
+    au8Block[ 2u ] = psVector->u8StepIndex;
+    memcpy( &au8Block[ ADPCM_BLOCK_HEADER_SIZE ], psVector->au8Data, ADPCM_TEST_VECTOR_BYTES );
+    sSample.pu8Data = au8Block;
+    sSample.u32Samples = ADPCM_TEST_VECTOR_SAMPLES;
+    if( FALSE == DecodeAll( &sSample, ai16Output ) )
+    {
+      printf( "Vector %u: the decoder stopped early\n", u32Vector );
+      bFailed = TRUE;
+      continue;
+    }
+    for( u32Index = 0u; u32Index < ADPCM_TEST_VECTOR_SAMPLES; u32Index++ )
+    {
+      if( ai16Output[ u32Index ] != psVector->ai16Expected[ u32Index ] )
+      {
+        printf( "Vector %u: sample %u is %d, expected: %d\n", u32Vector, u32Index, ai16Output[ u32Index ], psVector->ai16Expected[ u32Index ] );
+        bFailed = TRUE;
+        break;
+      }
+    }
+  }
+  printf( "Short vectors: %u\n", (U32)( sizeof( gcasVectors )/sizeof( gcasVectors[ 0u ] ) ) );
+
+  // Long vector: random blocks, every one restarts the decoder from its header
+  gu32Random = ADPCM_TEST_SEED;
+  for( u32Index = 0u; u32Index < sizeof( gau8Blocks ); u32Index++ )
+  {
+    gau8Blocks[ u32Index ] = (U8)Random();
+  }
+  for( u32Index = 0u; u32Index < ADPCM_TEST_BLOCKS; u32Index++ )
+  {
+    gau8Blocks[ u32Index*ADPCM_BLOCK_SIZE + 2u ] %= ADPCM_STEP_INDEX_MAX + 1u;
+  }
+  sSample.pu8Data = gau8Blocks;
+  sSample.u32Samples = ADPCM_TEST_SAMPLES;
+  memset( ai16Output, 0, sizeof( ai16Output ) );
+  u32Hash = ( TRUE == DecodeAll( &sSample, ai16Output ) ) ? Hash( ai16Output, ADPCM_TEST_SAMPLES ) : 0u;
+  printf( "Long vector: hash %08X, expected: %08X\n", u32Hash, ADPCM_TEST_HASH );
+  if( ADPCM_TEST_HASH != u32Hash )
+  {
+    bFailed = TRUE;
+  }
+
+  printf( ( TRUE == bFailed ) ? "FAILED\n" : "PASSED\n" );
+  return ( TRUE == bFailed ) ? -1 : 0;
+}
@@ -0,0 +1,289 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "types.h"
+#include "adpcm.h"
+
+/*! *******************************************************************
+ * \brief  Reads a 16-bit PCM WAV file
+ * \param  psFile: input file
+ * \param  pu32Samples: number of samples read
+ * \param  pu32SampleRate: sampling rate of the file
+ * \return Mono samples (the left channel of stereo files), or NULL on error
+ *********************************************************************/
+static I16* ReadWav( FILE* psFile, U32* pu32Samples, U32* pu32SampleRate )
+{
+  U8   au8Header[ 12u ];
+  U8   au8Chunk[ 8u ];
+  U8   au8Format[ 16u ];
+  U32  u32ChunkSize;
+  U32  u32Channels = 0u;
+  U32  u32Index;
+  U8*  pu8Data;
+  I16* pi16Samples;
+
+  if( ( 1u != fread( au8Header, sizeof( au8Header ), 1u, psFile ) ) || ( 0 != memcmp( au8Header, "RIFF", 4u ) ) || ( 0 != memcmp( &au8Header[ 8u ], "WAVE", 4u ) ) )
+  {
+    return NULL;
+  }
+
+  while( 1u == fread( au8Chunk, sizeof( au8Chunk ), 1u, psFile ) )
+  {
+    u32ChunkSize = au8Chunk[ 4u ] | ( au8Chunk[ 5u ]<<8u ) | ( au8Chunk[ 6u ]<<16u ) | ( (U32)au8Chunk[ 7u ]<<24u );
+    if( 0 == memcmp( au8Chunk, "fmt ", 4u ) )
+    {
+      if( ( u32ChunkSize < sizeof( au8Format ) ) || ( 1u != fread( au8Format, sizeof( au8Format ), 1u, psFile ) ) )
+      {
+        return NULL;
+      }
+      fseek( psFile, u32ChunkSize - sizeof( au8Format ) + ( u32ChunkSize & 1u ), SEEK_CUR );
+      u32Channels = au8Format[ 2u ] | ( au8Format[ 3u ]<<8u );
+      *pu32SampleRate = au8Format[ 4u ] | ( au8Format[ 5u ]<<8u ) | ( au8Format[ 6u ]<<16u ) | ( (U32)au8Format[ 7u ]<<24u );
+      if( ( 1u != ( au8Format[ 0u ] | ( au8Format[ 1u ]<<8u ) ) ) || ( 16u != ( au8Format[ 14u ] | ( au8Format[ 15u ]<<8u ) ) ) || ( 0u == u32Channels ) )
+      {
+        printf( "Only 16-bit PCM files are supported!\n" );
+        return NULL;
+      }
+    }
+    else if( ( 0 == memcmp( au8Chunk, "data", 4u ) ) && ( 0u != u32Channels ) )
+    {
+      pu8Data = malloc( u32ChunkSize );
+      *pu32Samples = u32ChunkSize/( 2u*u32Channels );
+      pi16Samples = malloc( ( *pu32Samples + 1u )*sizeof( I16 ) );
+      if( ( NULL == pu8Data ) || ( NULL == pi16Samples ) || ( 1u != fread( pu8Data, u32ChunkSize, 1u, psFile ) ) )
+      {
+        return NULL;
+      }
+      for( u32Index = 0u; u32Index < *pu32Samples; u32Index++ )
+      {
+        pi16Samples[ u32Index ] = (I16)( pu8Data[ 2u*u32Channels*u32Index ] | ( pu8Data[ 2u*u32Channels*u32Index + 1u ]<<8u ) );
+      }
+      free( pu8Data );
+      return pi16Samples;
+    }
+    else
+    {
+      fseek( psFile, u32ChunkSize + ( u32ChunkSize & 1u ), SEEK_CUR );
+    }
+  }
+
+  return NULL;
+}
+
+/*! *******************************************************************
+ * \brief  Encodes samples into IMA-ADPCM blocks
+ * \param  pi16Samples: input samples
+ * \param  u32Samples: number of samples
+ * \param  pu8Blocks: output, whole blocks, the last one is padded with zeros
+ * \param  pi16Decoded: output, the samples as the decoder will reconstruct them
+ * \return -
+ *********************************************************************/
+static void Encode( I16 const* pi16Samples, U32 u32Samples, U8* pu8Blocks, I16* pi16Decoded )
+{
+  U32 u32Index;
+  U32 u32BlockSample = 0u;
+  U8* pu8Data = pu8Blocks;
+  I32 i32Predictor = 0;
+  I32 i32StepIndex = 0;
+  I32 i32Difference;
+  I32 i32Step;
+  U8  u8Nibble;
+  BOOL bHighNibble = FALSE;
+
+  for( u32Index = 0u; u32Index < u32Samples; u32Index++ )
+  {
+    if( 0u == u32BlockSample )
+    {
+      // Block header: the first sample is stored as it is, the step index continues
+      i32Predictor = pi16Samples[ u32Index ];
+      *pu8Data++ = (U8)i32Predictor;
+      *pu8Data++ = (U8)( (U16)i32Predictor>>8u );
+      *pu8Data++ = (U8)i32StepIndex;
+      *pu8Data++ = 0u;
+      bHighNibble = FALSE;
+    }
+    else
+    {
+      i32Difference = pi16Samples[ u32Index ] - i32Predictor;
+      i32Step = gcau16ADPCMStepTable[ i32StepIndex ];
+      u8Nibble = 0u;
+      if( i32Difference < 0 )
+      {
+        u8Nibble = 8u;
+        i32Difference = -i32Difference;
+      }
+      if( i32Difference >= i32Step )
+      {
+        u8Nibble |= 4u;
+        i32Difference -= i32Step;
+      }
+      if( i32Difference >= ( i32Step>>1 ) )
+      {
+        u8Nibble |= 2u;
+        i32Difference -= i32Step>>1;
+      }
+      if( i32Difference >= ( i32Step>>2 ) )
+      {
+        u8Nibble |= 1u;
+      }
+
+      // Track the decoder, so the errors do not accumulate
+      i32Predictor = ADPCM_Step( i32Predictor, i32StepIndex, u8Nibble );
+      i32StepIndex += gcai8ADPCMIndexTable[ u8Nibble ];
+      i32StepIndex = ( i32StepIndex < 0 ) ? 0 : ( ( i32StepIndex > (I32)ADPCM_STEP_INDEX_MAX ) ? (I32)ADPCM_STEP_INDEX_MAX : i32StepIndex );
+
+      if( TRUE == bHighNibble )
+      {
+        *pu8Data++ |= u8Nibble<<4u;
+        bHighNibble = FALSE;
+      }
+      else
+      {
+        *pu8Data = u8Nibble;
+        bHighNibble = TRUE;
+      }
+    }
+    pi16Decoded[ u32Index ] = (I16)i32Predictor;
+
+    if( ++u32BlockSample == ADPCM_BLOCK_SAMPLES )
+    {
+      u32BlockSample = 0u;
+    }
+  }
+}
+
+/*! *******************************************************************
+ * \brief  Writes the blocks as C source
+ * \param  psFile: output file
+ * \param  pcName: name of the sample
+ * \param  pcSource: name of the input file
+ * \param  pu8Blocks: encoded blocks
+ * \param  u32Blocks: number of blocks
+ * \param  u32Samples: number of samples
+ * \return -
+ *********************************************************************/
+static void ExportC( FILE* psFile, char const* pcName, char const* pcSource, U8 const* pu8Blocks, U32 u32Blocks, U32 u32Samples )
+{
+  U32 u32Index;
+
+  fprintf( psFile, "//! \\brief %s sample: %u samples, encoded by tools/adpcmenc from %s\n", pcName, u32Samples, pcSource );
+  fprintf( psFile, "static const U8 gcau8%sBlocks[ %uu ] =\n{\n", pcName, u32Blocks*ADPCM_BLOCK_SIZE );
+  for( u32Index = 0u; u32Index < u32Blocks*ADPCM_BLOCK_SIZE; u32Index++ )
+  {
+    fprintf( psFile, "%s0x%02X,%s", ( 0u == ( u32Index % 16u ) ) ? "  " : "", pu8Blocks[ u32Index ], ( 15u == ( u32Index % 16u ) ) ? "\n" : " " );
+  }
+  fprintf( psFile, "};\n\n" );
+  fprintf( psFile, "//! \\brief %s sample in the internal flash\n", pcName );
+  fprintf( psFile, "const S_ADPCM_SAMPLE gcs%sSample =\n{\n  gcau8%sBlocks,\n  %uu\n};\n", pcName, pcName, u32Samples );
+}
+
+int main( int argc, char *argv[] )
+{
+  char  gcau8DefaultOutputFileName[] = "sample.c";
+  char  gcau8DefaultName[] = "Sample";
+  char* au8InputFileName;
+  char* au8OutputFileName = gcau8DefaultOutputFileName;
+  char* au8Name = gcau8DefaultName;
+  FILE  *psInputFile, *psOutputFile;
+  I16*  pi16Samples;
+  I16*  pi16Decoded;
+  I16*  pi16Check;
+  U8*   pu8Blocks;
+  U32   u32Samples;
+  U32   u32SampleRate = 0u;
+  U32   u32Blocks;
+  U32   u32Index;
+  U32   u32Repeat;
+  double dSignal = 0.0;
+  double dNoise = 0.0;
+  clock_t sStart;
+  S_ADPCM_SAMPLE sSample;
+  S_ADPCM_DECODER sDecoder;
+
+  printf( "ADPCMENC by Hekk_Elek[Strlen]\n" );
+  printf( "Build time: %s, %s\n\n", __DATE__, __TIME__ );
+
+  if( ( argc < 2 ) || ( argc > 4 ) )
+  {
+    printf( "Usage: adpcmenc inputfile.wav [outputfile.c] [name]\n" );
+    return -2;
+  }
+  au8InputFileName = argv[1];
+  if( argc >= 3 )
+  {
+    au8OutputFileName = argv[2];
+  }
+  if( argc == 4 )
+  {
+    au8Name = argv[3];
+  }
+
+  printf( "Input file: %s\n", au8InputFileName );
+  printf( "Output file: %s\n", au8OutputFileName );
+
+  psInputFile = fopen( au8InputFileName, "rb" );
+  if( NULL == psInputFile )
+  {
+    printf( "Can not open input file!\n" );
+    return -1;
+  }
+  pi16Samples = ReadWav( psInputFile, &u32Samples, &u32SampleRate );
+  fclose( psInputFile );
+  if( ( NULL == pi16Samples ) || ( 0u == u32Samples ) )
+  {
+    printf( "Invalid WAV file!\n" );
+    return -1;
+  }
+
+  u32Blocks = ( u32Samples + ADPCM_BLOCK_SAMPLES - 1u )/ADPCM_BLOCK_SAMPLES;
+  pu8Blocks = calloc( u32Blocks, ADPCM_BLOCK_SIZE );
+  pi16Decoded = malloc( u32Samples*sizeof( I16 ) );
+  pi16Check = malloc( u32Samples*sizeof( I16 ) );
+  if( ( NULL == pu8Blocks ) || ( NULL == pi16Decoded ) || ( NULL == pi16Check ) )
+  {
+    printf( "Out of memory!\n" );
+    return -1;
+  }
+  Encode( pi16Samples, u32Samples, pu8Blocks, pi16Decoded );
+
+  // The firmware decoder has to reproduce the reconstruction of the encoder bit by bit
+  // (they share ADPCM_Step: tools/adpcm_test checks the decoder against an independent one)
+  sSample.pu8Data = pu8Blocks;
+  sSample.u32Samples = u32Samples;
+  sStart = clock();
+  for( u32Repeat = 0u; u32Repeat < 100u; u32Repeat++ )
+  {
+    ADPCM_Start( &sDecoder, &sSample );
+    for( u32Index = 0u; u32Index < u32Samples; )
+    {
+      u32Index += ADPCM_Decode( &sDecoder, &pi16Check[ u32Index ], ( u32Samples - u32Index > 256u ) ? 256u : (U16)( u32Samples - u32Index ) );
+    }
+  }
+  for( u32Index = 0u; u32Index < u32Samples; u32Index++ )
+  {
+    if( pi16Check[ u32Index ] != pi16Decoded[ u32Index ] )
+    {
+      printf( "Decoder mismatch at sample %u: %d instead of %d!\n", u32Index, pi16Check[ u32Index ], pi16Decoded[ u32Index ] );
+      return -1;
+    }
+    dSignal += (double)pi16Samples[ u32Index ]*pi16Samples[ u32Index ];
+    dNoise += (double)( pi16Samples[ u32Index ] - pi16Decoded[ u32Index ] )*( pi16Samples[ u32Index ] - pi16Decoded[ u32Index ] );
+  }
+
+  printf( "Samples: %u at %u Hz, %u blocks, %u bytes (16-bit PCM: %u bytes)\n", u32Samples, u32SampleRate, u32Blocks, u32Blocks*ADPCM_BLOCK_SIZE, 2u*u32Samples );
+  printf( "Decoder check passed, SNR: %.1f dB, host decode time: %.2f ns/sample\n", 10.0*log10( dSignal/( ( dNoise > 0.0 ) ? dNoise : 1.0 ) ),
+          1e9*(double)( clock() - sStart )/CLOCKS_PER_SEC/( 100.0*u32Samples ) );
+
+  psOutputFile = fopen( au8OutputFileName, "w" );
+  if( NULL == psOutputFile )
+  {
+    printf( "Can not open output file!\n" );
+    return -1;
+  }
+  ExportC( psOutputFile, au8Name, au8InputFileName, pu8Blocks, u32Blocks, u32Samples );
+  fclose( psOutputFile );
+
+  return 0;
+}
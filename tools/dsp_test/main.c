@@ -0,0 +1,189 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "types.h"
+
+#define DSP_TEST_DEFAULT_ITERATIONS  (50000000u)  //!< Random operand pairs without the -n option
+#define DSP_TEST_MAX_REPORTED              (10u)  //!< Mismatches printed of each instruction
+
+//! \brief Operands at the edges: INT16_MIN/MAX, -1, 0x8000 halves, the saturation limits and the 32-bit extremes
+static U32 const gcau32EdgeOperands[] =
+{
+  0x00000000u, 0x00000001u, 0xFFFFFFFFu, 0x00007FFFu, 0x00008000u, 0x00008001u, 0x0000FFFFu, 0x00010000u,
+  0xFFFF7FFFu, 0xFFFF8000u, 0xFFFF8001u, 0xFFFF0000u, 0x7FFF0000u, 0x80000000u, 0x80008000u, 0x7FFFFFFFu,
+  0x7FFF7FFFu, 0x80007FFFu, 0x7FFF8000u, 0x12348000u, 0x1234FFFFu, 0xFFFE0001u, 0x00017FFFu, 0x3FFFFFFFu,
+  0xC0000000u, 0x00004000u, 0xFFFFC000u,
+};
+
+static U32 gu32Random = 0x2545F491u;  //!< State of the xorshift generator
+static U32 gu32Mismatches;            //!< Mismatches of the instruction being tested
+
+/*! *******************************************************************
+ * \brief  32-bit xorshift generator, the same operands on every host
+ * \param  -
+ * \return Next random number
+ *********************************************************************/
+static U32 Random( void )
+{
+  gu32Random ^= gu32Random<<13;
+  gu32Random ^= gu32Random>>17;
+  gu32Random ^= gu32Random<<5;
+  return gu32Random;
+}
+
+/*! *******************************************************************
+ * \brief  SMULWB as the ARMv7-M Architecture Reference Manual defines it
+ * \param  u32W: Rn, the 32-bit signed operand
+ * \param  u32H: Rm, its bottom halfword is the signed operand
+ * \return Rd: bits 47..16 of the 48-bit product
+ * \note   Computed from the magnitudes in unsigned arithmetic, so neither
+ *         signed shifts nor the casts of platform.h are used.
+ *********************************************************************/
+static U32 ReferenceSmulwb( U32 u32W, U32 u32H )
+{
+  BOOL bNegative = FALSE;
+  U64  u64Magnitude;
+  U64  u64Product;
+  U32  u32Low = u32H & 0xFFFFu;
+
+  if( 0u != ( u32W & 0x80000000u ) )
+  {
+    u32W = ~u32W + 1u;
+    bNegative = ( TRUE == bNegative ) ? FALSE : TRUE;
+  }
+  if( 0u != ( u32Low & 0x8000u ) )
+  {
+    u32Low = 0x10000u - u32Low;
+    bNegative = ( TRUE == bNegative ) ? FALSE : TRUE;
+  }
+  u64Magnitude = (U64)u32W*u32Low;  // 0x80000000 stays its own magnitude
+  u64Product = ( TRUE == bNegative ) ? ( ~u64Magnitude + 1u ) : u64Magnitude;
+  return (U32)( u64Product>>16 );
+}
+
+/*! *******************************************************************
+ * \brief  SSAT Rd, #16, Rn as the ARMv7-M Architecture Reference Manual defines it
+ * \param  u32Value: Rn
+ * \return Rd
+ * \note   The value fits when bits 31..15 are all the same, otherwise the
+ *         sign bit selects the limit.
+ *********************************************************************/
+static U32 ReferenceSsat16( U32 u32Value )
+{
+  U32 u32Top = u32Value & 0xFFFF8000u;
+
+  if( ( 0u == u32Top ) || ( 0xFFFF8000u == u32Top ) )
+  {
+    return u32Value;
+  }
+  return ( 0u != ( u32Value & 0x80000000u ) ) ? 0xFFFF8000u : 0x00007FFFu;
+}
+
+/*! *******************************************************************
+ * \brief  Compares DSP_SMULWB with the reference on one operand pair
+ * \param  u32W: 32-bit operand
+ * \param  u32H: halfword operand, the top half must be ignored
+ * \return -
+ *********************************************************************/
+static void CheckSmulwb( U32 u32W, U32 u32H )
+{
+  U32 u32Expected = ReferenceSmulwb( u32W, u32H );
+  U32 u32Result = (U32)DSP_SMULWB( (I32)u32W, u32H );
+
+  if( u32Result != u32Expected )
+  {
+    if( gu32Mismatches < DSP_TEST_MAX_REPORTED )
+    {
+      printf( "  SMULWB( 0x%08X, 0x%08X ): 0x%08X, expected: 0x%08X\n", u32W, u32H, u32Result, u32Expected );
+    }
+    gu32Mismatches++;
+  }
+}
+
+/*! *******************************************************************
+ * \brief  Compares DSP_SSAT16 with the reference on one operand
+ * \param  u32Value: operand
+ * \return -
+ *********************************************************************/
+static void CheckSsat16( U32 u32Value )
+{
+  U32 u32Expected = ReferenceSsat16( u32Value );
+  I32 i32Value = (I32)u32Value;
+  U32 u32Result = (U32)DSP_SSAT16( i32Value );
+
+  if( u32Result != u32Expected )
+  {
+    if( gu32Mismatches < DSP_TEST_MAX_REPORTED )
+    {
+      printf( "  SSAT16( 0x%08X ): 0x%08X, expected: 0x%08X\n", u32Value, u32Result, u32Expected );
+    }
+    gu32Mismatches++;
+  }
+}
+
+int main( int argc, char *argv[] )
+{
+  U32  u32Iterations = DSP_TEST_DEFAULT_ITERATIONS;
+  U32  u32Index;
+  U32  u32Other;
+  U32  u32Value;
+  BOOL bFailed = FALSE;
+
+  printf( "DSP_TEST by Hekk_Elek[Strlen]\n" );
+  printf( "Build time: %s, %s\n\n", __DATE__, __TIME__ );
+
+  if( ( argc > 2 ) && ( 0 == strcmp( argv[1], "-n" ) ) )
+  {
+    u32Iterations = (U32)strtoul( argv[2], NULL, 10 );
+  }
+  else if( argc > 1 )
+  {
+    printf( "Usage: dsp_test [-n iterations]\n" );
+    printf( "Checks the C versions of the DSP instructions in platform.h bit-exactly.\n" );
+    return -2;
+  }
+
+  // SMULWB: every pair of edge operands, every bottom halfword with the edge operands, then random pairs
+  gu32Mismatches = 0u;
+  for( u32Index = 0u; u32Index < sizeof( gcau32EdgeOperands )/sizeof( gcau32EdgeOperands[ 0u ] ); u32Index++ )
+  {
+    for( u32Other = 0u; u32Other < sizeof( gcau32EdgeOperands )/sizeof( gcau32EdgeOperands[ 0u ] ); u32Other++ )
+    {
+      CheckSmulwb( gcau32EdgeOperands[ u32Index ], gcau32EdgeOperands[ u32Other ] );
+    }
+    for( u32Value = 0u; u32Value <= 0xFFFFu; u32Value++ )
+    {
+      CheckSmulwb( gcau32EdgeOperands[ u32Index ], u32Value );
+      CheckSmulwb( gcau32EdgeOperands[ u32Index ], u32Value | 0xABCD0000u );
+      CheckSmulwb( u32Value<<16, gcau32EdgeOperands[ u32Index ] );
+    }
+  }
+  for( u32Index = 0u; u32Index < u32Iterations; u32Index++ )
+  {
+    u32Value = Random();
+    CheckSmulwb( u32Value, Random() );
+  }
+  printf( "DSP_SMULWB: %u mismatches\n", gu32Mismatches );
+  if( 0u != gu32Mismatches )
+  {
+    bFailed = TRUE;
+  }
+
+  // SSAT16: every 32-bit value, the edges are among them
+  gu32Mismatches = 0u;
+  u32Value = 0u;
+  do
+  {
+    CheckSsat16( u32Value );
+    u32Value++;
+  } while( 0u != u32Value );
+  printf( "DSP_SSAT16: %u mismatches\n", gu32Mismatches );
+  if( 0u != gu32Mismatches )
+  {
+    bFailed = TRUE;
+  }
+
+  printf( ( TRUE == bFailed ) ? "FAILED\n" : "PASSED\n" );
+  return ( TRUE == bFailed ) ? -1 : 0;
+}
@@ -0,0 +1,285 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+
+// The voices put their envelope level into the mix buffer instead of the product with
+// the waveform, so the buffer holds the level of every sample the renderer played
+#undef DSP_SMULWB
+#define DSP_SMULWB(W,H)  ( (void)(H), (I32)(W) )
+
+// The envelope is calculated by static functions, so the synthesizer is compiled into this file
+#include "sound_synth.c"
+
+#define ENVELOPE_TEST_TOLERANCE        (1u)  //!< Largest difference from the reference, in the LSB of the 16-bit level
+#define ENVELOPE_TEST_HOLD          (1000u)  //!< Samples played in the sustain before the release
+#define ENVELOPE_TEST_TAIL           (300u)  //!< Samples played after the end of the reference envelope
+#define ENVELOPE_TEST_MAX_REPORTED    (10u)  //!< Mismatches printed of each run
+
+//! \brief An instrument of the test, with the envelope parameters that the reference gets
+typedef struct
+{
+  char const*   pcName;        //!< Name in the report
+  U8            u8Instrument;  //!< Instrument slot
+  U32           u32Attack;     //!< Attack length in samples
+  U32           u32Decay;      //!< Decay length in samples
+  U16           u16Sustain;    //!< Sustain level
+  U32           u32Release;    //!< Release length in samples
+  E_SYNTH_CURVE eCurve;        //!< Shape of the stages
+} S_TEST_INSTRUMENT;
+
+//! \brief State of the reference envelope generator
+typedef struct
+{
+  S_TEST_INSTRUMENT const* psInstrument;  //!< Parameters
+  E_ADSR_STATE eState;                    //!< Stage
+  U32          u32Timer;                  //!< Samples since the beginning of the stage
+} S_REFERENCE;
+
+//! \brief The default instruments of SoundSynth_Init(), and two longer envelopes for the stages the defaults do not reach
+static S_TEST_INSTRUMENT const gcasInstruments[] =
+{
+  { "square (sustained)",   SYNTH_INSTRUMENT_SQUARE,     0u,    0u, 0xFFFFu,    0u, SYNTH_CURVE_LINEAR },
+  { "chime",                SYNTH_INSTRUMENT_CHIME,   4410u, 4410u,    0x0u,    0u, SYNTH_CURVE_LINEAR },
+  { "drum",                 SYNTH_INSTRUMENT_DRUM,       0u, 8820u,    0x0u, 2205u, SYNTH_CURVE_EXPONENTIAL },
+  { "cymbal",               SYNTH_INSTRUMENT_CYMBAL,     0u, 3528u,    0x0u, 2205u, SYNTH_CURVE_EXPONENTIAL },
+  { "linear ADSR",          SYNTH_INSTRUMENT_MODULE,  1001u, 2999u, 0x9A5Cu, 7777u, SYNTH_CURVE_LINEAR },
+  { "exponential ADSR",     SYNTH_INSTRUMENT_MODULE,  1001u, 2999u, 0x9A5Cu, 7777u, SYNTH_CURVE_EXPONENTIAL },
+};
+
+//! \brief Block sizes the envelopes are rendered in
+static U16 const gcau16BlockFrames[] = { 1u, 7u, 64u, SOUNDSYNTH_BLOCK_FRAMES };
+
+/*! *******************************************************************
+ * \brief  Scales a level by the shape of a stage at a point of it
+ * \param  u32Level: level change of the whole stage
+ * \param  u32Timer: samples since the beginning of the stage
+ * \param  u32Length: length of the stage
+ * \param  eCurve: shape of the stage
+ * \return The part of the level change done until u32Timer, rounded down
+ * \note   The exponential curve is the table of the synthesizer interpolated
+ *         at the exact point, with a division at every sample.
+ *********************************************************************/
+static U32 ReferenceScale( U32 u32Level, U32 u32Timer, U32 u32Length, E_SYNTH_CURVE eCurve )
+{
+  U64 u64Position;
+  U32 u32Index;
+  U64 u64Curve;
+
+  if( SYNTH_CURVE_LINEAR == eCurve )
+  {
+    return (U64)u32Level*u32Timer / u32Length;
+  }
+
+  // Curve*u32Length, a Q15 number
+  u64Position = (U64)u32Timer*ENVELOPE_CURVE_SEGMENTS;
+  u32Index = (U32)( u64Position / u32Length );
+  u64Curve = (U64)gcau16EnvelopeCurve[ u32Index ]*u32Length;
+  if( u32Index < ENVELOPE_CURVE_SEGMENTS )
+  {
+    u64Curve += (U64)( gcau16EnvelopeCurve[ u32Index + 1u ] - gcau16EnvelopeCurve[ u32Index ] )*( u64Position % u32Length );
+  }
+  return (U32)( u64Curve*u32Level / ( (U64)u32Length<<15u ) );
+}
+
+/*! *******************************************************************
+ * \brief  The envelope generator before the prepared stages, advanced by one sample
+ * \param  psReference: state of the generator
+ * \return Output of the envelope generator
+ * \note   The linear stages are the 64-bit multiply and divide of every sample
+ *         that the prepared stages replaced; the exponential stages put the
+ *         same position through the curve.
+ *********************************************************************/
+static U16 ReferenceStep( S_REFERENCE* psReference )
+{
+  S_TEST_INSTRUMENT const* psInstrument = psReference->psInstrument;
+  U16 u16ADSR = 0u;
+  U32 u32Timer = psReference->u32Timer;
+
+  switch( psReference->eState )
+  {
+    case ADSR_ATTACK:
+      if( 0u != psInstrument->u32Attack )
+      {
+        u16ADSR = ReferenceScale( 0xFFFFu, u32Timer, psInstrument->u32Attack, psInstrument->eCurve );
+      }
+      else
+      {
+        u16ADSR = 0xFFFFu;
+      }
+      u32Timer++;
+      if( u32Timer > psInstrument->u32Attack )
+      {
+        u32Timer = 0u;
+        psReference->eState = ADSR_DECAY;
+      }
+      break;
+
+    case ADSR_DECAY:
+      if( 0u != psInstrument->u32Decay )
+      {
+        u16ADSR = 0xFFFFu - ReferenceScale( 0xFFFFu - psInstrument->u16Sustain, u32Timer, psInstrument->u32Decay, psInstrument->eCurve );
+      }
+      else
+      {
+        u16ADSR = psInstrument->u16Sustain;
+      }
+      u32Timer++;
+      if( u32Timer > psInstrument->u32Decay )
+      {
+        u32Timer = 0u;
+        psReference->eState = ADSR_SUSTAIN;
+      }
+      break;
+
+    case ADSR_SUSTAIN:
+      u16ADSR = psInstrument->u16Sustain;
+      break;
+
+    case ADSR_RELEASE:
+      if( 0u != psInstrument->u32Release )
+      {
+        if( SYNTH_CURVE_LINEAR == psInstrument->eCurve )
+        {
+          u16ADSR = (U64)psInstrument->u16Sustain*( psInstrument->u32Release - u32Timer ) / psInstrument->u32Release;
+        }
+        else
+        {
+          u16ADSR = psInstrument->u16Sustain - ReferenceScale( psInstrument->u16Sustain, u32Timer, psInstrument->u32Release, psInstrument->eCurve );
+        }
+      }
+      else
+      {
+        u16ADSR = 0u;
+      }
+      if( u32Timer < psInstrument->u32Release )
+      {
+        u32Timer++;
+      }
+      break;
+
+    case ADSR_IDLE:
+    default:
+      break;
+  }
+  psReference->u32Timer = u32Timer;
+
+  return u16ADSR;
+}
+
+/*! *******************************************************************
+ * \brief  Plays a note of an instrument in blocks, and compares every sample with the reference
+ * \param  psInstrument: the instrument
+ * \param  u16BlockFrames: frames rendered at once
+ * \param  pu32Samples: number of samples compared is added here
+ * \return Largest difference from the reference
+ * \note   The note is released in the sustain, at the first block boundary
+ *         after ENVELOPE_TEST_HOLD samples. The decay of the defaults ends
+ *         in silence, so their release is not played (the reference keeps 0).
+ *********************************************************************/
+static U32 TestInstrument( S_TEST_INSTRUMENT const* psInstrument, U16 u16BlockFrames, U32* pu32Samples )
+{
+  static I16 ai16Buffer[ 2u*SOUNDSYNTH_BLOCK_FRAMES ];
+  static S_SYNTH_PATCH sPatch;
+  S_REFERENCE sReference;
+  SYNTH_NOTE hNote;
+  U32 u32Sample = 0u;
+  U32 u32Release;
+  U32 u32End;
+  U32 u32Difference;
+  U32 u32MaxDifference = 0u;
+  U32 u32Mismatches = 0u;
+  U16 u16Frame;
+  U16 u16Expected;
+  BOOL bReleased = FALSE;
+
+  SoundSynth_Init();
+  if( psInstrument->u8Instrument >= SYNTH_INSTRUMENT_MODULE )
+  {
+    sPatch.psWaveTable = &gcsSineWaveTable;
+    sPatch.pi16WaveTable = NULL;
+    sPatch.u16WaveTableSize = 0u;
+    sPatch.u8NoiseBits = 0u;
+    SoundSynth_PrepareEnvelope( &sPatch.sEnvelope, psInstrument->u32Attack, psInstrument->u32Decay,
+                                psInstrument->u16Sustain, psInstrument->u32Release, psInstrument->eCurve );
+    SoundSynth_RenderSetPatch( psInstrument->u8Instrument, &sPatch );
+  }
+  hNote = SoundSynth_RenderNoteOn( 0x10000u, psInstrument->u8Instrument, SYNTH_PRIORITY_MUSIC );
+
+  sReference.psInstrument = psInstrument;
+  sReference.eState = ADSR_ATTACK;
+  sReference.u32Timer = 0u;
+  u32Release = psInstrument->u32Attack + psInstrument->u32Decay + 2u + ENVELOPE_TEST_HOLD;
+  u32End = u32Release + psInstrument->u32Release + ENVELOPE_TEST_TAIL;
+
+  while( u32Sample < u32End )
+  {
+    if( ( FALSE == bReleased ) && ( u32Sample >= u32Release ) )
+    {
+      SoundSynth_RenderNoteOff( hNote );
+      sReference.eState = ADSR_RELEASE;
+      sReference.u32Timer = 0u;
+      bReleased = TRUE;
+    }
+
+    RenderBlock( ai16Buffer, u16BlockFrames, 0x8000u );
+    for( u16Frame = 0u; u16Frame < u16BlockFrames; u16Frame++ )
+    {
+      u16Expected = ReferenceStep( &sReference );
+      u32Difference = (U32)abs( gai32MixBuffer[ u16Frame ] - (I32)u16Expected );
+      if( u32Difference > u32MaxDifference )
+      {
+        u32MaxDifference = u32Difference;
+      }
+      if( ( u32Difference > ENVELOPE_TEST_TOLERANCE ) && ( u32Mismatches++ < ENVELOPE_TEST_MAX_REPORTED ) )
+      {
+        printf( "  %s, %u frame blocks, sample %u: %d, expected: %u\n",
+                psInstrument->pcName, u16BlockFrames, u32Sample, gai32MixBuffer[ u16Frame ], u16Expected );
+      }
+      u32Sample++;
+    }
+  }
+
+  *pu32Samples += u32Sample;
+  return u32MaxDifference;
+}
+
+int main( void )
+{
+  U32  u32Instrument;
+  U32  u32Block;
+  U32  u32Difference;
+  U32  u32MaxDifference;
+  U32  u32Samples;
+  BOOL bFailed = FALSE;
+
+  printf( "ENVELOPE_TEST by Hekk_Elek[Strlen]\n" );
+  printf( "Build time: %s, %s\n\n", __DATE__, __TIME__ );
+
+#if ( 0u != SOUNDSYNTH_RATE_SHIFT )
+  printf( "The reference runs at SAMPLE_RATE, build with SOUNDSYNTH_RATE_SHIFT=0!\n" );
+  return -2;
+#endif
+
+  for( u32Instrument = 0u; u32Instrument < sizeof( gcasInstruments )/sizeof( gcasInstruments[ 0u ] ); u32Instrument++ )
+  {
+    u32MaxDifference = 0u;
+    u32Samples = 0u;
+    for( u32Block = 0u; u32Block < sizeof( gcau16BlockFrames )/sizeof( gcau16BlockFrames[ 0u ] ); u32Block++ )
+    {
+      u32Difference = TestInstrument( &gcasInstruments[ u32Instrument ], gcau16BlockFrames[ u32Block ], &u32Samples );
+      if( u32Difference > u32MaxDifference )
+      {
+        u32MaxDifference = u32Difference;
+      }
+    }
+    printf( "%-20s %8u samples, max difference: %u LSB\n", gcasInstruments[ u32Instrument ].pcName, u32Samples, u32MaxDifference );
+    if( u32MaxDifference > ENVELOPE_TEST_TOLERANCE )
+    {
+      bFailed = TRUE;
+    }
+  }
+
+  printf( ( TRUE == bFailed ) ? "FAILED\n" : "PASSED\n" );
+  return ( TRUE == bFailed ) ? -1 : 0;
+}
@@ -0,0 +1,233 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "types.h"
+#include "sound_synth.h"
+#include "tracker.h"
+
+#define FUZZ_HALF_BUFFER_FRAMES     (128u)  //!< Frames rendered per call, like one half of the I2S buffer of the firmware
+#define FUZZ_PLAY_HALVES            (700u)  //!< Half buffers played of each valid module, about 2 s
+#define FUZZ_MAX_MODULE_SIZE      (65536u)  //!< Largest module that is fuzzed
+#define FUZZ_DEFAULT_ITERATIONS  (100000u)  //!< Mutations without the -n option
+
+//! \brief No module is linked, every input is given to Tracker_Load() and Tracker_LoadStream()
+U8  gau8TrackerModule[ 1u ];
+U32 gu32TrackerModuleSize = 0u;
+
+//! \brief Number of inputs by the result of the loader
+static U32 gau32Results[ TRACKER_LOAD_BAD_INSTRUMENT + 1u ];
+
+//! \brief The input being streamed, and its size
+static U8 const* gpu8Stream;
+static U32 gu32StreamSize;
+
+/*! *******************************************************************
+ * \brief  Reads the input as if it was in the SPI flash
+ * \param  u32Address: offset in the input
+ * \param  pu8Buffer: output buffer
+ * \param  u32Length: number of bytes
+ * \return -
+ * \note   Reads past the end are caught by the address sanitizer
+ *********************************************************************/
+static void ReadStream( U32 u32Address, U8* pu8Buffer, U32 u32Length )
+{
+  if( ( u32Address > gu32StreamSize ) || ( u32Length > ( gu32StreamSize - u32Address ) ) )
+  {
+    printf( "Stream read out of the module: %u bytes at %u!\n", u32Length, u32Address );
+    abort();
+  }
+  memcpy( pu8Buffer, &gpu8Stream[ u32Address ], u32Length );
+}
+
+/*! *******************************************************************
+ * \brief  Plays the loaded module
+ * \param  -
+ * \return -
+ *********************************************************************/
+static void PlayLoaded( void )
+{
+  static I16 ai16Buffer[ 2u*FUZZ_HALF_BUFFER_FRAMES ];
+  U32 u32Half;
+  U16 u16Frames;
+  U16 u16Chunk;
+
+  Tracker_Start();
+  for( u32Half = 0u; u32Half < FUZZ_PLAY_HALVES; u32Half++ )
+  {
+    // Jump around in the song too
+    if( 0u == ( u32Half % 200u ) )
+    {
+      Tracker_Seek( u32Half*37u );
+    }
+    Tracker_Service();
+    for( u16Frames = 0u; u16Frames < FUZZ_HALF_BUFFER_FRAMES; u16Frames += u16Chunk )
+    {
+      u16Chunk = Tracker_Tick( FUZZ_HALF_BUFFER_FRAMES - u16Frames );
+      SoundSynth_Render( &ai16Buffer[ 2u*u16Frames ], u16Chunk, 0x8000u );
+    }
+  }
+  Tracker_Stop();
+  Tracker_Tick( FUZZ_HALF_BUFFER_FRAMES );
+}
+
+/*! *******************************************************************
+ * \brief  Loads one input, and plays it if it is accepted
+ * \param  pu8Data: the input
+ * \param  u32Size: size of the input
+ * \return -
+ * \note   The input is copied to a buffer of its exact size, so an address
+ *         sanitizer catches the player reading past the end of the module.
+ *********************************************************************/
+static void FuzzOne( U8 const* pu8Data, U32 u32Size )
+{
+  E_TRACKER_LOAD_RESULT eResult;
+  U8* pu8Module;
+
+  pu8Module = malloc( ( 0u != u32Size ) ? u32Size : 1u );
+  if( NULL == pu8Module )
+  {
+    return;
+  }
+  memcpy( pu8Module, pu8Data, u32Size );
+
+  SoundSynth_Init();
+  Tracker_Init();
+  eResult = Tracker_Load( pu8Module, u32Size );
+  if( eResult <= TRACKER_LOAD_BAD_INSTRUMENT )
+  {
+    gau32Results[ eResult ]++;
+  }
+  if( TRACKER_LOAD_OK == eResult )
+  {
+    PlayLoaded();
+  }
+
+  // The same input streamed, the way the songs of the SPI flash are played
+  gpu8Stream = pu8Module;
+  gu32StreamSize = u32Size;
+  if( TRACKER_LOAD_OK == Tracker_LoadStream( ReadStream, 0u, u32Size ) )
+  {
+    PlayLoaded();
+  }
+
+  free( pu8Module );
+}
+
+#ifdef FUZZ_LIBFUZZER
+/*! *******************************************************************
+ * \brief  Entry point of libFuzzer (build with -DFUZZ_LIBFUZZER -fsanitize=fuzzer,address)
+ * \param  pu8Data: the input
+ * \param  szSize: size of the input
+ * \return 0
+ *********************************************************************/
+int LLVMFuzzerTestOneInput( const uint8_t* pu8Data, size_t szSize )
+{
+  if( szSize <= FUZZ_MAX_MODULE_SIZE )
+  {
+    FuzzOne( pu8Data, (U32)szSize );
+  }
+  return 0;
+}
+#else
+/*! *******************************************************************
+ * \brief  Changes a module at random
+ * \param  pu8Data: the module
+ * \param  pu32Size: size of the module, may change
+ * \return -
+ *********************************************************************/
+static void Mutate( U8* pu8Data, U32* pu32Size )
+{
+  U32 u32Changes = 1u + rand() % 4u;
+  U32 u32Position;
+
+  for( ; ( u32Changes > 0u ) && ( 0u != *pu32Size ); u32Changes-- )
+  {
+    u32Position = (U32)rand() % *pu32Size;
+    switch( rand() % 4 )
+    {
+      case 0:  // Flip a bit
+        pu8Data[ u32Position ] ^= (U8)( 1u<<( rand() % 8 ) );
+        break;
+
+      case 1:  // Random byte
+        pu8Data[ u32Position ] = (U8)rand();
+        break;
+
+      case 2:  // Interesting byte
+        pu8Data[ u32Position ] = ( 0 != ( rand() & 1 ) ) ? 0xFFu : 0x80u;
+        break;
+
+      default:  // Cut the end
+        *pu32Size = u32Position;
+        break;
+    }
+  }
+}
+
+int main( int argc, char *argv[] )
+{
+  static U8 au8Seed[ FUZZ_MAX_MODULE_SIZE ];
+  static U8 au8Input[ FUZZ_MAX_MODULE_SIZE ];
+  U32   u32Iterations = FUZZ_DEFAULT_ITERATIONS;
+  U32   u32Index;
+  U32   u32SeedSize;
+  U32   u32Size;
+  FILE* psInputFile;
+  int   iArg = 1;
+
+  printf( "FUZZ_TRK by Hekk_Elek[Strlen]\n" );
+  printf( "Build time: %s, %s\n\n", __DATE__, __TIME__ );
+
+  if( ( argc > 3 ) && ( 0 == strcmp( argv[1], "-n" ) ) )
+  {
+    u32Iterations = (U32)strtoul( argv[2], NULL, 10 );
+    iArg = 3;
+  }
+  if( iArg >= argc )
+  {
+    printf( "Usage: fuzz_trk [-n iterations] seed.trk [seed.trk ...]\n" );
+    printf( "Build with -fsanitize=address to catch reads past the end of the module,\n" );
+    printf( "or with -DFUZZ_LIBFUZZER -fsanitize=fuzzer,address for libFuzzer.\n" );
+    return -2;
+  }
+
+  srand( 1u );
+  for( ; iArg < argc; iArg++ )
+  {
+    psInputFile = fopen( argv[iArg], "rb" );
+    if( NULL == psInputFile )
+    {
+      printf( "Can not open %s!\n", argv[iArg] );
+      return -1;
+    }
+    u32SeedSize = (U32)fread( au8Seed, 1u, sizeof( au8Seed ), psInputFile );
+    fclose( psInputFile );
+
+    // The seed itself must be accepted
+    memset( gau32Results, 0, sizeof( gau32Results ) );
+    FuzzOne( au8Seed, u32SeedSize );
+    if( 1u != gau32Results[ TRACKER_LOAD_OK ] )
+    {
+      printf( "%s: the seed is not a valid module!\n", argv[iArg] );
+      return -1;
+    }
+
+    for( u32Index = 0u; u32Index < u32Iterations; u32Index++ )
+    {
+      u32Size = u32SeedSize;
+      memcpy( au8Input, au8Seed, u32Size );
+      Mutate( au8Input, &u32Size );
+      FuzzOne( au8Input, u32Size );
+    }
+
+    printf( "%s: %u inputs\n", argv[iArg], u32Iterations + 1u );
+    for( u32Index = 0u; u32Index <= TRACKER_LOAD_BAD_INSTRUMENT; u32Index++ )
+    {
+      printf( "  Result %u: %u\n", u32Index, gau32Results[ u32Index ] );
+    }
+  }
+
+  return 0;
+}
+#endif  // FUZZ_LIBFUZZER
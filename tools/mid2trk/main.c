@@ -1,27 +1,191 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include "types.h"
+#include "sound_synth.h"
+#include "tracker.h"
 #include "midi.h"
 
+/*! *******************************************************************
+ * \brief  Reads a whole file into the memory
+ * \param  pcFileName: name of the file
+ * \param  pu32Size: size of the file is returned here
+ * \return The contents, to be freed by the caller; NULL on error
+ *********************************************************************/
+static U8* ReadFile( char const* pcFileName, U32* pu32Size )
+{
+  FILE* psFile;
+  long  lSize;
+  U8*   pu8Data;
+
+  psFile = fopen( pcFileName, "rb" );
+  if( NULL == psFile )
+  {
+    printf( "Can not open input file %s!\n", pcFileName );
+    return NULL;
+  }
+
+  fseek( psFile, 0L, SEEK_END );
+  lSize = ftell( psFile );
+  rewind( psFile );
+  if( lSize < 0 )
+  {
+    printf( "Can not read input file %s!\n", pcFileName );
+    fclose( psFile );
+    return NULL;
+  }
+
+  // One read of the whole file, the chunks of the MIDI file point into it
+  pu8Data = malloc( ( 0 != lSize ) ? (size_t)lSize : 1u );
+  if( NULL == pu8Data )
+  {
+    printf( "Out of memory!\n" );
+    fclose( psFile );
+    return NULL;
+  }
+  *pu32Size = (U32)fread( pu8Data, 1u, (size_t)lSize, psFile );
+  fclose( psFile );
+  return pu8Data;
+}
+
 int main( int argc, char *argv[] )
 {
   char  gcau8DefaultOutputFileName[] = "converterOutput.trk";
   char* au8InputFileName;
   char* au8OutputFileName;
-  FILE  *psInputFile, *psOutputFile;
+  FILE  *psOutputFile;
   U8*   pu8MidiFileInMemory;
   U32   u32MidiFileSize;
-  U32   u32Index;
+  BOOL  bCompact = TRUE;
+  U32   u32SeekMs = 0u;
+  BOOL  bInstruments = FALSE;
+  BOOL  bPatterns = FALSE;
+  U32   u32Voices = NUMBER_OF_OSCILLATORS;
+  BOOL  bVerbose = FALSE;
+  BOOL  bThroughput = FALSE;
+  U64   u64Bytes = 0u;
+  clock_t sStart;
+  double  dSeconds;
+  int     iFile;
 
   printf( "MID2TRK by Hekk_Elek[Strlen]\n" );
   printf( "Build time: %s, %s\n\n", __DATE__, __TIME__ );
 
+  // Options before the file names
+  while( ( argc > 1 ) && ( '-' == argv[1][0] ) )
+  {
+    if( 0 == strcmp( argv[1], "-v1" ) )
+    {
+      bCompact = FALSE;
+    }
+    else if( 0 == strcmp( argv[1], "-v" ) )
+    {
+      bVerbose = TRUE;
+    }
+    else if( 0 == strcmp( argv[1], "-t" ) )
+    {
+      bThroughput = TRUE;
+    }
+    else if( 0 == strcmp( argv[1], "-i" ) )
+    {
+      bInstruments = TRUE;
+    }
+    else if( 0 == strcmp( argv[1], "-p" ) )
+    {
+      bPatterns = TRUE;
+    }
+    else if( ( 0 == strcmp( argv[1], "-s" ) ) && ( argc > 2 ) )
+    {
+      u32SeekMs = (U32)strtoul( argv[2], NULL, 10 );
+      argc--;
+      argv++;
+    }
+    else if( ( 0 == strcmp( argv[1], "-n" ) ) && ( argc > 2 ) )
+    {
+      u32Voices = (U32)strtoul( argv[2], NULL, 10 );
+      if( ( 0u == u32Voices ) || ( u32Voices > TRACKER_NUMBER_OF_CHANNELS ) )
+      {
+        printf( "The number of voices must be 1..%u\n", TRACKER_NUMBER_OF_CHANNELS );
+        return -2;
+      }
+      argc--;
+      argv++;
+    }
+    else
+    {
+      printf( "Unknown option: %s\n", argv[1] );
+      return -2;
+    }
+    argc--;
+    argv++;
+  }
+
   if( argc < 2 )
   {
-    printf( "Usage: mid2trk inputfile.mid [outputfile.trk]\n" );
+    printf( "Usage: mid2trk [-v1] [-s ms] [-i] [-p] [-n voices] [-v] inputfile.mid [outputfile.trk]\n" );
+    printf( "       mid2trk -t [options] inputfile.mid [inputfile.mid ...]\n" );
+    printf( "  -v1: write the version 1 format instead of the compact one\n" );
+    printf( "  -s ms: add a seek table with an entry in every ms milliseconds\n" );
+    printf( "  -i: define instruments in the module for the program changes\n" );
+    printf( "  -p: factor the repeated phrases of the song into patterns\n" );
+    printf( "  -n voices: notes played at the same time, %u by default (the oscillators of the synthesizer)\n", NUMBER_OF_OSCILLATORS );
+    printf( "  -v: print every event of the MIDI file\n" );
+    printf( "  -t: convert the input files without writing them, and print the throughput\n" );
     return -2;
   }
-  else if( argc == 2 )  // only 1 argument
+  if( ( FALSE == bCompact ) && ( 0u != u32SeekMs ) )
+  {
+    printf( "The version 1 format has no seek table, -s is ignored\n" );
+  }
+  if( ( FALSE == bCompact ) && ( TRUE == bInstruments ) )
+  {
+    printf( "The version 1 format has no instruments, -i is ignored\n" );
+    bInstruments = FALSE;
+  }
+  if( ( FALSE == bCompact ) && ( TRUE == bPatterns ) )
+  {
+    printf( "The version 1 format has no patterns, -p is ignored\n" );
+    bPatterns = FALSE;
+  }
+
+  if( TRUE == bThroughput )
+  {
+    // Every file is read, parsed and exported to a scratch file, the time of all that is measured
+    psOutputFile = tmpfile();
+    if( NULL == psOutputFile )
+    {
+      printf( "Can not open a scratch file!\n" );
+      return -1;
+    }
+    sStart = clock();
+    for( iFile = 1; iFile < argc; iFile++ )
+    {
+      printf( "Input file: %s\n", argv[iFile] );
+      pu8MidiFileInMemory = ReadFile( argv[iFile], &u32MidiFileSize );
+      if( NULL == pu8MidiFileInMemory )
+      {
+        return -1;
+      }
+      Midi_Parse( pu8MidiFileInMemory, u32MidiFileSize, bInstruments, (U8)u32Voices, bVerbose );
+      rewind( psOutputFile );
+      Midi_ExportTracker( psOutputFile, bCompact, u32SeekMs, bPatterns );
+      Midi_Free();
+      free( pu8MidiFileInMemory );
+      u64Bytes += u32MidiFileSize;
+    }
+    dSeconds = (double)( clock() - sStart )/CLOCKS_PER_SEC;
+    fclose( psOutputFile );
+    printf( "\nThroughput: %d files, %.2f MB in %.3f s", argc - 1, u64Bytes/1e6, dSeconds );
+    if( dSeconds > 0.0 )
+    {
+      printf( ", %.2f MB/s", u64Bytes/1e6/dSeconds );
+    }
+    printf( "\n" );
+    return 0;
+  }
+
+  if( argc == 2 )  // only 1 argument
   {
     au8OutputFileName = gcau8DefaultOutputFileName;
   }
@@ -31,7 +195,7 @@ int main( int argc, char *argv[] )
   }
   else  // too many arguments
   {
-    printf( "Usage: mid2trk inputfile.mid [outputfile.trk]\n" );
+    printf( "Usage: mid2trk [-v1] [-s ms] [-i] [-p] [-n voices] [-v] inputfile.mid [outputfile.trk]\n" );
     return -2;
   }
   au8InputFileName = argv[1];
@@ -39,38 +203,20 @@ int main( int argc, char *argv[] )
   printf( "Input file: %s\n", au8InputFileName );
   printf( "Output file: %s\n", au8OutputFileName );
 
-  psInputFile = fopen( au8InputFileName, "rb" );
-
-  if( NULL == psInputFile )
-  {
-    printf( "Can not open input file!\n" );
-    return -1;
-  }
-
-  fseek( psInputFile, 0L, SEEK_END );
-  u32MidiFileSize = ftell( psInputFile );
-  rewind( psInputFile );
-
-  pu8MidiFileInMemory = malloc( u32MidiFileSize );
+  pu8MidiFileInMemory = ReadFile( au8InputFileName, &u32MidiFileSize );
   if( NULL == pu8MidiFileInMemory )
   {
-    printf( "Out of memory!\n" );
     return -1;
   }
 
-  for( u32Index = 0u; u32Index < u32MidiFileSize; u32Index++ )
-  {
-    pu8MidiFileInMemory[ u32Index ] = (U8)getc( psInputFile );
-  }
-
-  fclose( psInputFile );
-
-  Midi_Parse( pu8MidiFileInMemory, u32MidiFileSize );
+  Midi_Parse( pu8MidiFileInMemory, u32MidiFileSize, bInstruments, (U8)u32Voices, bVerbose );
 
   psOutputFile = fopen( au8OutputFileName, "wb" );
-  Midi_ExportTracker( psOutputFile );
+  Midi_ExportTracker( psOutputFile, bCompact, u32SeekMs, bPatterns );
 
   fclose( psOutputFile );
+  Midi_Free();
+  free( pu8MidiFileInMemory );
 
   return 0;
 }
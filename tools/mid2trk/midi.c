@@ -16,11 +16,14 @@
 //--------------------------------------------------------------------------------------------------------/
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdarg.h>
 #include <string.h>
 #include <math.h>
 #include "types.h"
 #include "sound_synth.h"
 #include "tracker.h"
+#include "pattern.h"
+#include "voice.h"
 
 // Own include
 #include "midi.h"
@@ -47,6 +50,25 @@
 #define MIDI_SYSEX_MASK                      (0x00u)
 #define MIDI_METAEVENT                       (0xFFu)
 #define MIDI_METAEVENT_MASK                  (0x00u)
+#define MIDI_META_SET_TEMPO                  (0x51u)  //!< Meta event: microseconds per quarter note, 24 bits
+#define MIDI_DEFAULT_TEMPO                 (500000u)  //!< Tempo until the first set tempo meta event: 120 BPM
+#define MIDI_DATA_MASK                       (0x7Fu)  //!< Data bytes of the channel events are 7 bits
+#define MIDI_VARLEN_MAX_BYTES                   (4u)  //!< Longest variable-length quantity of the MIDI file format
+#define MIDI_HEADER_LENGTH                      (6u)  //!< Length of the header chunk: format, number of tracks, division
+
+#define MIDI_CTRL_MODULATION                 (0x01u)  //!< Modulation wheel controller
+#define MIDI_PITCH_BEND_CENTER               (8192u)  //!< Pitch bend value of the original pitch
+#define MIDI_PITCH_BEND_RANGE                   (2u)  //!< Pitch bend range in semitones (General MIDI default)
+#define MIDI_PERCUSSION_CHANNEL                 (9u)  //!< General MIDI percussion channel (channel 10)
+
+#define VIBRATO_RATE                          (550u)  //!< Vibrato of the modulation wheel: frequency (1/100 Hz)
+#define VIBRATO_MAX_DEPTH  ( SYNTH_PITCH_SEMITONE/2u )  //!< Vibrato of the modulation wheel: depth at full modulation
+
+#define CHANNEL_NOTE_NONE                  (0xFFFFu)  //!< No note sounds on the channel
+
+#define MIDI_PROGRAM_FAMILIES                  (16u)  //!< General MIDI programs come in families of 8 (piano, chromatic percussion, organ...)
+#define FAMILY_INSTRUMENT_NONE               (0xFFu)  //!< No module instrument is made for the family yet
+#define TRIANGLE_TABLE_SIZE                    (64u)  //!< Samples of the triangle wavetable written in the module
 
 
 //--------------------------------------------------------------------------------------------------------/
@@ -60,40 +82,258 @@ typedef struct
   U8* pu8ChunkBody;
 } S_CHUNK;
 
+//! \brief Reading position in the MIDI file, reads past the end return zeros
+typedef struct
+{
+  U8 const* pu8Data;
+  U32  u32Size;
+  U32  u32Position;
+  BOOL bOverrun;    //!< TRUE after a read past the end
+} S_CURSOR;
+
+//! \brief Event of a decoded MIDI track
+typedef struct
+{
+  U32 u32Tick;         //!< Absolute time (ticks)
+  U8  u8Status;        //!< Status byte of a channel event, or MIDI_METAEVENT for set tempo
+  U8  au8Data[ 2u ];   //!< Data bytes of a channel event
+  U32 u32Tempo;        //!< Set tempo: microseconds per quarter note
+} S_MIDI_EVENT;
+
+//! \brief Decoded MIDI track
+typedef struct
+{
+  S_MIDI_EVENT* psEvents;  //!< Events by time, dynamic array
+  U32 u32Count;
+  U32 u32Capacity;
+  U32 u32Next;             //!< Next event to be merged
+} S_MIDI_TRACK;
+
+//! \brief Growing byte buffer
+typedef struct
+{
+  U8* pu8Data;
+  U32 u32Size;
+  U32 u32Capacity;
+} S_BUFFER;
+
+//! \brief State of a tracker channel, for the snapshots of the seek table
+typedef struct
+{
+  U8  u8Instrument;  //!< Instrument slot
+  I16 i16Bend;       //!< Pitch bend
+  U32 u32Vibrato;    //!< Operand of the last VIBRATO
+  U16 u16Note;       //!< Index of the sounding note in the note table, or CHANNEL_NOTE_NONE
+} S_CHANNEL_STATE;
+
 
 //--------------------------------------------------------------------------------------------------------/
 // Global variables
 //--------------------------------------------------------------------------------------------------------/
 // Midi-related variables
-static S_CHUNK* gapsMidiChunks;
-static U32      gu32ChunkNum;
+static S_CHUNK* gapsMidiChunks = NULL;  // dynamic array
+static U32      gu32ChunkNum = 0u;
+static U32      gu32ChunkCapacity = 0u;
 static U16      gu16Format = 0u;
 static U16      gu16NumTracks = 0u;
 static U16      gu16Division = 0u;
+static S_MIDI_TRACK* gasMidiTracks = NULL;  // dynamic array
+static U32      gu32MidiTracks = 0u;
+// Tempo map, followed while the tracks are merged
+static U32      gu32Tempo;              //!< Microseconds per quarter note
+static U32      gu32TempoStartTick;     //!< Time of the last tempo change (ticks)
+static U64      gu64TempoStart;         //!< Time of the last tempo change (microseconds times the division)
 // Tracker format
 static S_TRACKER_INSTRUCTION* gasTrackerInstructions = NULL;  // dynamic array
 static U32                    gu32TrackerInstructions = 0u;
-static U32                    gu32TimeMs = 0u;
+static U32                    gu32TrackerCapacity = 0u;
+static U32                    gu32LastEventTimeMs = 0u;  //!< Time of the last tracker event (ms)
 
-//TODO: instruments, etc.
+// Instruments of the module, made for the General MIDI program families used
+static BOOL  gbInstruments = FALSE;
+static S_TRACKER_INSTRUMENT gasInstruments[ SOUNDSYNTH_MODULE_INSTRUMENTS ];
+static U8    gu8NumberOfInstruments = 0u;
+static U8    gau8FamilyInstruments[ MIDI_PROGRAM_FAMILIES ];
 // Helper variables
+static BOOL  gbVerbose = FALSE;  //!< Print every event of the MIDI file
 static float gcafFreqTable[ 128u ];  //!< MIDI note -> frequency lookup table
-static float gfMsPerBeat = 0.0;
+static float gfMsPerBeat = 0.0;  //!< Tempo at the start of the song, for the version 1 header
+static S_CHANNEL_STATE gasMidiChannels[ VOICE_MIDI_CHANNELS ];       //!< Instrument and modulation of the MIDI channels
+static S_CHANNEL_STATE gasVoiceStates[ TRACKER_NUMBER_OF_CHANNELS ];  //!< Instrument and modulation of the tracker channels
+
+//! \brief Instrument of each General MIDI program family; TRACKER_VOICE_WAVETABLE plays the triangle table
+static const S_TRACKER_INSTRUMENT gcasFamilyInstruments[ MIDI_PROGRAM_FAMILIES ] =
+{
+  // Voice                   Curve                    Ref.  Size  Attack Decay Sustain  Release
+  { TRACKER_VOICE_SQUARE,    SYNTH_CURVE_EXPONENTIAL, 0u,   0u,     5u,  800u, 0x3000u,  200u },  // Piano
+  { TRACKER_VOICE_SINE,      SYNTH_CURVE_EXPONENTIAL, 0u,   0u,     2u,  600u, 0x0000u,  300u },  // Chromatic percussion
+  { TRACKER_VOICE_SQUARE,    SYNTH_CURVE_LINEAR,      0u,   0u,    10u,    0u, 0xFFFFu,   50u },  // Organ
+  { TRACKER_VOICE_SAW,       SYNTH_CURVE_EXPONENTIAL, 0u,   0u,     3u,  700u, 0x2000u,  150u },  // Guitar
+  { TRACKER_VOICE_SAW,       SYNTH_CURVE_EXPONENTIAL, 0u,   0u,     5u,  300u, 0x8000u,   80u },  // Bass
+  { TRACKER_VOICE_SAW,       SYNTH_CURVE_LINEAR,      0u,   0u,   150u,    0u, 0xFFFFu,  300u },  // Strings
+  { TRACKER_VOICE_SAW,       SYNTH_CURVE_LINEAR,      0u,   0u,   200u,    0u, 0xFFFFu,  400u },  // Ensemble
+  { TRACKER_VOICE_SQUARE,    SYNTH_CURVE_LINEAR,      0u,   0u,    40u,  200u, 0xC000u,  100u },  // Brass
+  { TRACKER_VOICE_WAVETABLE, SYNTH_CURVE_LINEAR,      0u,   0u,    30u,  100u, 0xD000u,   80u },  // Reed
+  { TRACKER_VOICE_WAVETABLE, SYNTH_CURVE_LINEAR,      0u,   0u,    60u,    0u, 0xFFFFu,  120u },  // Pipe
+  { TRACKER_VOICE_SQUARE,    SYNTH_CURVE_LINEAR,      0u,   0u,     5u,    0u, 0xFFFFu,   50u },  // Synth lead
+  { TRACKER_VOICE_SAW,       SYNTH_CURVE_LINEAR,      0u,   0u,   400u,    0u, 0xFFFFu,  600u },  // Synth pad
+  { TRACKER_VOICE_SINE,      SYNTH_CURVE_EXPONENTIAL, 0u,   0u,   100u, 1000u, 0x4000u,  500u },  // Synth effects
+  { TRACKER_VOICE_SAW,       SYNTH_CURVE_EXPONENTIAL, 0u,   0u,     5u,  500u, 0x1000u,  200u },  // Ethnic
+  { TRACKER_VOICE_SINE,      SYNTH_CURVE_EXPONENTIAL, 0u,   0u,     1u,  300u, 0x0000u,  100u },  // Percussive
+  { TRACKER_VOICE_NOISE,     SYNTH_CURVE_EXPONENTIAL, 15u,  0u,    10u,  500u, 0x0000u,  100u },  // Sound effects
+};
 
 
 //--------------------------------------------------------------------------------------------------------/
 // Static function declarations
 //--------------------------------------------------------------------------------------------------------/
+static void Log( char const* pcFormat, ... );
+static void Cursor_Init( S_CURSOR* psCursor, U8 const* pu8Data, U32 u32Size );
+static U8 Cursor_ReadU8( S_CURSOR* psCursor );
+static U32 Cursor_ReadBigEndian( S_CURSOR* psCursor, U8 u8Bytes );
+static U32 Cursor_ReadVarLen( S_CURSOR* psCursor );
+static void Cursor_Skip( S_CURSOR* psCursor, U32 u32Length );
 static void GenKeyFreqTable( void );
 U32 GetNotePhaseIncrease( U8 u8MIDINote );
+static U32 GetPercussion( U8 u8MIDINote, U8* pu8Instrument );
+static U8 GetProgramInstrument( U8 u8Program );
 static void ParseStream( U32 u32Chunk );
+static void Track_AddMidiEvent( S_MIDI_TRACK* psTrack, S_MIDI_EVENT const* psEvent );
+static BOOL IsEarlier( U32 u32TrackA, U32 u32TrackB );
+static void Heap_SiftDown( U32* pu32Heap, U32 u32Size, U32 u32Parent );
+static U32 GetTimeMs( U32 u32Tick );
+static void MergeTracks( void );
+static void Track_WaitUntil( U8 u8Channel, U32 u32TimeMs );
+static void SetVoice( U8 u8Voice, U8 u8Instrument, S_CHANNEL_STATE const* psChannel );
+static void AddChannelEvent( S_MIDI_EVENT const* psEvent, U32 u32TimeMs );
 static void Track_Init( void );
 static void Track_AddEvent( U8 u8Channel, E_TRACKER_OPCODE eOpCode, U32 u32Operand );
+static void Buffer_Put( S_BUFFER* psBuffer, U8 u8Byte );
+static void Buffer_PutVarInt( S_BUFFER* psBuffer, U32 u32Value );
+static void Buffer_PutInstruction( S_BUFFER* psBuffer, U8 u8Channel, U8 u8OpCode, U32 u32Operand );
+static void Buffer_PutSnapshot( S_BUFFER* psBuffer, S_CHANNEL_STATE const* psChannels );
+static U8 GetDefaultInstrument( U8 u8Channel );
+static U32 GetInstructionSize( S_TRACKER_INSTRUCTION const* psInstruction );
+static void TrackInstruction( S_TRACKER_INSTRUCTION const* psInstruction, S_PATTERN const* psPatterns, S_CHANNEL_STATE* psChannels, U32* pu32TimeMs );
+static U32 ExportCompact( FILE* psOutFile, U32 u32SeekMs, BOOL bPatterns );
+static void WriteU16( FILE* psOutFile, U16 u16Value );
+static void WriteU32( FILE* psOutFile, U32 u32Value );
 
 
 //--------------------------------------------------------------------------------------------------------/
 // Static functions
 //--------------------------------------------------------------------------------------------------------/
+ /*! *******************************************************************
+ * \brief  Prints a line of the verbose output
+ * \param  pcFormat: format, like printf()
+ * \return -
+ * \note   Every event of the MIDI file is printed, so large files are
+ *         converted much faster without it
+ *********************************************************************/
+static void Log( char const* pcFormat, ... )
+{
+  va_list sArgs;
+
+  if( TRUE == gbVerbose )
+  {
+    va_start( sArgs, pcFormat );
+    vprintf( pcFormat, sArgs );
+    va_end( sArgs );
+  }
+}
+
+ /*! *******************************************************************
+ * \brief  Starts reading a part of the MIDI file
+ * \param  psCursor: the cursor
+ * \param  pu8Data: start of the part
+ * \param  u32Size: size of the part
+ * \return -
+ *********************************************************************/
+static void Cursor_Init( S_CURSOR* psCursor, U8 const* pu8Data, U32 u32Size )
+{
+  psCursor->pu8Data = pu8Data;
+  psCursor->u32Size = u32Size;
+  psCursor->u32Position = 0u;
+  psCursor->bOverrun = FALSE;
+}
+
+ /*! *******************************************************************
+ * \brief  Reads a byte
+ * \param  psCursor: the cursor
+ * \return The byte, 0 past the end
+ *********************************************************************/
+static U8 Cursor_ReadU8( S_CURSOR* psCursor )
+{
+  if( psCursor->u32Position >= psCursor->u32Size )
+  {
+    psCursor->bOverrun = TRUE;
+    return 0u;
+  }
+  return psCursor->pu8Data[ psCursor->u32Position++ ];
+}
+
+ /*! *******************************************************************
+ * \brief  Reads a big-endian number
+ * \param  psCursor: the cursor
+ * \param  u8Bytes: size of the number, 4 at most
+ * \return The number
+ *********************************************************************/
+static U32 Cursor_ReadBigEndian( S_CURSOR* psCursor, U8 u8Bytes )
+{
+  U32 u32Value = 0u;
+
+  for( ; u8Bytes > 0u; u8Bytes-- )
+  {
+    u32Value = ( u32Value<<8u ) | Cursor_ReadU8( psCursor );
+  }
+  return u32Value;
+}
+
+ /*! *******************************************************************
+ * \brief  Reads a variable-length quantity: 7 bits per byte, MSB first
+ * \param  psCursor: the cursor
+ * \return The number
+ * \note   A quantity longer than MIDI_VARLEN_MAX_BYTES is a broken file,
+ *         it is read as an overrun
+ *********************************************************************/
+static U32 Cursor_ReadVarLen( S_CURSOR* psCursor )
+{
+  U32 u32Value = 0u;
+  U8  u8Byte;
+  U8  u8Index;
+
+  for( u8Index = 0u; u8Index < MIDI_VARLEN_MAX_BYTES; u8Index++ )
+  {
+    u8Byte = Cursor_ReadU8( psCursor );
+    u32Value = ( u32Value<<7u ) | ( u8Byte & 0x7Fu );
+    if( 0u == ( u8Byte & 0x80u ) )
+    {
+      return u32Value;
+    }
+  }
+  psCursor->bOverrun = TRUE;
+  return u32Value;
+}
+
+ /*! *******************************************************************
+ * \brief  Skips bytes
+ * \param  psCursor: the cursor
+ * \param  u32Length: number of bytes
+ * \return -
+ *********************************************************************/
+static void Cursor_Skip( S_CURSOR* psCursor, U32 u32Length )
+{
+  if( u32Length > ( psCursor->u32Size - psCursor->u32Position ) )
+  {
+    psCursor->u32Position = psCursor->u32Size;
+    psCursor->bOverrun = TRUE;
+  }
+  else
+  {
+    psCursor->u32Position += u32Length;
+  }
+}
+
  /*! *******************************************************************
  * \brief  Generates MIDI note -- frequency lookup table
  * \param  -
@@ -124,136 +364,487 @@ void GenKeyFreqTable( void )
  *********************************************************************/
 U32 GetNotePhaseIncrease( U8 u8MIDINote )
 {
-  #warning "ˇˇEz csak 512 hosszú mintákkal megy!"
-  // Sample rate / 512 == base frequency of the sample (phase increase = 65536)
+  // Sample rate / SYNTH_WAVETABLE_SIZE == base frequency of every wavetable (phase increase = 65536)
   //
-  return round( 512.0*65536.0*gcafFreqTable[ u8MIDINote ] / (1.0 * SAMPLE_RATE ) );
+  return round( SYNTH_WAVETABLE_SIZE*65536.0*gcafFreqTable[ u8MIDINote ] / (1.0 * SAMPLE_RATE ) );
 }
 
 /*! *******************************************************************
- * \brief  Parses MIDI stream
+ * \brief  Maps a General MIDI percussion note to a noise instrument
+ * \param  u8MIDINote: the percussion note (35: bass drum ... 81: open triangle)
+ * \param  pu8Instrument: the instrument slot is returned here
+ * \return Phase increase value: the clock of the noise shift register
+ *********************************************************************/
+static U32 GetPercussion( U8 u8MIDINote, U8* pu8Instrument )
+{
+  U32 u32Clock;
+
+  *pu8Instrument = SYNTH_INSTRUMENT_DRUM;
+  if( ( 35u == u8MIDINote ) || ( 36u == u8MIDINote ) )  // Bass drums: low rumble
+  {
+    u32Clock = SYNTH_NOISE_CLOCK( 1500u );
+  }
+  else if( ( u8MIDINote >= 37u ) && ( u8MIDINote <= 40u ) )  // Snares, side stick, clap
+  {
+    u32Clock = SYNTH_NOISE_CLOCK( 22050u );
+  }
+  else if( ( 42u == u8MIDINote ) || ( 44u == u8MIDINote ) || ( 46u == u8MIDINote ) )  // Hi-hats
+  {
+    *pu8Instrument = SYNTH_INSTRUMENT_CYMBAL;
+    u32Clock = SYNTH_NOISE_CLOCK( SAMPLE_RATE );
+  }
+  else if( ( 49u == u8MIDINote ) || ( ( u8MIDINote >= 51u ) && ( u8MIDINote <= 59u ) ) )  // Cymbals
+  {
+    *pu8Instrument = SYNTH_INSTRUMENT_CYMBAL;
+    u32Clock = SYNTH_NOISE_CLOCK( 33075u );
+  }
+  else if( ( u8MIDINote >= 41u ) && ( u8MIDINote <= 50u ) )  // Toms, from low to high
+  {
+    u32Clock = SYNTH_NOISE_CLOCK( 2000u + 500u*( u8MIDINote - 41u ) );
+  }
+  else  // Everything else: a generic hit
+  {
+    u32Clock = SYNTH_NOISE_CLOCK( 11025u );
+  }
+
+  return u32Clock;
+}
+
+/*! *******************************************************************
+ * \brief  Returns the module instrument of a General MIDI program
+ * \param  u8Program: the program (0...127)
+ * \return Index of the instrument of the module
+ * \note   One instrument is made for each family of 8 programs, when the
+ *         family is first used. The module can hold SOUNDSYNTH_MODULE_INSTRUMENTS.
+ *********************************************************************/
+static U8 GetProgramInstrument( U8 u8Program )
+{
+  U8 u8Family = ( u8Program & 0x7Fu )/8u;
+
+  if( FAMILY_INSTRUMENT_NONE == gau8FamilyInstruments[ u8Family ] )
+  {
+    if( gu8NumberOfInstruments >= SOUNDSYNTH_MODULE_INSTRUMENTS )
+    {
+      printf( "Warning: more than %u instrument families, program %u plays with the first instrument\n", SOUNDSYNTH_MODULE_INSTRUMENTS, u8Program );
+      return 0u;
+    }
+    gasInstruments[ gu8NumberOfInstruments ] = gcasFamilyInstruments[ u8Family ];
+    gau8FamilyInstruments[ u8Family ] = gu8NumberOfInstruments++;
+  }
+
+  return gau8FamilyInstruments[ u8Family ];
+}
+
+/*! *******************************************************************
+ * \brief  Decodes a MIDI track into events at absolute times
  * \param  u32Chunk: chunk index
  * \return -
+ * \note   The events of the tracks are merged into one timeline later,
+ *         so every track starts at tick 0. Channel events may use
+ *         running status. Only the set tempo meta events are kept.
+ *         A track cut short by the end of its chunk keeps its events
+ *         up to there.
  *********************************************************************/
 void ParseStream( U32 u32Chunk )
 {
-  U32  u32Index = 0u;
-  U32  u32DeltaTime;
+  S_CURSOR sCursor;
+  U32  u32Tick = 0u;
   U32  u32SpecialLength;
-  static U32 u32LastEventTimeStamp = 0;
+  U8   u8Status = 0u;  // running status
+  U8   u8Byte;
+  U8   u8Type;
+  S_MIDI_EVENT sEvent;
+  S_MIDI_TRACK* psTrack;
 
-  gu32TimeMs = 0u;  // restart timer
+  // Midi_Parse() made room for every track chunk
+  psTrack = &gasMidiTracks[ gu32MidiTracks++ ];
+  psTrack->psEvents = NULL;
+  psTrack->u32Count = 0u;
+  psTrack->u32Capacity = 0u;
+  psTrack->u32Next = 0u;
 
-  while( u32Index < gapsMidiChunks[ u32Chunk ].u32ChunkLength )
+  Cursor_Init( &sCursor, gapsMidiChunks[ u32Chunk ].pu8ChunkBody, gapsMidiChunks[ u32Chunk ].u32ChunkLength );
+  while( ( sCursor.u32Position < sCursor.u32Size ) && ( FALSE == sCursor.bOverrun ) )
   {
     // Track event: <delta-time in variable-length format><MIDI event>
-    // Delta time
-    for( u32DeltaTime = gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & 0x7Fu; gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] > 0x7Fu; u32Index++ )
+    u32Tick += Cursor_ReadVarLen( &sCursor );
+
+    // MIDI event
+    u8Byte = Cursor_ReadU8( &sCursor );
+    if( u8Byte < MIDI_NOTE_OFF )
+    {
+      // Data byte: running status, the status of the previous channel event
+      if( 0u == u8Status )
+      {
+        printf( "Unknown MIDI event token: 0x%x\n", u8Byte );
+        continue;
+      }
+    }
+    else
     {
-      u32DeltaTime = u32DeltaTime<<7u;
-      u32DeltaTime |= ( gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index+1u ] & 0x7Fu );
+      u8Status = u8Byte;
+      if( u8Status < MIDI_SYSEX )
+      {
+        u8Byte = Cursor_ReadU8( &sCursor );
+      }
     }
-    u32Index++;
-    gu32TimeMs += u32DeltaTime*gfMsPerBeat;
 
-    printf( "Deltatime: %u, abstime: %u\n", u32DeltaTime, gu32TimeMs );
-    // MIDI event
-    if( ( gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & ~MIDI_NOTE_OFF_MASK ) == MIDI_NOTE_OFF )
+    if( u8Status < MIDI_SYSEX )
     {
-      if( u32LastEventTimeStamp != gu32TimeMs )
+      // Channel event, program change and channel pressure have one data byte
+      // Data bytes are 7 bits, a broken file can not index past the note tables
+      sEvent.u32Tick = u32Tick;
+      sEvent.u8Status = u8Status;
+      sEvent.au8Data[ 0u ] = u8Byte & MIDI_DATA_MASK;
+      sEvent.au8Data[ 1u ] = 0u;
+      sEvent.u32Tempo = 0u;
+      if( ( ( u8Status & ~MIDI_PROG_CHANGE_MASK ) != MIDI_PROG_CHANGE ) && ( ( u8Status & ~MIDI_CHANNEL_PRESSURE_CHANGE_MASK ) != MIDI_CHANNEL_PRESSURE_CHANGE ) )
+      {
+        sEvent.au8Data[ 1u ] = Cursor_ReadU8( &sCursor ) & MIDI_DATA_MASK;
+      }
+      if( FALSE == sCursor.bOverrun )
       {
-        Track_AddEvent( gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & MIDI_NOTE_OFF_MASK, TRACKER_OPCODE_WAITMS, gu32TimeMs - u32LastEventTimeStamp );
-        u32LastEventTimeStamp = gu32TimeMs;
+        Track_AddMidiEvent( psTrack, &sEvent );
       }
-      // Note off event
-      printf( "Note off, channel: %u, note: %u, velocity: %u\n", gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & MIDI_NOTE_OFF_MASK, gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index+1u ], gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index+2u ] );
-      Track_AddEvent( gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & MIDI_NOTE_OFF_MASK, TRACKER_OPCODE_KEYOFF, 0u );
-      u32Index++;
-      u32Index++;
-      u32Index++;
     }
-    else if( ( gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & ~MIDI_NOTE_ON_MASK ) == MIDI_NOTE_ON )
+    else if( MIDI_METAEVENT == u8Status )
     {
-      if( u32LastEventTimeStamp != gu32TimeMs )
+      // FF + type + variable length + payload
+      u8Type = Cursor_ReadU8( &sCursor );
+      Log( "Meta event, type: %u\n", u8Type );
+      u32SpecialLength = Cursor_ReadVarLen( &sCursor );
+      if( ( MIDI_META_SET_TEMPO == u8Type ) && ( 3u == u32SpecialLength ) )
+      {
+        sEvent.u32Tick = u32Tick;
+        sEvent.u8Status = MIDI_METAEVENT;
+        sEvent.u32Tempo = Cursor_ReadBigEndian( &sCursor, 3u );
+        if( FALSE == sCursor.bOverrun )
+        {
+          Track_AddMidiEvent( psTrack, &sEvent );
+        }
+      }
+      else
       {
-        Track_AddEvent( gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & MIDI_NOTE_OFF_MASK, TRACKER_OPCODE_WAITMS, gu32TimeMs - u32LastEventTimeStamp );
-        u32LastEventTimeStamp = gu32TimeMs;
+        Cursor_Skip( &sCursor, u32SpecialLength );
       }
-      // Note on event
-      printf( "Note on, channel: %u, note: %u, velocity: %u\n", gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & MIDI_NOTE_ON_MASK, gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index+1u ], gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index+2u ] );
-      Track_AddEvent( gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & MIDI_NOTE_ON_MASK, TRACKER_OPCODE_KEYON, GetNotePhaseIncrease( gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index+1u ] ) );
-      u32Index++;
-      u32Index++;
-      u32Index++;
+      u8Status = 0u;
     }
-    else if( ( gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & ~MIDI_POLY_ON_MASK ) == MIDI_POLY_ON )
+    else
     {
-      // Polyphonic key pressure event
-      printf( "Polyphonic key pressure, channel: %u, note: %u, velocity: %u\n", gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & MIDI_POLY_ON_MASK, gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index+1u ], gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index+2u ] );
-      u32Index++;
-      u32Index++;
-      u32Index++;
+      Log( "Sysex message\n" );
+      Cursor_Skip( &sCursor, Cursor_ReadVarLen( &sCursor ) );
+      u8Status = 0u;
     }
-    else if( ( gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & ~MIDI_CTRL_CHANGE_MASK ) == MIDI_CTRL_CHANGE )
+  }
+  if( TRUE == sCursor.bOverrun )
+  {
+    printf( "Warning: track %u is cut short, the events up to its end are kept\n", (unsigned)( gu32MidiTracks - 1u ) );
+  }
+  Log( "Track %u: %u events, %u ticks\n", (unsigned)( gu32MidiTracks - 1u ), (unsigned)psTrack->u32Count, (unsigned)u32Tick );
+}
+
+ /*! *******************************************************************
+ * \brief  Appends an event to a decoded track
+ * \param  psTrack: the track, that grows as needed
+ * \param  psEvent: the event
+ * \return -
+ *********************************************************************/
+static void Track_AddMidiEvent( S_MIDI_TRACK* psTrack, S_MIDI_EVENT const* psEvent )
+{
+  if( psTrack->u32Count >= psTrack->u32Capacity )
+  {
+    psTrack->u32Capacity = ( 0u == psTrack->u32Capacity ) ? 256u : 2u*psTrack->u32Capacity;
+    psTrack->psEvents = realloc( psTrack->psEvents, psTrack->u32Capacity*sizeof( S_MIDI_EVENT ) );
+    if( NULL == psTrack->psEvents )
     {
-      // Control change event
-      printf( "Control change, channel: %u, control number: %u, control value: %u\n", gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & MIDI_CTRL_CHANGE_MASK, gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index+1u ], gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index+2u ] );
-      u32Index++;
-      u32Index++;
-      u32Index++;
+      printf( "Out of memory!\n" );
+      exit(-1);
     }
-    else if( ( gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & ~MIDI_PROG_CHANGE_MASK ) == MIDI_PROG_CHANGE )
+  }
+  psTrack->psEvents[ psTrack->u32Count++ ] = *psEvent;
+}
+
+ /*! *******************************************************************
+ * \brief  Tells if the next event of a track comes before that of another
+ * \param  u32TrackA: index of a track
+ * \param  u32TrackB: index of the other track
+ * \return TRUE if the event of track A comes first
+ * \note   Events at the same tick are taken in the order of the tracks,
+ *         so the tempo track of a format 1 file comes first.
+ *********************************************************************/
+static BOOL IsEarlier( U32 u32TrackA, U32 u32TrackB )
+{
+  U32 u32TickA = gasMidiTracks[ u32TrackA ].psEvents[ gasMidiTracks[ u32TrackA ].u32Next ].u32Tick;
+  U32 u32TickB = gasMidiTracks[ u32TrackB ].psEvents[ gasMidiTracks[ u32TrackB ].u32Next ].u32Tick;
+
+  return ( ( u32TickA < u32TickB ) || ( ( u32TickA == u32TickB ) && ( u32TrackA < u32TrackB ) ) ) ? TRUE : FALSE;
+}
+
+ /*! *******************************************************************
+ * \brief  Moves a track of the heap of tracks down to its place
+ * \param  pu32Heap: indexes of the tracks with events left, a binary min-heap
+ * \param  u32Size: number of tracks in the heap
+ * \param  u32Parent: position of the track in the heap
+ * \return -
+ *********************************************************************/
+static void Heap_SiftDown( U32* pu32Heap, U32 u32Size, U32 u32Parent )
+{
+  U32 u32Child;
+  U32 u32Track;
+
+  for( u32Child = 2u*u32Parent + 1u; u32Child < u32Size; u32Child = 2u*u32Parent + 1u )
+  {
+    if( ( ( u32Child + 1u ) < u32Size ) && ( TRUE == IsEarlier( pu32Heap[ u32Child + 1u ], pu32Heap[ u32Child ] ) ) )
     {
-      // Program change event
-      printf( "Program change, channel: %u, new program: %u\n", gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & MIDI_PROG_CHANGE_MASK, gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index+1u ] );
-      u32Index++;
-      u32Index++;
+      u32Child++;
     }
-    else if( ( gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & ~MIDI_CHANNEL_PRESSURE_CHANGE_MASK ) == MIDI_CHANNEL_PRESSURE_CHANGE )
+    if( TRUE != IsEarlier( pu32Heap[ u32Child ], pu32Heap[ u32Parent ] ) )
     {
-      // Channel pressure change event
-      printf( "Channel pressure change, channel: %u, new pressure: %u\n", gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & MIDI_CHANNEL_PRESSURE_CHANGE_MASK, gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index+1u ] );
-      u32Index++;
-      u32Index++;
+      break;
     }
-    else if( ( gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & ~MIDI_PITCH_BEND_CHANGE_MASK ) == MIDI_PITCH_BEND_CHANGE )
+    u32Track = pu32Heap[ u32Parent ];
+    pu32Heap[ u32Parent ] = pu32Heap[ u32Child ];
+    pu32Heap[ u32Child ] = u32Track;
+    u32Parent = u32Child;
+  }
+}
+
+ /*! *******************************************************************
+ * \brief  Converts an absolute time in ticks to milliseconds
+ * \param  u32Tick: the time, not before the last tempo change
+ * \return Time (ms)
+ * \note   The time of the last tempo change is kept in microseconds
+ *         times the division, so the conversion does not drift.
+ *********************************************************************/
+static U32 GetTimeMs( U32 u32Tick )
+{
+  return (U32)( ( gu64TempoStart + (U64)( u32Tick - gu32TempoStartTick )*gu32Tempo )/( 1000u*(U64)gu16Division ) );
+}
+
+ /*! *******************************************************************
+ * \brief  Merges the decoded tracks into one timeline, and adds the tracker events
+ * \param  -
+ * \return -
+ * \note   k-way merge with a min-heap of the tracks by the time of their
+ *         next event. The tempo map is followed on the merged timeline.
+ *********************************************************************/
+static void MergeTracks( void )
+{
+  U32* pu32Heap;
+  U32  u32Size = 0u;
+  U32  u32Track;
+  U32  u32Index;
+  S_MIDI_EVENT const* psEvent;
+
+  pu32Heap = malloc( ( gu32MidiTracks + 1u )*sizeof( U32 ) );
+  if( NULL == pu32Heap )
+  {
+    printf( "Out of memory!\n" );
+    exit(-1);
+  }
+
+  // Tracks with events, then heapify
+  for( u32Track = 0u; u32Track < gu32MidiTracks; u32Track++ )
+  {
+    if( 0u != gasMidiTracks[ u32Track ].u32Count )
     {
-      // Pitch bend change event
-      printf( "Pitch bend change, channel: %u, pitch bend: %u\n", gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & MIDI_PITCH_BEND_CHANGE_MASK, gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index+1u ] + ( (U16)gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index+2u ]<<7u ) );
-      u32Index++;
-      u32Index++;
-      u32Index++;
+      pu32Heap[ u32Size++ ] = u32Track;
     }
-    else if( ( gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & ~MIDI_SYSEX_MASK ) == MIDI_SYSEX )
+  }
+  for( u32Index = u32Size/2u; u32Index > 0u; u32Index-- )
+  {
+    Heap_SiftDown( pu32Heap, u32Size, u32Index - 1u );
+  }
+
+  gu32Tempo = MIDI_DEFAULT_TEMPO;
+  gu32TempoStartTick = 0u;
+  gu64TempoStart = 0u;
+  gu32LastEventTimeMs = 0u;
+  while( 0u != u32Size )
+  {
+    u32Track = pu32Heap[ 0u ];
+    psEvent = &gasMidiTracks[ u32Track ].psEvents[ gasMidiTracks[ u32Track ].u32Next++ ];
+    if( MIDI_METAEVENT == psEvent->u8Status )
     {
-      printf( "Sysex message\n" );
-      // Variable length
-      u32Index++;
-      for( u32SpecialLength = gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ]; gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] > 0x7Fu; u32Index++ )
+      // Set tempo: the time of the change is exact in the units of gu64TempoStart
+      gu64TempoStart += (U64)( psEvent->u32Tick - gu32TempoStartTick )*gu32Tempo;
+      gu32TempoStartTick = psEvent->u32Tick;
+      gu32Tempo = psEvent->u32Tempo;
+      if( 0u == psEvent->u32Tick )
       {
-        u32SpecialLength = u32SpecialLength<<7u;
-        u32SpecialLength |= ( gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index+1u ] & 0x7Fu );
+        gfMsPerBeat = gu32Tempo/1000.0;
       }
-      u32Index += u32SpecialLength  + 1u;
     }
-    else if( ( gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] & ~MIDI_METAEVENT_MASK ) == MIDI_METAEVENT )
+    else
     {
-      // FF + type + variable length + payload
-      printf( "Meta event, type: %u\n", gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index+1u ] );
-      // Variable length
-      u32Index++;
-      u32Index++;
-      for( u32SpecialLength = gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ]; gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] > 0x7Fu; u32Index++ )
-      {
-        u32SpecialLength = u32SpecialLength<<7u;
-        u32SpecialLength |= ( gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index+1u ] & 0x7Fu );
-      }
-      u32Index += u32SpecialLength + 1u;
+      AddChannelEvent( psEvent, GetTimeMs( psEvent->u32Tick ) );
+    }
+
+    // The next event of the track, or the track is done
+    if( gasMidiTracks[ u32Track ].u32Next >= gasMidiTracks[ u32Track ].u32Count )
+    {
+      pu32Heap[ 0u ] = pu32Heap[ --u32Size ];
+    }
+    Heap_SiftDown( pu32Heap, u32Size, 0u );
+  }
+
+  free( pu32Heap );
+}
+
+ /*! *******************************************************************
+ * \brief  Adds a wait to the track, up to the time of the next event
+ * \param  u8Channel: channel of the next event
+ * \param  u32TimeMs: time of the next event (ms)
+ * \return -
+ *********************************************************************/
+static void Track_WaitUntil( U8 u8Channel, U32 u32TimeMs )
+{
+  if( gu32LastEventTimeMs != u32TimeMs )
+  {
+    Track_AddEvent( u8Channel, TRACKER_OPCODE_WAITMS, u32TimeMs - gu32LastEventTimeMs );
+    gu32LastEventTimeMs = u32TimeMs;
+  }
+}
+
+ /*! *******************************************************************
+ * \brief  Sets the instrument and the modulation of a tracker channel
+ * \param  u8Voice: the tracker channel
+ * \param  u8Instrument: instrument slot of the next note
+ * \param  psChannel: the MIDI channel, its bend and vibrato are taken
+ * \return -
+ * \note   Only what differs from the state of the tracker channel is added
+ *********************************************************************/
+static void SetVoice( U8 u8Voice, U8 u8Instrument, S_CHANNEL_STATE const* psChannel )
+{
+  S_CHANNEL_STATE* psVoice = &gasVoiceStates[ u8Voice ];
+
+  if( u8Instrument != psVoice->u8Instrument )
+  {
+    if( u8Instrument >= SYNTH_INSTRUMENT_MODULE )
+    {
+      Track_AddEvent( u8Voice, TRACKER_OPCODE_INSTRUMENTBIND, u8Instrument - SYNTH_INSTRUMENT_MODULE );
     }
     else
     {
-      printf( "Unknown MIDI event token: 0x%x\n", gapsMidiChunks[ u32Chunk ].pu8ChunkBody[ u32Index ] );
-      u32Index++;
+      Track_AddEvent( u8Voice, TRACKER_OPCODE_INSTRUMENTCHANGE, u8Instrument );
+    }
+    psVoice->u8Instrument = u8Instrument;
+  }
+  if( psChannel->i16Bend != psVoice->i16Bend )
+  {
+    Track_AddEvent( u8Voice, TRACKER_OPCODE_PITCHBEND, (U32)(I32)psChannel->i16Bend );
+    psVoice->i16Bend = psChannel->i16Bend;
+  }
+  if( psChannel->u32Vibrato != psVoice->u32Vibrato )
+  {
+    Track_AddEvent( u8Voice, TRACKER_OPCODE_VIBRATO, psChannel->u32Vibrato );
+    psVoice->u32Vibrato = psChannel->u32Vibrato;
+  }
+}
+
+ /*! *******************************************************************
+ * \brief  Adds the tracker events of a MIDI channel event
+ * \param  psEvent: the event
+ * \param  u32TimeMs: time of the event (ms)
+ * \return -
+ * \note   A tracker channel plays one note at a time, so the notes are
+ *         allocated to the tracker channels by the voice allocator, and the
+ *         instrument and modulation of the MIDI channel go with them.
+ *********************************************************************/
+static void AddChannelEvent( S_MIDI_EVENT const* psEvent, U32 u32TimeMs )
+{
+  U8  u8Channel = psEvent->u8Status & MIDI_NOTE_OFF_MASK;
+  S_CHANNEL_STATE* psChannel = &gasMidiChannels[ u8Channel ];
+  U32 u32Clock;
+  U8  u8Instrument;
+  U8  u8Voice;
+
+  Log( "Tick: %u, abstime: %u\n", (unsigned)psEvent->u32Tick, (unsigned)u32TimeMs );
+  if( ( ( psEvent->u8Status & ~MIDI_NOTE_OFF_MASK ) == MIDI_NOTE_OFF )
+   || ( ( ( psEvent->u8Status & ~MIDI_NOTE_ON_MASK ) == MIDI_NOTE_ON ) && ( 0u == psEvent->au8Data[ 1u ] ) ) )
+  {
+    // A note on with 0 velocity is a note off too, it is often used with running status
+    // Note off event
+    Log( "Note off, channel: %u, note: %u, velocity: %u\n", u8Channel, psEvent->au8Data[ 0u ], psEvent->au8Data[ 1u ] );
+    u8Voice = Voice_NoteOff( u8Channel, psEvent->au8Data[ 0u ] );
+    if( VOICE_NONE != u8Voice )
+    {
+      Track_WaitUntil( u8Voice, u32TimeMs );
+      Track_AddEvent( u8Voice, TRACKER_OPCODE_KEYOFF, 0u );
+    }
+  }
+  else if( ( psEvent->u8Status & ~MIDI_NOTE_ON_MASK ) == MIDI_NOTE_ON )
+  {
+    // Note on event
+    Log( "Note on, channel: %u, note: %u, velocity: %u\n", u8Channel, psEvent->au8Data[ 0u ], psEvent->au8Data[ 1u ] );
+    if( MIDI_PERCUSSION_CHANNEL == u8Channel )
+    {
+      // Percussion: the note selects the drum, not the pitch
+      u32Clock = GetPercussion( psEvent->au8Data[ 0u ], &u8Instrument );
+      u8Voice = Voice_NoteOn( u8Channel, psEvent->au8Data[ 0u ], VOICE_PRIORITY_PERCUSSION );
+    }
+    else
+    {
+      u32Clock = GetNotePhaseIncrease( psEvent->au8Data[ 0u ] );
+      u8Instrument = psChannel->u8Instrument;
+      u8Voice = Voice_NoteOn( u8Channel, psEvent->au8Data[ 0u ], VOICE_PRIORITY_NOTE );
+    }
+    if( VOICE_NONE != u8Voice )
+    {
+      Track_WaitUntil( u8Voice, u32TimeMs );
+      SetVoice( u8Voice, u8Instrument, psChannel );
+      Track_AddEvent( u8Voice, TRACKER_OPCODE_KEYON, u32Clock );
+    }
+  }
+  else if( ( psEvent->u8Status & ~MIDI_POLY_ON_MASK ) == MIDI_POLY_ON )
+  {
+    // Polyphonic key pressure event
+    Log( "Polyphonic key pressure, channel: %u, note: %u, velocity: %u\n", u8Channel, psEvent->au8Data[ 0u ], psEvent->au8Data[ 1u ] );
+  }
+  else if( ( psEvent->u8Status & ~MIDI_CTRL_CHANGE_MASK ) == MIDI_CTRL_CHANGE )
+  {
+    // Control change event
+    Log( "Control change, channel: %u, control number: %u, control value: %u\n", u8Channel, psEvent->au8Data[ 0u ], psEvent->au8Data[ 1u ] );
+    if( MIDI_CTRL_MODULATION == psEvent->au8Data[ 0u ] )
+    {
+      // Modulation wheel: vibrato with a fixed rate
+      psChannel->u32Vibrato = TRACKER_VIBRATO( ( psEvent->au8Data[ 1u ]*VIBRATO_MAX_DEPTH )/127u, VIBRATO_RATE );
+    }
+  }
+  else if( ( psEvent->u8Status & ~MIDI_PROG_CHANGE_MASK ) == MIDI_PROG_CHANGE )
+  {
+    // Program change event
+    Log( "Program change, channel: %u, new program: %u\n", u8Channel, psEvent->au8Data[ 0u ] );
+    if( ( TRUE == gbInstruments ) && ( MIDI_PERCUSSION_CHANNEL != u8Channel ) )
+    {
+      // The instrument of the module made for the family of the program, from the next note
+      psChannel->u8Instrument = SYNTH_INSTRUMENT_MODULE + GetProgramInstrument( psEvent->au8Data[ 0u ] );
+    }
+  }
+  else if( ( psEvent->u8Status & ~MIDI_CHANNEL_PRESSURE_CHANGE_MASK ) == MIDI_CHANNEL_PRESSURE_CHANGE )
+  {
+    // Channel pressure change event
+    Log( "Channel pressure change, channel: %u, new pressure: %u\n", u8Channel, psEvent->au8Data[ 0u ] );
+  }
+  else  // MIDI_PITCH_BEND_CHANGE
+  {
+    // Pitch bend change event
+    Log( "Pitch bend change, channel: %u, pitch bend: %u\n", u8Channel, psEvent->au8Data[ 0u ] + ( (U16)psEvent->au8Data[ 1u ]<<7u ) );
+    // 14-bit value, converted to 1/SYNTH_PITCH_SEMITONE semitones
+    psChannel->i16Bend = (I16)( ( ( (I32)psEvent->au8Data[ 0u ] + ( (I32)psEvent->au8Data[ 1u ]<<7u ) - (I32)MIDI_PITCH_BEND_CENTER )
+                                *(I32)( MIDI_PITCH_BEND_RANGE*SYNTH_PITCH_SEMITONE ) )/(I32)MIDI_PITCH_BEND_CENTER );
+  }
+
+  // The modulation changes the notes of the channel that sound
+  if( ( ( psEvent->u8Status & ~MIDI_CTRL_CHANGE_MASK ) == MIDI_CTRL_CHANGE ) || ( ( psEvent->u8Status & ~MIDI_PITCH_BEND_CHANGE_MASK ) == MIDI_PITCH_BEND_CHANGE ) )
+  {
+    for( u8Voice = 0u; u8Voice < TRACKER_NUMBER_OF_CHANNELS; u8Voice++ )
+    {
+      if( TRUE == Voice_IsPlaying( u8Voice, u8Channel ) )
+      {
+        Track_WaitUntil( u8Voice, u32TimeMs );
+        SetVoice( u8Voice, gasVoiceStates[ u8Voice ].u8Instrument, psChannel );
+      }
     }
   }
 }
@@ -265,7 +856,7 @@ void ParseStream( U32 u32Chunk )
  *********************************************************************/
 void Track_Init( void )
 {
-
+  gu32TrackerInstructions = 0u;
 }
 
  /*! *******************************************************************
@@ -279,7 +870,7 @@ static void Track_AddEvent( U8 u8Channel, E_TRACKER_OPCODE eOpCode, U32 u32Opera
 {
   S_TRACKER_INSTRUCTION sNewInstruction;
 
-  if( u8Channel >= NUMBER_OF_OSCILLATORS )
+  if( u8Channel >= TRACKER_NUMBER_OF_CHANNELS )
   {
     printf( "Fatal error: there is no channel %u!\n", u8Channel );
     exit(-1);
@@ -289,20 +880,565 @@ static void Track_AddEvent( U8 u8Channel, E_TRACKER_OPCODE eOpCode, U32 u32Opera
   sNewInstruction.u8OpCode = (U8)eOpCode;
   sNewInstruction.u32Operand = u32Operand;
 
-  gu32TrackerInstructions++;
+  // allocate RAM, the capacity doubles so the instructions are not copied at every event
+  if( gu32TrackerInstructions >= gu32TrackerCapacity )
+  {
+    gu32TrackerCapacity = ( 0u == gu32TrackerCapacity ) ? 1024u : 2u*gu32TrackerCapacity;
+    gasTrackerInstructions = realloc( gasTrackerInstructions, gu32TrackerCapacity*sizeof( S_TRACKER_INSTRUCTION ) );
+    if( NULL == gasTrackerInstructions )
+    {
+      printf( "Out of memory!\n" );
+      exit(-1);
+    }
+  }
+
+  // Write new instruction
+  gasTrackerInstructions[ gu32TrackerInstructions++ ] = sNewInstruction;
+}
 
-  // allocate RAM
-  if( NULL != gasTrackerInstructions )
+ /*! *******************************************************************
+ * \brief  Appends a byte to a buffer
+ * \param  psBuffer: the buffer, that grows as needed
+ * \param  u8Byte: the byte
+ * \return -
+ *********************************************************************/
+static void Buffer_Put( S_BUFFER* psBuffer, U8 u8Byte )
+{
+  if( psBuffer->u32Size >= psBuffer->u32Capacity )
   {
-    gasTrackerInstructions = realloc( gasTrackerInstructions, gu32TrackerInstructions*sizeof( S_TRACKER_INSTRUCTION ) );
+    psBuffer->u32Capacity = ( 0u == psBuffer->u32Capacity ) ? 256u : 2u*psBuffer->u32Capacity;
+    psBuffer->pu8Data = realloc( psBuffer->pu8Data, psBuffer->u32Capacity );
+    if( NULL == psBuffer->pu8Data )
+    {
+      printf( "Out of memory!\n" );
+      exit(-1);
+    }
   }
-  else  // first call
+  psBuffer->pu8Data[ psBuffer->u32Size++ ] = u8Byte;
+}
+
+ /*! *******************************************************************
+ * \brief  Appends a variable length number of the compact module format
+ * \param  psBuffer: the buffer
+ * \param  u32Value: the number
+ * \return -
+ *********************************************************************/
+static void Buffer_PutVarInt( S_BUFFER* psBuffer, U32 u32Value )
+{
+  while( u32Value >= 0x80u )
   {
-    gasTrackerInstructions = malloc( gu32TrackerInstructions*sizeof( S_TRACKER_INSTRUCTION ) );
+    Buffer_Put( psBuffer, (U8)( u32Value | 0x80u ) );
+    u32Value >>= 7u;
   }
+  Buffer_Put( psBuffer, (U8)u32Value );
+}
 
-  // Write new instruction
-  gasTrackerInstructions[ gu32TrackerInstructions-1u ] = sNewInstruction;
+ /*! *******************************************************************
+ * \brief  Appends an instruction in the compact module format
+ * \param  psBuffer: the buffer
+ * \param  u8Channel: channel of the instruction
+ * \param  u8OpCode: opcode according to E_TRACKER_OPCODE
+ * \param  u32Operand: operand, index of the note table for KEYON, of the pattern for CALL
+ * \return -
+ *********************************************************************/
+static void Buffer_PutInstruction( S_BUFFER* psBuffer, U8 u8Channel, U8 u8OpCode, U32 u32Operand )
+{
+  Buffer_Put( psBuffer, (U8)( ( ( TRACKER_OPCODE_END == u8OpCode ) ? TRACKER_CODE_END : u8OpCode )<<TRACKER_CODE_OPCODE_SHIFT ) | u8Channel );
+  switch( u8OpCode )
+  {
+    case TRACKER_OPCODE_KEYON:
+    case TRACKER_OPCODE_INSTRUMENTCHANGE:
+    case TRACKER_OPCODE_INSTRUMENTBIND:
+    case TRACKER_OPCODE_CALL:
+      Buffer_Put( psBuffer, (U8)u32Operand );
+      break;
+
+    case TRACKER_OPCODE_WAITMS:
+    case TRACKER_OPCODE_VIBRATO:
+      Buffer_PutVarInt( psBuffer, u32Operand );
+      break;
+
+    case TRACKER_OPCODE_PITCHBEND:
+      // Zigzag: small negative bends stay short too
+      u32Operand = (U32)(I32)(I16)u32Operand;
+      Buffer_PutVarInt( psBuffer, ( u32Operand<<1u ) ^ ( 0u - ( u32Operand>>31u ) ) );
+      break;
+
+    default:  // No operand
+      break;
+  }
+}
+
+ /*! *******************************************************************
+ * \brief  Appends the snapshot of the channels for the seek table
+ * \param  psBuffer: the buffer
+ * \param  psChannels: state of the channels
+ * \return -
+ * \note   Only the differences from the state at the start of the song
+ *         are written. The modulation comes before the KEYON, as the
+ *         note inherits it.
+ *********************************************************************/
+static void Buffer_PutSnapshot( S_BUFFER* psBuffer, S_CHANNEL_STATE const* psChannels )
+{
+  U8 u8Channel;
+
+  for( u8Channel = 0u; u8Channel < TRACKER_NUMBER_OF_CHANNELS; u8Channel++ )
+  {
+    if( psChannels[ u8Channel ].u8Instrument >= SYNTH_INSTRUMENT_MODULE )
+    {
+      Buffer_PutInstruction( psBuffer, u8Channel, TRACKER_OPCODE_INSTRUMENTBIND, psChannels[ u8Channel ].u8Instrument - SYNTH_INSTRUMENT_MODULE );
+    }
+    else if( GetDefaultInstrument( u8Channel ) != psChannels[ u8Channel ].u8Instrument )
+    {
+      Buffer_PutInstruction( psBuffer, u8Channel, TRACKER_OPCODE_INSTRUMENTCHANGE, psChannels[ u8Channel ].u8Instrument );
+    }
+    if( 0 != psChannels[ u8Channel ].i16Bend )
+    {
+      Buffer_PutInstruction( psBuffer, u8Channel, TRACKER_OPCODE_PITCHBEND, (U32)(I32)psChannels[ u8Channel ].i16Bend );
+    }
+    if( 0u != psChannels[ u8Channel ].u32Vibrato )
+    {
+      Buffer_PutInstruction( psBuffer, u8Channel, TRACKER_OPCODE_VIBRATO, psChannels[ u8Channel ].u32Vibrato );
+    }
+    if( CHANNEL_NOTE_NONE != psChannels[ u8Channel ].u16Note )
+    {
+      Buffer_PutInstruction( psBuffer, u8Channel, TRACKER_OPCODE_KEYON, psChannels[ u8Channel ].u16Note );
+    }
+  }
+  Buffer_PutInstruction( psBuffer, 0u, TRACKER_OPCODE_END, 0u );
+}
+
+ /*! *******************************************************************
+ * \brief  Returns the instrument of a channel at the start of the song
+ * \param  u8Channel: the channel
+ * \return Instrument slot, as in the tracker
+ *********************************************************************/
+static U8 GetDefaultInstrument( U8 u8Channel )
+{
+  return ( TRACKER_PERCUSSION_CHANNEL == u8Channel ) ? SYNTH_INSTRUMENT_DRUM : SYNTH_INSTRUMENT_SINE;
+}
+
+ /*! *******************************************************************
+ * \brief  Returns the size of an instruction in the compact module format
+ * \param  psInstruction: the instruction, index of the note table for KEYON
+ * \return Bytes
+ *********************************************************************/
+static U32 GetInstructionSize( S_TRACKER_INSTRUCTION const* psInstruction )
+{
+  static S_BUFFER sScratch = { NULL, 0u, 0u };
+
+  sScratch.u32Size = 0u;
+  Buffer_PutInstruction( &sScratch, psInstruction->u8Channel, psInstruction->u8OpCode, psInstruction->u32Operand );
+  return sScratch.u32Size;
+}
+
+ /*! *******************************************************************
+ * \brief  Follows the channels and the time through an instruction
+ * \param  psInstruction: the instruction, index of the note table for KEYON
+ * \param  psPatterns: the patterns of the song
+ * \param  psChannels: state of the channels, updated
+ * \param  pu32TimeMs: time of the song (ms), updated
+ * \return -
+ * \note   A CALL plays its pattern as many times as the tracker does.
+ *********************************************************************/
+static void TrackInstruction( S_TRACKER_INSTRUCTION const* psInstruction, S_PATTERN const* psPatterns, S_CHANNEL_STATE* psChannels, U32* pu32TimeMs )
+{
+  U8  u8Channel = psInstruction->u8Channel;
+  U32 u32Operand = psInstruction->u32Operand;
+  U32 u32Index;
+  U8  u8Play;
+
+  switch( psInstruction->u8OpCode )
+  {
+    case TRACKER_OPCODE_KEYON:
+      psChannels[ u8Channel ].u16Note = (U16)u32Operand;
+      break;
+
+    case TRACKER_OPCODE_KEYOFF:
+      psChannels[ u8Channel ].u16Note = CHANNEL_NOTE_NONE;
+      break;
+
+    case TRACKER_OPCODE_WAITMS:
+      *pu32TimeMs += u32Operand;
+      break;
+
+    case TRACKER_OPCODE_INSTRUMENTCHANGE:
+      psChannels[ u8Channel ].u8Instrument = (U8)u32Operand;
+      break;
+
+    case TRACKER_OPCODE_INSTRUMENTBIND:
+      psChannels[ u8Channel ].u8Instrument = SYNTH_INSTRUMENT_MODULE + (U8)u32Operand;
+      break;
+
+    case TRACKER_OPCODE_PITCHBEND:
+      psChannels[ u8Channel ].i16Bend = (I16)u32Operand;
+      break;
+
+    case TRACKER_OPCODE_VIBRATO:
+      psChannels[ u8Channel ].u32Vibrato = u32Operand;
+      break;
+
+    case TRACKER_OPCODE_CALL:
+      for( u8Play = 0u; u8Play <= u8Channel; u8Play++ )
+      {
+        for( u32Index = 0u; u32Index < psPatterns[ u32Operand ].u32Length; u32Index++ )
+        {
+          TrackInstruction( &psPatterns[ u32Operand ].psInstructions[ u32Index ], psPatterns, psChannels, pu32TimeMs );
+        }
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+ /*! *******************************************************************
+ * \brief  Writes out track in the compact module format (version 2)
+ * \param  psOutFile: reference to the (open) out file
+ * \param  u32SeekMs: granularity of the seek table (ms), 0 for no table
+ * \param  bPatterns: TRUE to factor the repeated phrases of the song into patterns
+ * \return Size of the module in bytes
+ * \note   The distinct phase increases of the KEYONs go to the note
+ *         table, the instructions refer to them by index. The channels
+ *         are followed through the song to take the snapshots of the
+ *         seek table. The instruments of the programs and their triangle
+ *         wavetable are written before the byte code. The patterns stay
+ *         in RAM when the module is streamed, so they get what is left of
+ *         TRACKER_STREAM_TABLES_SIZE after the other tables. A module whose
+ *         tables are larger than that is written with a warning, it can
+ *         only be played from memory.
+ *********************************************************************/
+static U32 ExportCompact( FILE* psOutFile, U32 u32SeekMs, BOOL bPatterns )
+{
+  U32 au32Notes[ 255u ];
+  U8  u8NumberOfNotes = 0u;
+  U8  u8Note;
+  U8  u8Channel;
+  U8  u8OpCode;
+  U8  u8Pattern;
+  U8  u8NumberOfPatterns = 0u;
+  U32 u32Index;
+  U32 u32Operand;
+  U32 u32Pass;
+  U32 u32TimeMs;
+  U32 u32NextSeekMs;
+  U32 u32SeekTableSize;
+  U32 u32InstrumentsSize;
+  U32 u32PatternTableSize;
+  U32 u32WaveTableSize = 0u;
+  U32 u32WaveTableOffset = 0u;
+  U32 u32TablesEnd;
+  U32 u32SnapshotOffset;
+  U32 u32PatternOffset;
+  U32 u32CodeOffset;
+  U32 u32Budget = 0u;
+  U32 u32SongLength = gu32TrackerInstructions;
+  U32 au32PatternOffsets[ TRACKER_MAX_PATTERNS ];
+  BOOL bWaveTable = FALSE;
+  S_BUFFER sCode = { NULL, 0u, 0u };
+  S_BUFFER sSnapshots = { NULL, 0u, 0u };
+  S_BUFFER sPatterns = { NULL, 0u, 0u };
+  S_TRACKER_SEEK_ENTRY* psSeekEntries = NULL;
+  U32 u32SeekEntries = 0u;
+  U32 u32SeekCapacity = 0u;
+  S_TRACKER_INSTRUCTION* psSong;
+  S_PATTERN asPatterns[ TRACKER_MAX_PATTERNS ];
+  S_CHANNEL_STATE asChannels[ TRACKER_NUMBER_OF_CHANNELS ];
+  PACKED_TYPES_BEGIN
+  S_MODULE_HEADER_V2 sModuleHeader;
+  PACKED_TYPES_END
+
+  // Collect the notes
+  for( u32Index = 0u; u32Index < gu32TrackerInstructions; u32Index++ )
+  {
+    if( TRACKER_OPCODE_KEYON != gasTrackerInstructions[ u32Index ].u8OpCode )
+    {
+      continue;
+    }
+    for( u8Note = 0u; u8Note < u8NumberOfNotes; u8Note++ )
+    {
+      if( au32Notes[ u8Note ] == gasTrackerInstructions[ u32Index ].u32Operand )
+      {
+        break;
+      }
+    }
+    if( u8Note == u8NumberOfNotes )
+    {
+      if( u8NumberOfNotes >= sizeof( au32Notes )/sizeof( au32Notes[ 0u ] ) )
+      {
+        printf( "Fatal error: more than %u different notes!\n", (unsigned)( sizeof( au32Notes )/sizeof( au32Notes[ 0u ] ) ) );
+        exit(-1);
+      }
+      au32Notes[ u8NumberOfNotes++ ] = gasTrackerInstructions[ u32Index ].u32Operand;
+    }
+  }
+
+  // The song refers to the note table from now
+  psSong = malloc( gu32TrackerInstructions*sizeof( S_TRACKER_INSTRUCTION ) );
+  if( NULL == psSong )
+  {
+    printf( "Out of memory!\n" );
+    exit(-1);
+  }
+  for( u32Index = 0u; u32Index < gu32TrackerInstructions; u32Index++ )
+  {
+    psSong[ u32Index ] = gasTrackerInstructions[ u32Index ];
+    if( TRACKER_OPCODE_KEYON == psSong[ u32Index ].u8OpCode )
+    {
+      for( u8Note = 0u; au32Notes[ u8Note ] != psSong[ u32Index ].u32Operand; u8Note++ );
+      psSong[ u32Index ].u32Operand = u8Note;
+    }
+  }
+
+  // Sizes of the tables before the seek table
+  u32InstrumentsSize = ( 0u != gu8NumberOfInstruments ) ? ( sizeof( U8 ) + gu8NumberOfInstruments*sizeof( S_TRACKER_INSTRUMENT ) ) : 0u;
+  for( u8Note = 0u; u8Note < gu8NumberOfInstruments; u8Note++ )
+  {
+    if( TRACKER_VOICE_WAVETABLE == gasInstruments[ u8Note ].u8Voice )
+    {
+      bWaveTable = TRUE;
+      u32WaveTableSize = sizeof( U8 ) + sizeof( I16 )*TRIANGLE_TABLE_SIZE;  // with the padding at most
+    }
+  }
+
+  // Encode byte code, code offsets are relative to the byte code for now. With patterns the flat
+  // song is encoded first too: its seek table tells how much room is left for the patterns.
+  for( u32Pass = ( TRUE == bPatterns ) ? 0u : 1u; u32Pass < 2u; u32Pass++ )
+  {
+    if( ( TRUE == bPatterns ) && ( 1u == u32Pass ) )
+    {
+      u32Index = sizeof( S_MODULE_HEADER_V2 ) + sizeof( U32 )*u8NumberOfNotes + u32InstrumentsSize + u32WaveTableSize + sSnapshots.u32Size
+               + ( ( 0u != u32SeekEntries ) ? ( sizeof( U16 ) + u32SeekEntries*sizeof( S_TRACKER_SEEK_ENTRY ) ) : 0u );
+      u32Budget = ( u32Index < TRACKER_STREAM_TABLES_SIZE ) ? ( TRACKER_STREAM_TABLES_SIZE - u32Index ) : 0u;
+      u8NumberOfPatterns = Pattern_Factor( psSong, &u32SongLength, GetInstructionSize, u32Budget, asPatterns );
+      printf( "Patterns: %u, byte code of the song: %u -> ", u8NumberOfPatterns, (unsigned)sCode.u32Size );
+    }
+
+    for( u8Channel = 0u; u8Channel < TRACKER_NUMBER_OF_CHANNELS; u8Channel++ )
+    {
+      asChannels[ u8Channel ].u8Instrument = GetDefaultInstrument( u8Channel );
+      asChannels[ u8Channel ].i16Bend = 0;
+      asChannels[ u8Channel ].u32Vibrato = 0u;
+      asChannels[ u8Channel ].u16Note = CHANNEL_NOTE_NONE;
+    }
+    sCode.u32Size = 0u;
+    sSnapshots.u32Size = 0u;
+    u32SeekEntries = 0u;
+    u32TimeMs = 0u;
+    u32NextSeekMs = 0u;
+
+    for( u32Index = 0u; u32Index < u32SongLength; u32Index++ )
+    {
+      u8Channel = psSong[ u32Index ].u8Channel;
+      u8OpCode = psSong[ u32Index ].u8OpCode;
+      u32Operand = psSong[ u32Index ].u32Operand;
+
+      // First instruction at or after the next seek position, patterns are played through
+      if( ( 0u != u32SeekMs ) && ( u32TimeMs >= u32NextSeekMs ) && ( TRACKER_OPCODE_END != u8OpCode ) )
+      {
+        // The capacity doubles, and stays for the second pass
+        if( u32SeekEntries >= u32SeekCapacity )
+        {
+          u32SeekCapacity = ( 0u == u32SeekCapacity ) ? 64u : 2u*u32SeekCapacity;
+          psSeekEntries = realloc( psSeekEntries, u32SeekCapacity*sizeof( S_TRACKER_SEEK_ENTRY ) );
+        }
+        if( ( NULL == psSeekEntries ) || ( u32SeekEntries >= 0xFFFFu ) )
+        {
+          printf( "Fatal error: can not make the seek table!\n" );
+          exit(-1);
+        }
+        psSeekEntries[ u32SeekEntries ].u32TimeMs = u32TimeMs;
+        psSeekEntries[ u32SeekEntries ].u32CodeOffset = sCode.u32Size;
+        psSeekEntries[ u32SeekEntries ].u32SnapshotOffset = sSnapshots.u32Size;
+        u32SeekEntries++;
+        Buffer_PutSnapshot( &sSnapshots, asChannels );
+        u32NextSeekMs = ( u32TimeMs/u32SeekMs + 1u )*u32SeekMs;
+      }
+
+      TrackInstruction( &psSong[ u32Index ], asPatterns, asChannels, &u32TimeMs );
+      Buffer_PutInstruction( &sCode, u8Channel, u8OpCode, u32Operand );
+    }
+  }
+  if( TRUE == bPatterns )
+  {
+    printf( "%u bytes\n", (unsigned)sCode.u32Size );
+  }
+
+  // Encode the patterns, offsets are relative to the first for now
+  for( u8Pattern = 0u; u8Pattern < u8NumberOfPatterns; u8Pattern++ )
+  {
+    au32PatternOffsets[ u8Pattern ] = sPatterns.u32Size;
+    for( u32Index = 0u; u32Index < asPatterns[ u8Pattern ].u32Length; u32Index++ )
+    {
+      Buffer_PutInstruction( &sPatterns, asPatterns[ u8Pattern ].psInstructions[ u32Index ].u8Channel,
+                             asPatterns[ u8Pattern ].psInstructions[ u32Index ].u8OpCode,
+                             asPatterns[ u8Pattern ].psInstructions[ u32Index ].u32Operand );
+    }
+    Buffer_PutInstruction( &sPatterns, 0u, TRACKER_OPCODE_RETURN, 0u );
+    free( asPatterns[ u8Pattern ].psInstructions );
+  }
+
+  // Layout: header, note table, instruments, seek table, pattern table, wavetable at an even offset, snapshots, patterns, byte code
+  u32SeekTableSize = ( 0u != u32SeekEntries ) ? ( sizeof( U16 ) + u32SeekEntries*sizeof( S_TRACKER_SEEK_ENTRY ) ) : 0u;
+  u32PatternTableSize = ( 0u != u8NumberOfPatterns ) ? ( sizeof( U8 ) + u8NumberOfPatterns*sizeof( U16 ) ) : 0u;
+  u32TablesEnd = sizeof( S_MODULE_HEADER_V2 ) + sizeof( U32 )*u8NumberOfNotes + u32InstrumentsSize + u32SeekTableSize + u32PatternTableSize;
+  u32SnapshotOffset = u32TablesEnd;
+  if( TRUE == bWaveTable )
+  {
+    u32WaveTableOffset = ( u32TablesEnd + 1u ) & ~1u;
+    u32SnapshotOffset = u32WaveTableOffset + sizeof( I16 )*TRIANGLE_TABLE_SIZE;
+  }
+  u32PatternOffset = u32SnapshotOffset + sSnapshots.u32Size;
+  u32CodeOffset = u32PatternOffset + sPatterns.u32Size;
+  if( u32CodeOffset > 0xFFFFu )
+  {
+    printf( "Fatal error: the seek table is too large, use a coarser granularity!\n" );
+    exit(-1);
+  }
+  if( u32CodeOffset > TRACKER_STREAM_TABLES_SIZE )
+  {
+    printf( "Warning: the tables are larger than %u bytes, the module can not be streamed!\n", TRACKER_STREAM_TABLES_SIZE );
+  }
+
+  // Write header
+  memcpy( sModuleHeader.au8Magic, TRACKER_MODULE_MAGIC, sizeof( sModuleHeader.au8Magic ) );
+  sModuleHeader.u8Version = TRACKER_MODULE_VERSION;
+  sModuleHeader.u16CodeOffset = (U16)u32CodeOffset;
+  sModuleHeader.u8NumberOfNotes = u8NumberOfNotes;
+  sModuleHeader.u8Flags = ( 0u != u32SeekEntries ) ? TRACKER_FLAG_SEEK_TABLE : 0u;
+  if( 0u != gu8NumberOfInstruments )
+  {
+    sModuleHeader.u8Flags |= TRACKER_FLAG_INSTRUMENTS;
+  }
+  if( 0u != u8NumberOfPatterns )
+  {
+    sModuleHeader.u8Flags |= TRACKER_FLAG_PATTERNS;
+  }
+  fwrite( &sModuleHeader, sizeof( sModuleHeader ), 1u, psOutFile );
+
+  // Write note table, little endian
+  for( u8Note = 0u; u8Note < u8NumberOfNotes; u8Note++ )
+  {
+    WriteU32( psOutFile, au32Notes[ u8Note ] );
+  }
+
+  // Write instruments, little endian
+  if( 0u != gu8NumberOfInstruments )
+  {
+    putc( gu8NumberOfInstruments, psOutFile );
+    for( u8Note = 0u; u8Note < gu8NumberOfInstruments; u8Note++ )
+    {
+      putc( gasInstruments[ u8Note ].u8Voice, psOutFile );
+      putc( gasInstruments[ u8Note ].u8Curve, psOutFile );
+      if( TRACKER_VOICE_WAVETABLE == gasInstruments[ u8Note ].u8Voice )
+      {
+        WriteU16( psOutFile, (U16)u32WaveTableOffset );
+        WriteU16( psOutFile, TRIANGLE_TABLE_SIZE );
+      }
+      else
+      {
+        WriteU16( psOutFile, gasInstruments[ u8Note ].u16Reference );
+        WriteU16( psOutFile, gasInstruments[ u8Note ].u16WaveTableSize );
+      }
+      WriteU16( psOutFile, gasInstruments[ u8Note ].u16AttackMs );
+      WriteU16( psOutFile, gasInstruments[ u8Note ].u16DecayMs );
+      WriteU16( psOutFile, gasInstruments[ u8Note ].u16Sustain );
+      WriteU16( psOutFile, gasInstruments[ u8Note ].u16ReleaseMs );
+    }
+    printf( "Instruments: %u\n", gu8NumberOfInstruments );
+  }
+
+  // Write seek table
+  if( 0u != u32SeekEntries )
+  {
+    putc( (U8)u32SeekEntries, psOutFile );
+    putc( (U8)( u32SeekEntries>>8u ), psOutFile );
+    for( u32Index = 0u; u32Index < u32SeekEntries; u32Index++ )
+    {
+      WriteU32( psOutFile, psSeekEntries[ u32Index ].u32TimeMs );
+      WriteU32( psOutFile, psSeekEntries[ u32Index ].u32CodeOffset + u32CodeOffset );
+      WriteU32( psOutFile, psSeekEntries[ u32Index ].u32SnapshotOffset + u32SnapshotOffset );
+    }
+  }
+
+  // Write pattern table
+  if( 0u != u8NumberOfPatterns )
+  {
+    putc( u8NumberOfPatterns, psOutFile );
+    for( u8Pattern = 0u; u8Pattern < u8NumberOfPatterns; u8Pattern++ )
+    {
+      WriteU16( psOutFile, (U16)( au32PatternOffsets[ u8Pattern ] + u32PatternOffset ) );
+    }
+  }
+
+  // Write triangle wavetable: one period, from 0 up to the peak, down to the trough and back
+  if( TRUE == bWaveTable )
+  {
+    if( 0u != ( u32TablesEnd & 1u ) )
+    {
+      putc( 0u, psOutFile );
+    }
+    for( u32Index = 0u; u32Index < TRIANGLE_TABLE_SIZE; u32Index++ )
+    {
+      u32Operand = ( u32Index + TRIANGLE_TABLE_SIZE/4u ) % TRIANGLE_TABLE_SIZE;
+      u32Operand = ( u32Operand < TRIANGLE_TABLE_SIZE/2u ) ? u32Operand : ( TRIANGLE_TABLE_SIZE - u32Operand );
+      WriteU16( psOutFile, (U16)(I16)( ( (I32)u32Operand*4*32767 )/(I32)TRIANGLE_TABLE_SIZE - 32767 ) );
+    }
+  }
+
+  // Write snapshots
+  if( 0u != u32SeekEntries )
+  {
+    fwrite( sSnapshots.pu8Data, 1u, sSnapshots.u32Size, psOutFile );
+    printf( "Seek table: %u entries, %u bytes with the snapshots\n", (unsigned)u32SeekEntries, (unsigned)( u32SeekTableSize + sSnapshots.u32Size ) );
+  }
+
+  // Write patterns
+  if( 0u != u8NumberOfPatterns )
+  {
+    fwrite( sPatterns.pu8Data, 1u, sPatterns.u32Size, psOutFile );
+    printf( "Patterns: %u bytes with the table\n", (unsigned)( u32PatternTableSize + sPatterns.u32Size ) );
+  }
+
+  // Write byte code
+  fwrite( sCode.pu8Data, 1u, sCode.u32Size, psOutFile );
+
+  free( sCode.pu8Data );
+  free( sSnapshots.pu8Data );
+  free( sPatterns.pu8Data );
+  free( psSeekEntries );
+  free( psSong );
+
+  return u32CodeOffset + sCode.u32Size;
+}
+
+ /*! *******************************************************************
+ * \brief  Writes a 16-bit number, little endian
+ * \param  psOutFile: reference to the (open) out file
+ * \param  u16Value: the number
+ * \return -
+ *********************************************************************/
+static void WriteU16( FILE* psOutFile, U16 u16Value )
+{
+  putc( (U8)u16Value, psOutFile );
+  putc( (U8)( u16Value>>8u ), psOutFile );
+}
+
+ /*! *******************************************************************
+ * \brief  Writes a 32-bit number, little endian
+ * \param  psOutFile: reference to the (open) out file
+ * \param  u32Value: the number
+ * \return -
+ *********************************************************************/
+static void WriteU32( FILE* psOutFile, U32 u32Value )
+{
+  U8 u8Index;
+
+  for( u8Index = 0u; u8Index < sizeof( U32 ); u8Index++ )
+  {
+    putc( (U8)( u32Value>>( 8u*u8Index ) ), psOutFile );
+  }
 }
 
  /*! *******************************************************************
@@ -319,44 +1455,103 @@ static void Track_AddEvent( U8 u8Channel, E_TRACKER_OPCODE eOpCode, U32 u32Opera
  * \brief  Parses MIDI file
  * \param  pu8MidiFile: pointer to the MIDI file in memory
  * \param  u32MidiFileLength: the length of the MIDI file
+ * \param  bInstruments: TRUE to bind instruments defined in the module at the program changes
+ * \param  u8Voices: number of tracker channels the notes are allocated to
+ * \param  bVerbose: TRUE to print every event of the file
  * \return -
- * \note   The parsed file will be present in the memory
+ * \note   The parsed file will be present in the memory, the chunks
+ *         point into pu8MidiFile until Midi_Free()
  *********************************************************************/
-void Midi_Parse( U8* pu8MidiFile, U32 u32MidiFileLength )
+void Midi_Parse( U8* pu8MidiFile, U32 u32MidiFileLength, BOOL bInstruments, U8 u8Voices, BOOL bVerbose )
 {
   U8  au8ChunkType[ 4u ];
   U32 u32ChunkSize;
-  U32 u32Index = 0u;
-  U32 u32Time;
+  U32 u32Index;
+  U32 u32Track;
   U32 u32Channel;
+  S_CURSOR sCursor;
 
   // Initialization
   GenKeyFreqTable();
   Track_Init();
+  gbInstruments = bInstruments;
+  gbVerbose = bVerbose;
+  gu8NumberOfInstruments = 0u;
+  memset( gau8FamilyInstruments, FAMILY_INSTRUMENT_NONE, sizeof( gau8FamilyInstruments ) );
+  Voice_Init( u8Voices );
+  for( u32Channel = 0u; u32Channel < VOICE_MIDI_CHANNELS; u32Channel++ )
+  {
+    gasMidiChannels[ u32Channel ].u8Instrument = SYNTH_INSTRUMENT_SINE;
+    gasMidiChannels[ u32Channel ].i16Bend = 0;
+    gasMidiChannels[ u32Channel ].u32Vibrato = 0u;
+    gasMidiChannels[ u32Channel ].u16Note = CHANNEL_NOTE_NONE;
+  }
+  for( u32Channel = 0u; u32Channel < TRACKER_NUMBER_OF_CHANNELS; u32Channel++ )
+  {
+    gasVoiceStates[ u32Channel ] = gasMidiChannels[ 0u ];
+    gasVoiceStates[ u32Channel ].u8Instrument = GetDefaultInstrument( (U8)u32Channel );
+  }
 
   gu32ChunkNum = 0u;
-  gapsMidiChunks = malloc( sizeof( S_CHUNK ) );
+  gu16Division = 0u;
 
   // Search for chunks in file
   // by default, the file starts with a chunk
-  while( u32Index < u32MidiFileLength )  // u32Index == byte index inside of file!
+  Cursor_Init( &sCursor, pu8MidiFile, u32MidiFileLength );
+  while( sCursor.u32Position < sCursor.u32Size )
   {
     // Get information
-    au8ChunkType[ 0u ] = pu8MidiFile[ u32Index + 0u ];
-    au8ChunkType[ 1u ] = pu8MidiFile[ u32Index + 1u ];
-    au8ChunkType[ 2u ] = pu8MidiFile[ u32Index + 2u ];
-    au8ChunkType[ 3u ] = pu8MidiFile[ u32Index + 3u ];
-    u32ChunkSize = ( pu8MidiFile[ u32Index + 4u ]<<24u ) + ( pu8MidiFile[ u32Index + 5u ]<<16u ) + ( pu8MidiFile[ u32Index + 6u ]<<8u ) + ( pu8MidiFile[ u32Index + 7u ]<<0u );
-    // Store information
-    gapsMidiChunks = realloc( gapsMidiChunks, (gu32ChunkNum+1u)*sizeof( S_CHUNK ) );
+    for( u32Index = 0u; u32Index < sizeof( au8ChunkType ); u32Index++ )
+    {
+      au8ChunkType[ u32Index ] = Cursor_ReadU8( &sCursor );
+    }
+    u32ChunkSize = Cursor_ReadBigEndian( &sCursor, sizeof( u32ChunkSize ) );
+    if( TRUE == sCursor.bOverrun )
+    {
+      printf( "Warning: the bytes after the last chunk are ignored\n" );
+      break;
+    }
+    if( u32ChunkSize > ( sCursor.u32Size - sCursor.u32Position ) )
+    {
+      printf( "Warning: the last chunk is cut short by %u bytes\n", (unsigned)( u32ChunkSize - ( sCursor.u32Size - sCursor.u32Position ) ) );
+      u32ChunkSize = sCursor.u32Size - sCursor.u32Position;
+    }
+    // Store information, the capacity doubles
+    if( gu32ChunkNum >= gu32ChunkCapacity )
+    {
+      gu32ChunkCapacity = ( 0u == gu32ChunkCapacity ) ? 16u : 2u*gu32ChunkCapacity;
+      gapsMidiChunks = realloc( gapsMidiChunks, gu32ChunkCapacity*sizeof( S_CHUNK ) );
+      if( NULL == gapsMidiChunks )
+      {
+        printf( "Out of memory!\n" );
+        exit(-1);
+      }
+    }
     memcpy( gapsMidiChunks[ gu32ChunkNum ].au8ChunkType, au8ChunkType, sizeof( au8ChunkType ) );
     gapsMidiChunks[ gu32ChunkNum ].u32ChunkLength = u32ChunkSize;
-    gapsMidiChunks[ gu32ChunkNum ].pu8ChunkBody = &pu8MidiFile[ u32Index + sizeof( au8ChunkType ) + sizeof( u32ChunkSize ) ];
+    gapsMidiChunks[ gu32ChunkNum ].pu8ChunkBody = &pu8MidiFile[ sCursor.u32Position ];
     // Increment index
     gu32ChunkNum++;
-    u32Index += sizeof( au8ChunkType ) + sizeof( u32ChunkSize ) + u32ChunkSize;
+    Cursor_Skip( &sCursor, u32ChunkSize );
   }
 
+  // The tracks are allocated at once, their number is known from the chunks
+  u32Track = 0u;
+  for( u32Index = 0u; u32Index < gu32ChunkNum; u32Index++ )
+  {
+    if( 0 == memcmp( gapsMidiChunks[ u32Index ].au8ChunkType, "MTrk", sizeof( au8ChunkType ) ) )
+    {
+      u32Track++;
+    }
+  }
+  gasMidiTracks = malloc( ( ( 0u != u32Track ) ? u32Track : 1u )*sizeof( S_MIDI_TRACK ) );
+  if( NULL == gasMidiTracks )
+  {
+    printf( "Out of memory!\n" );
+    exit(-1);
+  }
+  gu32MidiTracks = 0u;
+
   // Parse chunks
   for( u32Index = 0u; u32Index < gu32ChunkNum; u32Index++ )
   {
@@ -364,9 +1559,15 @@ void Midi_Parse( U8* pu8MidiFile, U32 u32MidiFileLength )
     if( 0 == memcmp( gapsMidiChunks[ u32Index ].au8ChunkType, "MThd", sizeof( au8ChunkType ) ) )
     {
       // Headers contain 3 16-bit words
-      gu16Format = ( gapsMidiChunks[ u32Index ].pu8ChunkBody[ 0u ]<<8u ) + ( gapsMidiChunks[ u32Index ].pu8ChunkBody[ 1u ]<<0u );
-      gu16NumTracks = ( gapsMidiChunks[ u32Index ].pu8ChunkBody[ 2u ]<<8u ) + ( gapsMidiChunks[ u32Index ].pu8ChunkBody[ 3u ]<<0u );
-      gu16Division = ( gapsMidiChunks[ u32Index ].pu8ChunkBody[ 4u ]<<8u ) + ( gapsMidiChunks[ u32Index ].pu8ChunkBody[ 5u ]<<0u );
+      if( gapsMidiChunks[ u32Index ].u32ChunkLength < MIDI_HEADER_LENGTH )
+      {
+        printf( "Error: the MIDI header is too short!\n" );
+        exit(-1);
+      }
+      Cursor_Init( &sCursor, gapsMidiChunks[ u32Index ].pu8ChunkBody, gapsMidiChunks[ u32Index ].u32ChunkLength );
+      gu16Format = (U16)Cursor_ReadBigEndian( &sCursor, sizeof( U16 ) );
+      gu16NumTracks = (U16)Cursor_ReadBigEndian( &sCursor, sizeof( U16 ) );
+      gu16Division = (U16)Cursor_ReadBigEndian( &sCursor, sizeof( U16 ) );
       // Print to screen
       printf( "\nFound MIDI header:\n" );
       printf( "File format: %u\n", gu16Format );
@@ -381,7 +1582,7 @@ void Midi_Parse( U8* pu8MidiFile, U32 u32MidiFileLength )
       else  // <32768
       {
         printf( "(non-metric time)\n" );
-        gfMsPerBeat = 512.0/(gu16Division);
+        gfMsPerBeat = MIDI_DEFAULT_TEMPO/1000.0;
       }
     }
     // Track chunk
@@ -391,24 +1592,68 @@ void Midi_Parse( U8* pu8MidiFile, U32 u32MidiFileLength )
       ParseStream( u32Index );
     }
   }
+  if( 0u == gu16Division )
+  {
+    printf( "Error: no MIDI header, or its time division is 0!\n" );
+    exit(-1);
+  }
+  // The tracks are played at the same time
+  MergeTracks();
+  for( u32Track = 0u; u32Track < gu32MidiTracks; u32Track++ )
+  {
+    free( gasMidiTracks[ u32Track ].psEvents );
+  }
+  free( gasMidiTracks );
+  gasMidiTracks = NULL;
+  gu32MidiTracks = 0u;
+  Voice_PrintReport();
   // Add END event to signal the end of track
-  Track_AddEvent( u32Index, TRACKER_OPCODE_END, 0u );
+  Track_AddEvent( 0u, TRACKER_OPCODE_END, 0u );
+}
+
+ /*! *******************************************************************
+ * \brief  Frees the parsed file, so another one can be parsed
+ * \param  -
+ * \return -
+ *********************************************************************/
+void Midi_Free( void )
+{
+  free( gapsMidiChunks );
+  gapsMidiChunks = NULL;
+  gu32ChunkNum = 0u;
+  gu32ChunkCapacity = 0u;
+  free( gasTrackerInstructions );
+  gasTrackerInstructions = NULL;
+  gu32TrackerInstructions = 0u;
+  gu32TrackerCapacity = 0u;
 }
 
  /*! *******************************************************************
  * \brief  Writes out track
  * \param  psOutFile: reference to the (open) out file
+ * \param  bCompact: TRUE to write the compact format, otherwise version 1
+ * \param  u32SeekMs: granularity of the seek table (ms) of the compact format, 0 for none
+ * \param  bPatterns: TRUE to factor the repeated phrases into patterns, in the compact format
  * \return -
  *********************************************************************/
-void Midi_ExportTracker( FILE* psOutFile )
+void Midi_ExportTracker( FILE* psOutFile, BOOL bCompact, U32 u32SeekMs, BOOL bPatterns )
 {
-  U8  u8Channel;
   U32 u32Index;
+  U32 u32Size;
   PACKED_TYPES_BEGIN
   S_MODULE_HEADER sModuleHeader;
   PACKED_TYPES_END
 
-  // Put timing base
+  printf( "Size in version 1 format: %u bytes\n", (unsigned)( sizeof( S_MODULE_HEADER ) + gu32TrackerInstructions*sizeof( S_TRACKER_INSTRUCTION ) ) );
+  if( TRUE == bCompact )
+  {
+    u32Size = ExportCompact( psOutFile, u32SeekMs, bPatterns );
+    printf( "Size in compact format: %u bytes\n", (unsigned)u32Size );
+    return;
+  }
+
+  // Put timing base, the other fields are not used by the player
+  memset( &sModuleHeader, 0, sizeof( sModuleHeader ) );
   sModuleHeader.u16MsPerBeat = gfMsPerBeat;
 
   // Put music notes
@@ -416,7 +1661,7 @@ void Midi_ExportTracker( FILE* psOutFile )
 
   // Put music sheet offset
 //  sModuleHeader.u16MusicSheetOffset = sizeof( S_MODULE_HEADER ) + sizeof(U16)*sModuleHeader.u8NumberOfNotes + sizeof( S_INSTRUMENT ) + sizeof( sModuleInstruments.astWaveTable );
-#warning "^^ Ez csak 1 hangszerrel működik!"
+  // The version 1 format (-v1) has a single instrument, the compact format defines its own
 
   #define BINARY_OUTPUT
   #ifdef BINARY_OUTPUT
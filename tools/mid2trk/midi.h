@@ -37,8 +37,9 @@
 //--------------------------------------------------------------------------------------------------------/
 // Interface functions
 //--------------------------------------------------------------------------------------------------------/
-void Midi_Parse( U8* pu8MidiFile, U32 u32MidiFileLength );
-void Midi_ExportTracker( FILE* psOutFile );
+void Midi_Parse( U8* pu8MidiFile, U32 u32MidiFileLength, BOOL bInstruments, U8 u8Voices, BOOL bVerbose );
+void Midi_Free( void );
+void Midi_ExportTracker( FILE* psOutFile, BOOL bCompact, U32 u32SeekMs, BOOL bPatterns );
 
 
 #endif  // MIDI_H
@@ -0,0 +1,539 @@
+/*! *******************************************************************************************************
+* Copyright (c) 2018-2023 K. Sz. Horvath
+*
+* All rights reserved
+*
+* \file pattern.c
+*
+* \brief Factoring the repeated phrases of a song into patterns
+*
+* \author K. Sz. Horvath
+*
+**********************************************************************************************************/
+
+//--------------------------------------------------------------------------------------------------------/
+// Include files
+//--------------------------------------------------------------------------------------------------------/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+#include "tracker.h"
+
+// Own include
+#include "pattern.h"
+
+//--------------------------------------------------------------------------------------------------------/
+// Definitions
+//--------------------------------------------------------------------------------------------------------/
+#define PATTERN_TABLE_ENTRY_SIZE   ( sizeof( U16 ) )  //!< Bytes of an entry of the pattern table
+#define PATTERN_RANK_NONE                 (0xFFFFFFFFu)  //!< Rank of the empty suffix, before every other
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Types
+//--------------------------------------------------------------------------------------------------------/
+//! \brief A repeated phrase: an interval of the suffix array, the suffixes in it start with the same instructions
+typedef struct
+{
+  U32 u32Length;  //!< Number of instructions the suffixes share
+  U32 u32First;   //!< Index of the first suffix of the interval in the suffix array
+  U32 u32Last;    //!< Index of the last suffix of the interval
+  I32 i32Bound;   //!< Most bytes a pattern of the phrase can save, if no occurrences overlap
+} S_CANDIDATE;
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Global variables
+//--------------------------------------------------------------------------------------------------------/
+static S_TRACKER_INSTRUCTION* gpsSong;  //!< The song being factored
+static U32  gu32Length;                 //!< Number of instructions of the song
+static U32* gpu32Ids;                   //!< Equal instructions of the song have equal ids
+static U32* gpu32Ranks;                 //!< Rank of each suffix, by the instructions sorted so far
+static U32* gpu32Suffixes;              //!< Suffix array: the suffixes of the song in order
+static U32* gpu32Lcp;                   //!< Instructions shared by a suffix of the suffix array and the one before
+static U32* gpu32Offsets;               //!< Byte offset of each instruction in the compact format, and the size of the song
+static U32* gpu32Positions;             //!< Occurrences of the phrase being evaluated
+static U32  gu32SortStep;               //!< The suffixes are sorted by their first 2*gu32SortStep instructions
+static S_CANDIDATE* gpsCandidates;      //!< Repeated phrases that may save bytes
+static U32  gu32Candidates;
+static S_CANDIDATE* gpsStack;           //!< Open intervals while the candidates are collected
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Static function declarations
+//--------------------------------------------------------------------------------------------------------/
+static int CompareInstructions( void const* pvA, void const* pvB );
+static int CompareSuffixes( void const* pvA, void const* pvB );
+static int ComparePositions( void const* pvA, void const* pvB );
+static int CompareCandidates( void const* pvA, void const* pvB );
+static void AssignIds( void );
+static void SortSuffixes( void );
+static void BuildLcp( void );
+static void CollectCandidates( U32 u32CallSize, U32 u32FixedCost );
+static I32 Evaluate( S_CANDIDATE const* psCandidate, U32* pu32Selected, U32 u32CallSize, U32 u32FixedCost );
+static U8 GetDepth( U32 u32Start, U32 u32Length, S_PATTERN const* psPatterns );
+static void* Allocate( U32 u32Size );
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Static functions
+//--------------------------------------------------------------------------------------------------------/
+ /*! *******************************************************************
+ * \brief  Orders the instructions of the song, for the ids
+ * \param  pvA: index of an instruction
+ * \param  pvB: index of the other instruction
+ * \return <0, 0 or >0, like memcmp()
+ *********************************************************************/
+static int CompareInstructions( void const* pvA, void const* pvB )
+{
+  S_TRACKER_INSTRUCTION const* psA = &gpsSong[ *(U32 const*)pvA ];
+  S_TRACKER_INSTRUCTION const* psB = &gpsSong[ *(U32 const*)pvB ];
+
+  if( psA->u8OpCode != psB->u8OpCode )
+  {
+    return ( psA->u8OpCode < psB->u8OpCode ) ? -1 : 1;
+  }
+  if( psA->u8Channel != psB->u8Channel )
+  {
+    return ( psA->u8Channel < psB->u8Channel ) ? -1 : 1;
+  }
+  if( psA->u32Operand != psB->u32Operand )
+  {
+    return ( psA->u32Operand < psB->u32Operand ) ? -1 : 1;
+  }
+  return 0;
+}
+
+ /*! *******************************************************************
+ * \brief  Orders the suffixes by their first 2*gu32SortStep instructions
+ * \param  pvA: start of a suffix
+ * \param  pvB: start of the other suffix
+ * \return <0, 0 or >0, like memcmp()
+ *********************************************************************/
+static int CompareSuffixes( void const* pvA, void const* pvB )
+{
+  U32 u32A = *(U32 const*)pvA;
+  U32 u32B = *(U32 const*)pvB;
+  U32 u32RankA;
+  U32 u32RankB;
+
+  if( gpu32Ranks[ u32A ] != gpu32Ranks[ u32B ] )
+  {
+    return ( gpu32Ranks[ u32A ] < gpu32Ranks[ u32B ] ) ? -1 : 1;
+  }
+  // Ranks of the second halves; a suffix that ends first comes first
+  u32RankA = ( ( u32A + gu32SortStep ) < gu32Length ) ? gpu32Ranks[ u32A + gu32SortStep ] : PATTERN_RANK_NONE;
+  u32RankB = ( ( u32B + gu32SortStep ) < gu32Length ) ? gpu32Ranks[ u32B + gu32SortStep ] : PATTERN_RANK_NONE;
+  if( u32RankA != u32RankB )
+  {
+    return ( ( u32RankA + 1u ) < ( u32RankB + 1u ) ) ? -1 : 1;
+  }
+  return 0;
+}
+
+ /*! *******************************************************************
+ * \brief  Orders the occurrences of a phrase by their position in the song
+ * \param  pvA: an occurrence
+ * \param  pvB: the other occurrence
+ * \return <0 or >0
+ *********************************************************************/
+static int ComparePositions( void const* pvA, void const* pvB )
+{
+  return ( *(U32 const*)pvA < *(U32 const*)pvB ) ? -1 : 1;
+}
+
+ /*! *******************************************************************
+ * \brief  Orders the candidates by the most bytes they can save, the best first
+ * \param  pvA: a candidate
+ * \param  pvB: the other candidate
+ * \return <0, 0 or >0
+ *********************************************************************/
+static int CompareCandidates( void const* pvA, void const* pvB )
+{
+  S_CANDIDATE const* psA = (S_CANDIDATE const*)pvA;
+  S_CANDIDATE const* psB = (S_CANDIDATE const*)pvB;
+
+  if( psA->i32Bound != psB->i32Bound )
+  {
+    return ( psA->i32Bound > psB->i32Bound ) ? -1 : 1;
+  }
+  // Same saving: the longer phrase first, for a stable result
+  if( psA->u32Length != psB->u32Length )
+  {
+    return ( psA->u32Length > psB->u32Length ) ? -1 : 1;
+  }
+  return ( psA->u32First < psB->u32First ) ? -1 : 1;
+}
+
+ /*! *******************************************************************
+ * \brief  Gives the same id to the equal instructions of the song
+ * \param  -
+ * \return -
+ * \note   The ids are the initial ranks of the suffixes
+ *********************************************************************/
+static void AssignIds( void )
+{
+  U32 u32Index;
+  U32 u32Id = 0u;
+
+  for( u32Index = 0u; u32Index < gu32Length; u32Index++ )
+  {
+    gpu32Suffixes[ u32Index ] = u32Index;
+  }
+  qsort( gpu32Suffixes, gu32Length, sizeof( U32 ), CompareInstructions );
+  for( u32Index = 0u; u32Index < gu32Length; u32Index++ )
+  {
+    if( ( 0u != u32Index ) && ( 0 != CompareInstructions( &gpu32Suffixes[ u32Index - 1u ], &gpu32Suffixes[ u32Index ] ) ) )
+    {
+      u32Id++;
+    }
+    gpu32Ids[ gpu32Suffixes[ u32Index ] ] = u32Id;
+    gpu32Ranks[ gpu32Suffixes[ u32Index ] ] = u32Id;
+  }
+}
+
+ /*! *******************************************************************
+ * \brief  Builds the suffix array of the song by prefix doubling
+ * \param  -
+ * \return -
+ * \note   The ids must be assigned before, the suffixes are sorted by
+ *         them. At the end the rank of each suffix is its index in the
+ *         suffix array.
+ *********************************************************************/
+static void SortSuffixes( void )
+{
+  U32* pu32NewRanks = gpu32Lcp;  // the LCP array is built after
+  U32  u32Index;
+
+  for( gu32SortStep = 1u; ; gu32SortStep *= 2u )
+  {
+    qsort( gpu32Suffixes, gu32Length, sizeof( U32 ), CompareSuffixes );
+    pu32NewRanks[ gpu32Suffixes[ 0u ] ] = 0u;
+    for( u32Index = 1u; u32Index < gu32Length; u32Index++ )
+    {
+      pu32NewRanks[ gpu32Suffixes[ u32Index ] ] = pu32NewRanks[ gpu32Suffixes[ u32Index - 1u ] ]
+                                                + ( ( 0 != CompareSuffixes( &gpu32Suffixes[ u32Index - 1u ], &gpu32Suffixes[ u32Index ] ) ) ? 1u : 0u );
+    }
+    memcpy( gpu32Ranks, pu32NewRanks, gu32Length*sizeof( U32 ) );
+    if( ( gu32Length - 1u ) == gpu32Ranks[ gpu32Suffixes[ gu32Length - 1u ] ] )
+    {
+      break;  // every suffix is different
+    }
+  }
+}
+
+ /*! *******************************************************************
+ * \brief  Builds the LCP array from the suffix array (Kasai's algorithm)
+ * \param  -
+ * \return -
+ *********************************************************************/
+static void BuildLcp( void )
+{
+  U32 u32Index;
+  U32 u32Other;
+  U32 u32Shared = 0u;
+
+  gpu32Lcp[ 0u ] = 0u;
+  for( u32Index = 0u; u32Index < gu32Length; u32Index++ )
+  {
+    if( 0u == gpu32Ranks[ u32Index ] )
+    {
+      u32Shared = 0u;
+      continue;
+    }
+    // The suffix after this one shares one less with the suffix after the one before
+    u32Other = gpu32Suffixes[ gpu32Ranks[ u32Index ] - 1u ];
+    while( ( ( u32Index + u32Shared ) < gu32Length ) && ( ( u32Other + u32Shared ) < gu32Length )
+        && ( gpu32Ids[ u32Index + u32Shared ] == gpu32Ids[ u32Other + u32Shared ] ) )
+    {
+      u32Shared++;
+    }
+    gpu32Lcp[ gpu32Ranks[ u32Index ] ] = u32Shared;
+    if( 0u != u32Shared )
+    {
+      u32Shared--;
+    }
+  }
+}
+
+ /*! *******************************************************************
+ * \brief  Collects the repeated phrases that may save bytes
+ * \param  u32CallSize: bytes of a CALL
+ * \param  u32FixedCost: bytes of a pattern besides its instructions
+ * \return -
+ * \note   Every interval of the LCP array is a phrase, with as many
+ *         occurrences as suffixes in the interval. Each is found once,
+ *         with the help of a stack of the open intervals.
+ *********************************************************************/
+static void CollectCandidates( U32 u32CallSize, U32 u32FixedCost )
+{
+  U32 u32Top = 0u;
+  U32 u32Index;
+  U32 u32Lcp;
+  U32 u32First;
+  U32 u32Bytes;
+  S_CANDIDATE* psInterval;
+
+  gu32Candidates = 0u;
+  gpsStack[ 0u ].u32Length = 0u;
+  gpsStack[ 0u ].u32First = 0u;
+  for( u32Index = 1u; u32Index <= gu32Length; u32Index++ )
+  {
+    u32Lcp = ( u32Index < gu32Length ) ? gpu32Lcp[ u32Index ] : 0u;
+    u32First = u32Index - 1u;
+    while( u32Lcp < gpsStack[ u32Top ].u32Length )
+    {
+      // The interval is closed
+      psInterval = &gpsStack[ u32Top-- ];
+      psInterval->u32Last = u32Index - 1u;
+      u32First = psInterval->u32First;
+      u32Bytes = gpu32Offsets[ gpu32Suffixes[ u32First ] + psInterval->u32Length ] - gpu32Offsets[ gpu32Suffixes[ u32First ] ];
+      if( u32Bytes > u32CallSize )
+      {
+        psInterval->i32Bound = (I32)( ( psInterval->u32Last - u32First + 1u )*( u32Bytes - u32CallSize ) ) - (I32)( u32Bytes + u32FixedCost );
+        if( psInterval->i32Bound > 0 )
+        {
+          gpsCandidates[ gu32Candidates++ ] = *psInterval;
+        }
+      }
+    }
+    if( u32Lcp > gpsStack[ u32Top ].u32Length )
+    {
+      u32Top++;
+      gpsStack[ u32Top ].u32Length = u32Lcp;
+      gpsStack[ u32Top ].u32First = u32First;
+    }
+  }
+}
+
+ /*! *******************************************************************
+ * \brief  Calculates the bytes saved by a pattern of a phrase
+ * \param  psCandidate: the phrase
+ * \param  pu32Selected: number of the occurrences replaced, they are in gpu32Positions
+ * \param  u32CallSize: bytes of a CALL
+ * \param  u32FixedCost: bytes of a pattern besides its instructions
+ * \return Bytes saved, may be negative
+ * \note   The occurrences that overlap an earlier one are left. The ones
+ *         right after each other are played by one CALL, up to
+ *         TRACKER_MAX_PLAYS times.
+ *********************************************************************/
+static I32 Evaluate( S_CANDIDATE const* psCandidate, U32* pu32Selected, U32 u32CallSize, U32 u32FixedCost )
+{
+  U32 u32Count = psCandidate->u32Last - psCandidate->u32First + 1u;
+  U32 u32Length = psCandidate->u32Length;
+  U32 u32Selected = 0u;
+  U32 u32Calls = 0u;
+  U32 u32Plays = 0u;
+  U32 u32Bytes;
+  U32 u32Index;
+
+  memcpy( gpu32Positions, &gpu32Suffixes[ psCandidate->u32First ], u32Count*sizeof( U32 ) );
+  qsort( gpu32Positions, u32Count, sizeof( U32 ), ComparePositions );
+  for( u32Index = 0u; u32Index < u32Count; u32Index++ )
+  {
+    if( 0u != u32Selected )
+    {
+      if( gpu32Positions[ u32Index ] < ( gpu32Positions[ u32Selected - 1u ] + u32Length ) )
+      {
+        continue;  // overlaps
+      }
+      if( ( gpu32Positions[ u32Index ] == ( gpu32Positions[ u32Selected - 1u ] + u32Length ) ) && ( u32Plays < TRACKER_MAX_PLAYS ) )
+      {
+        u32Plays++;
+        gpu32Positions[ u32Selected++ ] = gpu32Positions[ u32Index ];
+        continue;
+      }
+    }
+    u32Calls++;
+    u32Plays = 1u;
+    gpu32Positions[ u32Selected++ ] = gpu32Positions[ u32Index ];
+  }
+
+  *pu32Selected = u32Selected;
+  u32Bytes = gpu32Offsets[ gpu32Positions[ 0u ] + u32Length ] - gpu32Offsets[ gpu32Positions[ 0u ] ];
+  return (I32)( u32Selected*u32Bytes ) - (I32)( u32Calls*u32CallSize + u32Bytes + u32FixedCost );
+}
+
+ /*! *******************************************************************
+ * \brief  Returns the call depth of a pattern made of a phrase
+ * \param  u32Start: first instruction of the phrase in the song
+ * \param  u32Length: number of instructions
+ * \param  psPatterns: the patterns made before
+ * \return 1, or one more than the deepest pattern called by the phrase
+ *********************************************************************/
+static U8 GetDepth( U32 u32Start, U32 u32Length, S_PATTERN const* psPatterns )
+{
+  U32 u32Index;
+  U8  u8Depth = 1u;
+
+  for( u32Index = u32Start; u32Index < ( u32Start + u32Length ); u32Index++ )
+  {
+    if( ( TRACKER_OPCODE_CALL == gpsSong[ u32Index ].u8OpCode ) && ( psPatterns[ gpsSong[ u32Index ].u32Operand ].u8Depth >= u8Depth ) )
+    {
+      u8Depth = psPatterns[ gpsSong[ u32Index ].u32Operand ].u8Depth + 1u;
+    }
+  }
+
+  return u8Depth;
+}
+
+ /*! *******************************************************************
+ * \brief  Allocates memory, or exits
+ * \param  u32Size: bytes to allocate
+ * \return The memory
+ *********************************************************************/
+static void* Allocate( U32 u32Size )
+{
+  void* pvMemory = malloc( ( 0u != u32Size ) ? u32Size : 1u );
+
+  if( NULL == pvMemory )
+  {
+    printf( "Out of memory!\n" );
+    exit(-1);
+  }
+
+  return pvMemory;
+}
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Interface functions
+//--------------------------------------------------------------------------------------------------------/
+ /*! *******************************************************************
+ * \brief  Factors the repeated phrases of a song into patterns
+ * \param  psSong: the instructions of the song, the phrases are replaced by CALLs
+ * \param  pu32Length: number of instructions of the song, updated
+ * \param  pfSize: returns the size of an instruction in the compact format
+ * \param  u32MaxBytes: the pattern table and the patterns must fit in this many bytes
+ * \param  psPatterns: the patterns are returned here, TRACKER_MAX_PATTERNS at most
+ * \return Number of patterns
+ * \note   Greedy: the phrase that saves the most bytes is made a pattern,
+ *         then the song is searched again, until nothing can be saved.
+ *         The repeated phrases are the intervals of the LCP array of the
+ *         suffix array of the song. A later phrase may contain the CALLs
+ *         of the earlier patterns, up to TRACKER_CALL_DEPTH deep.
+ *********************************************************************/
+U8 Pattern_Factor( S_TRACKER_INSTRUCTION* psSong, U32* pu32Length, pPatternSizeFunction pfSize, U32 u32MaxBytes, S_PATTERN* psPatterns )
+{
+  S_TRACKER_INSTRUCTION sInstruction;
+  S_CANDIDATE const* psBest;
+  U32 u32CallSize;
+  U32 u32ReturnSize;
+  U32 u32FixedCost;
+  U32 u32PatternBytes = sizeof( U8 );  // number of patterns
+  U32 u32Bytes;
+  U32 u32Selected;
+  U32 u32Index;
+  U32 u32Candidate;
+  U32 u32Out;
+  U32 u32Plays;
+  I32 i32Saved;
+  I32 i32Best;
+  U8  u8Patterns = 0u;
+
+  gpsSong = psSong;
+  gu32Length = *pu32Length;
+  gpu32Ids = Allocate( gu32Length*sizeof( U32 ) );
+  gpu32Ranks = Allocate( gu32Length*sizeof( U32 ) );
+  gpu32Suffixes = Allocate( gu32Length*sizeof( U32 ) );
+  gpu32Lcp = Allocate( gu32Length*sizeof( U32 ) );
+  gpu32Offsets = Allocate( ( gu32Length + 1u )*sizeof( U32 ) );
+  gpu32Positions = Allocate( gu32Length*sizeof( U32 ) );
+  gpsCandidates = Allocate( gu32Length*sizeof( S_CANDIDATE ) );
+  gpsStack = Allocate( ( gu32Length + 1u )*sizeof( S_CANDIDATE ) );
+
+  sInstruction.u8Channel = 0u;
+  sInstruction.u8OpCode = TRACKER_OPCODE_CALL;
+  sInstruction.u32Operand = 0u;
+  u32CallSize = pfSize( &sInstruction );
+  sInstruction.u8OpCode = TRACKER_OPCODE_RETURN;
+  u32ReturnSize = pfSize( &sInstruction );
+  u32FixedCost = u32ReturnSize + PATTERN_TABLE_ENTRY_SIZE;
+
+  while( ( u8Patterns < TRACKER_MAX_PATTERNS ) && ( gu32Length > 1u ) )
+  {
+    gpu32Offsets[ 0u ] = 0u;
+    for( u32Index = 0u; u32Index < gu32Length; u32Index++ )
+    {
+      gpu32Offsets[ u32Index + 1u ] = gpu32Offsets[ u32Index ] + pfSize( &gpsSong[ u32Index ] );
+    }
+    AssignIds();
+    SortSuffixes();
+    BuildLcp();
+    CollectCandidates( u32CallSize, u32FixedCost );
+    qsort( gpsCandidates, gu32Candidates, sizeof( S_CANDIDATE ), CompareCandidates );
+
+    // Exact savings of the candidates, until none of the rest can be better
+    psBest = NULL;
+    i32Best = 0;
+    for( u32Candidate = 0u; ( u32Candidate < gu32Candidates ) && ( gpsCandidates[ u32Candidate ].i32Bound > i32Best ); u32Candidate++ )
+    {
+      u32Index = gpu32Suffixes[ gpsCandidates[ u32Candidate ].u32First ];
+      u32Bytes = gpu32Offsets[ u32Index + gpsCandidates[ u32Candidate ].u32Length ] - gpu32Offsets[ u32Index ];
+      if( ( ( u32PatternBytes + u32Bytes + u32FixedCost ) > u32MaxBytes )
+       || ( GetDepth( u32Index, gpsCandidates[ u32Candidate ].u32Length, psPatterns ) > TRACKER_CALL_DEPTH ) )
+      {
+        continue;
+      }
+      i32Saved = Evaluate( &gpsCandidates[ u32Candidate ], &u32Selected, u32CallSize, u32FixedCost );
+      if( i32Saved > i32Best )
+      {
+        i32Best = i32Saved;
+        psBest = &gpsCandidates[ u32Candidate ];
+      }
+    }
+    if( NULL == psBest )
+    {
+      break;
+    }
+
+    // Make the pattern of the first occurrence
+    Evaluate( psBest, &u32Selected, u32CallSize, u32FixedCost );
+    psPatterns[ u8Patterns ].u32Length = psBest->u32Length;
+    psPatterns[ u8Patterns ].u8Depth = GetDepth( gpu32Positions[ 0u ], psBest->u32Length, psPatterns );
+    psPatterns[ u8Patterns ].psInstructions = Allocate( psBest->u32Length*sizeof( S_TRACKER_INSTRUCTION ) );
+    memcpy( psPatterns[ u8Patterns ].psInstructions, &gpsSong[ gpu32Positions[ 0u ] ], psBest->u32Length*sizeof( S_TRACKER_INSTRUCTION ) );
+    u32PatternBytes += gpu32Offsets[ gpu32Positions[ 0u ] + psBest->u32Length ] - gpu32Offsets[ gpu32Positions[ 0u ] ] + u32FixedCost;
+
+    // Replace the occurrences by CALLs, the ones right after each other by one
+    u32Out = 0u;
+    u32Candidate = 0u;
+    u32Index = 0u;
+    while( u32Index < gu32Length )
+    {
+      if( ( u32Candidate < u32Selected ) && ( u32Index == gpu32Positions[ u32Candidate ] ) )
+      {
+        for( u32Plays = 1u; ( ( u32Candidate + u32Plays ) < u32Selected ) && ( u32Plays < TRACKER_MAX_PLAYS )
+                         && ( gpu32Positions[ u32Candidate + u32Plays ] == ( u32Index + u32Plays*psBest->u32Length ) ); u32Plays++ );
+        gpsSong[ u32Out ].u8Channel = (U8)( u32Plays - 1u );
+        gpsSong[ u32Out ].u8OpCode = TRACKER_OPCODE_CALL;
+        gpsSong[ u32Out ].u32Operand = u8Patterns;
+        u32Out++;
+        u32Candidate += u32Plays;
+        u32Index += u32Plays*psBest->u32Length;
+      }
+      else
+      {
+        gpsSong[ u32Out++ ] = gpsSong[ u32Index++ ];
+      }
+    }
+    gu32Length = u32Out;
+    u8Patterns++;
+  }
+
+  free( gpu32Ids );
+  free( gpu32Ranks );
+  free( gpu32Suffixes );
+  free( gpu32Lcp );
+  free( gpu32Offsets );
+  free( gpu32Positions );
+  free( gpsCandidates );
+  free( gpsStack );
+
+  *pu32Length = gu32Length;
+  return u8Patterns;
+}
+
+
+//-----------------------------------------------< EOF >--------------------------------------------------/
@@ -0,0 +1,55 @@
+/*! *******************************************************************************************************
+* Copyright (c) 2018-2023 K. Sz. Horvath
+*
+* All rights reserved
+*
+* \file pattern.h
+*
+* \brief Factoring the repeated phrases of a song into patterns
+*
+* \author K. Sz. Horvath
+*
+**********************************************************************************************************/
+
+#ifndef PATTERN_H
+#define PATTERN_H
+
+//--------------------------------------------------------------------------------------------------------/
+// Include files
+//--------------------------------------------------------------------------------------------------------/
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Definitions
+//--------------------------------------------------------------------------------------------------------/
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Types
+//--------------------------------------------------------------------------------------------------------/
+//! \brief A pattern factored out of the song
+typedef struct
+{
+  S_TRACKER_INSTRUCTION* psInstructions;  //!< The instructions of the pattern, without the RETURN
+  U32 u32Length;                          //!< Number of instructions
+  U8  u8Depth;                            //!< 1, or one more than the deepest pattern it calls
+} S_PATTERN;
+
+//! \brief Returns the size of an instruction in the compact format (bytes)
+typedef U32( *pPatternSizeFunction )( S_TRACKER_INSTRUCTION const* psInstruction );
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Global variables
+//--------------------------------------------------------------------------------------------------------/
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Interface functions
+//--------------------------------------------------------------------------------------------------------/
+U8 Pattern_Factor( S_TRACKER_INSTRUCTION* psSong, U32* pu32Length, pPatternSizeFunction pfSize, U32 u32MaxBytes, S_PATTERN* psPatterns );
+
+
+#endif  // PATTERN_H
+
+//-----------------------------------------------< EOF >--------------------------------------------------/
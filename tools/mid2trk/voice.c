@@ -0,0 +1,243 @@
+/*! *******************************************************************************************************
+* Copyright (c) 2018-2023 K. Sz. Horvath
+*
+* All rights reserved
+*
+* \file voice.c
+*
+* \brief Allocating the notes of the MIDI channels to the channels of the tracker
+*
+* \author K. Sz. Horvath
+*
+**********************************************************************************************************/
+
+//--------------------------------------------------------------------------------------------------------/
+// Include files
+//--------------------------------------------------------------------------------------------------------/
+#include <stdio.h>
+#include <string.h>
+#include "types.h"
+#include "sound_synth.h"
+#include "tracker.h"
+
+// Own include
+#include "voice.h"
+
+//--------------------------------------------------------------------------------------------------------/
+// Definitions
+//--------------------------------------------------------------------------------------------------------/
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Types
+//--------------------------------------------------------------------------------------------------------/
+//! \brief A channel of the tracker, it plays one note at a time
+typedef struct
+{
+  BOOL bPlaying;    //!< TRUE while the note is held
+  U8   u8Channel;   //!< MIDI channel of the note, or of the last note
+  U8   u8Note;      //!< MIDI note
+  U8   u8Priority;  //!< Priority of the note
+  U32  u32Order;    //!< Order of the note on, the oldest note is stolen
+} S_VOICE;
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Global variables
+//--------------------------------------------------------------------------------------------------------/
+static S_VOICE gasVoices[ TRACKER_NUMBER_OF_CHANNELS ];
+static U8  gu8Voices;         //!< Number of channels the notes are allocated to
+static U32 gu32Order;         //!< Note ons so far
+static BOOL gaabHeld[ VOICE_MIDI_CHANNELS ][ VOICE_MIDI_NOTES ];  //!< The notes held in the MIDI file
+static U8   gaau8Voices[ VOICE_MIDI_CHANNELS ][ VOICE_MIDI_NOTES ];  //!< Voice of each note, or VOICE_NONE
+static U32 gu32Held;          //!< Number of notes held in the MIDI file
+static U32 gu32PeakHeld;      //!< Most notes held at the same time
+static U32 gu32Stolen;        //!< Notes cut short for a new note
+static U32 gu32Dropped;       //!< Notes not played, all voices had more important notes
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Static function declarations
+//--------------------------------------------------------------------------------------------------------/
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Static functions
+//--------------------------------------------------------------------------------------------------------/
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Interface functions
+//--------------------------------------------------------------------------------------------------------/
+ /*! *******************************************************************
+ * \brief  Initializes the allocator
+ * \param  u8Voices: number of tracker channels the notes are allocated to,
+ *                   TRACKER_NUMBER_OF_CHANNELS at most
+ * \return -
+ * \note   Voice N starts as if it played MIDI channel N last, so the
+ *         songs with one note at a time per channel keep their channels.
+ *********************************************************************/
+void Voice_Init( U8 u8Voices )
+{
+  U8 u8Voice;
+
+  gu8Voices = ( u8Voices < TRACKER_NUMBER_OF_CHANNELS ) ? u8Voices : TRACKER_NUMBER_OF_CHANNELS;
+  for( u8Voice = 0u; u8Voice < TRACKER_NUMBER_OF_CHANNELS; u8Voice++ )
+  {
+    gasVoices[ u8Voice ].bPlaying = FALSE;
+    gasVoices[ u8Voice ].u8Channel = u8Voice;
+    gasVoices[ u8Voice ].u8Note = 0u;
+    gasVoices[ u8Voice ].u8Priority = VOICE_PRIORITY_PERCUSSION;
+    gasVoices[ u8Voice ].u32Order = 0u;
+  }
+  memset( gaabHeld, 0, sizeof( gaabHeld ) );
+  memset( gaau8Voices, VOICE_NONE, sizeof( gaau8Voices ) );
+  gu32Order = 0u;
+  gu32Held = 0u;
+  gu32PeakHeld = 0u;
+  gu32Stolen = 0u;
+  gu32Dropped = 0u;
+}
+
+ /*! *******************************************************************
+ * \brief  Allocates a voice to a note on
+ * \param  u8Channel: MIDI channel
+ * \param  u8Note: MIDI note
+ * \param  u8Priority: VOICE_PRIORITY_PERCUSSION or VOICE_PRIORITY_NOTE
+ * \return Index of the voice, or VOICE_NONE if the note is dropped
+ * \note   A note hit again keeps its voice. Otherwise a free voice is
+ *         taken, the one that played the same MIDI channel last if there
+ *         is such, so its instrument and modulation can stay. If all voices
+ *         are busy, the oldest note of the lowest priority is stolen, unless
+ *         it is more important than the new note: then the new one is dropped.
+ *********************************************************************/
+U8 Voice_NoteOn( U8 u8Channel, U8 u8Note, U8 u8Priority )
+{
+  U8 u8Voice;
+  U8 u8Free = VOICE_NONE;
+  U8 u8Victim = VOICE_NONE;
+  S_VOICE* psVoice;
+
+  if( ( u8Channel >= VOICE_MIDI_CHANNELS ) || ( u8Note >= VOICE_MIDI_NOTES ) )
+  {
+    return VOICE_NONE;
+  }
+
+  // Polyphony of the MIDI file
+  if( FALSE == gaabHeld[ u8Channel ][ u8Note ] )
+  {
+    gaabHeld[ u8Channel ][ u8Note ] = TRUE;
+    gu32Held++;
+    if( gu32Held > gu32PeakHeld )
+    {
+      gu32PeakHeld = gu32Held;
+    }
+  }
+
+  u8Voice = gaau8Voices[ u8Channel ][ u8Note ];
+  if( VOICE_NONE == u8Voice )
+  {
+    for( u8Voice = 0u; u8Voice < gu8Voices; u8Voice++ )
+    {
+      psVoice = &gasVoices[ u8Voice ];
+      if( FALSE == psVoice->bPlaying )
+      {
+        if( ( VOICE_NONE == u8Free ) || ( ( u8Channel == psVoice->u8Channel ) && ( u8Channel != gasVoices[ u8Free ].u8Channel ) ) )
+        {
+          u8Free = u8Voice;
+        }
+      }
+      else if( ( VOICE_NONE == u8Victim )
+            || ( psVoice->u8Priority < gasVoices[ u8Victim ].u8Priority )
+            || ( ( psVoice->u8Priority == gasVoices[ u8Victim ].u8Priority ) && ( psVoice->u32Order < gasVoices[ u8Victim ].u32Order ) ) )
+      {
+        u8Victim = u8Voice;
+      }
+    }
+
+    if( VOICE_NONE != u8Free )
+    {
+      u8Voice = u8Free;
+    }
+    else if( ( VOICE_NONE == u8Victim ) || ( gasVoices[ u8Victim ].u8Priority > u8Priority ) )
+    {
+      gu32Dropped++;
+      return VOICE_NONE;
+    }
+    else
+    {
+      u8Voice = u8Victim;
+      gaau8Voices[ gasVoices[ u8Victim ].u8Channel ][ gasVoices[ u8Victim ].u8Note ] = VOICE_NONE;
+      gu32Stolen++;
+    }
+  }
+
+  gaau8Voices[ u8Channel ][ u8Note ] = u8Voice;
+  psVoice = &gasVoices[ u8Voice ];
+  psVoice->bPlaying = TRUE;
+  psVoice->u8Channel = u8Channel;
+  psVoice->u8Note = u8Note;
+  psVoice->u8Priority = u8Priority;
+  psVoice->u32Order = gu32Order++;
+  return u8Voice;
+}
+
+ /*! *******************************************************************
+ * \brief  Frees the voice of a note off
+ * \param  u8Channel: MIDI channel
+ * \param  u8Note: MIDI note
+ * \return Index of the voice, or VOICE_NONE if the note does not play
+ *         (it was stolen, dropped or never hit)
+ *********************************************************************/
+U8 Voice_NoteOff( U8 u8Channel, U8 u8Note )
+{
+  U8 u8Voice;
+
+  if( ( u8Channel >= VOICE_MIDI_CHANNELS ) || ( u8Note >= VOICE_MIDI_NOTES ) )
+  {
+    return VOICE_NONE;
+  }
+
+  if( TRUE == gaabHeld[ u8Channel ][ u8Note ] )
+  {
+    gaabHeld[ u8Channel ][ u8Note ] = FALSE;
+    gu32Held--;
+  }
+
+  u8Voice = gaau8Voices[ u8Channel ][ u8Note ];
+  if( VOICE_NONE != u8Voice )
+  {
+    gasVoices[ u8Voice ].bPlaying = FALSE;
+    gaau8Voices[ u8Channel ][ u8Note ] = VOICE_NONE;
+  }
+  return u8Voice;
+}
+
+ /*! *******************************************************************
+ * \brief  Tells if a voice plays a note of a MIDI channel
+ * \param  u8Voice: index of the voice
+ * \param  u8Channel: MIDI channel
+ * \return TRUE if it does
+ *********************************************************************/
+BOOL Voice_IsPlaying( U8 u8Voice, U8 u8Channel )
+{
+  return ( ( u8Voice < gu8Voices ) && ( TRUE == gasVoices[ u8Voice ].bPlaying ) && ( u8Channel == gasVoices[ u8Voice ].u8Channel ) ) ? TRUE : FALSE;
+}
+
+ /*! *******************************************************************
+ * \brief  Prints the polyphony of the song and the notes that did not fit
+ * \param  -
+ * \return -
+ *********************************************************************/
+void Voice_PrintReport( void )
+{
+  printf( "Voices: %u, peak polyphony: %u, stolen notes: %u, dropped notes: %u\n",
+          gu8Voices, (unsigned)gu32PeakHeld, (unsigned)gu32Stolen, (unsigned)gu32Dropped );
+  if( gu32PeakHeld > gu8Voices )
+  {
+    printf( "Warning: the song holds more notes than the voices, the oldest ones are cut short\n" );
+  }
+}
+
+
+//-----------------------------------------------< EOF >--------------------------------------------------/
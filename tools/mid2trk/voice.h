@@ -0,0 +1,55 @@
+/*! *******************************************************************************************************
+* Copyright (c) 2018-2023 K. Sz. Horvath
+*
+* All rights reserved
+*
+* \file voice.h
+*
+* \brief Allocating the notes of the MIDI channels to the channels of the tracker
+*
+* \author K. Sz. Horvath
+*
+**********************************************************************************************************/
+
+#ifndef VOICE_H
+#define VOICE_H
+
+//--------------------------------------------------------------------------------------------------------/
+// Include files
+//--------------------------------------------------------------------------------------------------------/
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Definitions
+//--------------------------------------------------------------------------------------------------------/
+#define VOICE_NONE                 (0xFFu)  //!< The note plays on no voice
+#define VOICE_MIDI_CHANNELS          (16u)  //!< Number of MIDI channels
+#define VOICE_MIDI_NOTES            (128u)  //!< Number of MIDI notes
+
+#define VOICE_PRIORITY_PERCUSSION     (0u)  //!< Priority of the drum hits, they are stolen first
+#define VOICE_PRIORITY_NOTE           (1u)  //!< Priority of the pitched notes
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Types
+//--------------------------------------------------------------------------------------------------------/
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Global variables
+//--------------------------------------------------------------------------------------------------------/
+
+
+//--------------------------------------------------------------------------------------------------------/
+// Interface functions
+//--------------------------------------------------------------------------------------------------------/
+void Voice_Init( U8 u8Voices );
+U8   Voice_NoteOn( U8 u8Channel, U8 u8Note, U8 u8Priority );
+U8   Voice_NoteOff( U8 u8Channel, U8 u8Note );
+BOOL Voice_IsPlaying( U8 u8Voice, U8 u8Channel );
+void Voice_PrintReport( void );
+
+
+#endif  // VOICE_H
+
+//-----------------------------------------------< EOF >--------------------------------------------------/
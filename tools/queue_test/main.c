@@ -0,0 +1,177 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include "types.h"
+
+// Every command the renderer executes is checked
+static void TraceCommand( U8 u8Command, U32 u32PhaseIncrease, U32 u32Time );
+#define SOUNDSYNTH_COMMAND_HOOK(C)  TraceCommand( (C)->u8Command, (C)->u32PhaseIncrease, (C)->u32Time )
+
+// The queue indices are set close to the wrap-around, so the synthesizer is compiled into this file
+#include "sound_synth.c"
+
+#define QUEUE_TEST_DEFAULT_COMMANDS  (2000000u)  //!< Commands pushed without the -n option
+#define QUEUE_TEST_INDEX_START    (0xFFFFF000u)  //!< First queue index: the indices wrap around early in the run
+#define QUEUE_TEST_TIME_START     (0xFFFF0000u)  //!< First sample time: the time wraps around after 1.5 s of audio
+#define QUEUE_TEST_MAX_DELAY            (200u)  //!< Largest step of the command times in frames
+#define QUEUE_TEST_MAX_BLOCK            (256u)  //!< Largest number of frames rendered at once
+#define QUEUE_TEST_PAUSE_EVERY        (65536u)  //!< The producer pauses after so many commands, the queue runs empty
+#define QUEUE_TEST_MAX_REPORTED          (10u)  //!< Errors printed
+
+static U32 gu32Commands = QUEUE_TEST_DEFAULT_COMMANDS;  //!< Commands pushed by the producer
+static volatile U32 gu32Executed;   //!< Commands executed by the renderer, the next one must carry this number
+static U32 gu32Errors;              //!< Lost, duplicated, reordered, foreign or early commands
+static U32 gu32OnTime;              //!< Commands executed at their exact sample time
+static U32 gu32Full;                //!< Pushes refused because the queue was full
+static U32 gu32MaxQueued;           //!< Most commands seen in the queue by the producer
+
+/*! *******************************************************************
+ * \brief  32-bit xorshift generator, one state per thread
+ * \param  pu32State: state of the generator
+ * \return Next random number
+ *********************************************************************/
+static U32 Random( U32* pu32State )
+{
+  *pu32State ^= *pu32State<<13;
+  *pu32State ^= *pu32State>>17;
+  *pu32State ^= *pu32State<<5;
+  return *pu32State;
+}
+
+/*! *******************************************************************
+ * \brief  Checks a command executed by the renderer (consumer thread)
+ * \param  u8Command: the command
+ * \param  u32PhaseIncrease: the producer puts the sequence number here
+ * \param  u32Time: sample time of the command
+ * \return -
+ *********************************************************************/
+static void TraceCommand( U8 u8Command, U32 u32PhaseIncrease, U32 u32Time )
+{
+  I32 i32Late = (I32)( gu32SampleTime - u32Time );
+
+  if( ( (U8)SYNTH_COMMAND_NOTEON != u8Command ) || ( u32PhaseIncrease != gu32Executed ) || ( i32Late < 0 ) )
+  {
+    if( gu32Errors < QUEUE_TEST_MAX_REPORTED )
+    {
+      printf( "  Command %u (type %u) executed as command %u, %d frames late\n", u32PhaseIncrease, u8Command, gu32Executed, i32Late );
+    }
+    gu32Errors++;
+  }
+  if( 0 == i32Late )
+  {
+    gu32OnTime++;
+  }
+  gu32Executed++;
+}
+
+/*! *******************************************************************
+ * \brief  The audio renderer: renders blocks of random size until every command was executed
+ * \param  pvArgument: not used
+ * \return NULL
+ *********************************************************************/
+static void* Consumer( void* pvArgument )
+{
+  static I16 ai16Buffer[ 2u*QUEUE_TEST_MAX_BLOCK ];
+  U32 u32Random = 0x9E3779B9u;
+
+  (void)pvArgument;
+  while( gu32Executed < gu32Commands )
+  {
+    SoundSynth_Render( ai16Buffer, (U16)( 1u + Random( &u32Random ) % QUEUE_TEST_MAX_BLOCK ), 0x8000u );
+    if( SOUNDSYNTH_COMMAND_QUEUE == SoundSynth_GetQueueSpace() )
+    {
+      // Nothing to do: let the producer run, also on a single core
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+int main( int argc, char *argv[] )
+{
+  pthread_t sConsumer;
+  U32  u32Random = 0x2545F491u;
+  U32  u32Sequence;
+  U32  u32Time = QUEUE_TEST_TIME_START;
+  U32  u32Now;
+  U32  u32Queued;
+  BOOL bFailed = FALSE;
+
+  printf( "QUEUE_TEST by Hekk_Elek[Strlen]\n" );
+  printf( "Build time: %s, %s\n\n", __DATE__, __TIME__ );
+
+  if( ( argc > 2 ) && ( 0 == strcmp( argv[1], "-n" ) ) )
+  {
+    gu32Commands = (U32)strtoul( argv[2], NULL, 10 );
+  }
+  else if( argc > 1 )
+  {
+    printf( "Usage: queue_test [-n commands]\n" );
+    printf( "Pushes numbered notes from the main thread while another thread renders, and checks\n" );
+    printf( "that the renderer executes each of them once, in order, and not before its time.\n" );
+    return -2;
+  }
+
+  SoundSynth_Init();
+  gu32CommandWrite = QUEUE_TEST_INDEX_START;
+  gu32CommandRead = QUEUE_TEST_INDEX_START;
+  gu32SampleTime = QUEUE_TEST_TIME_START;
+
+  if( 0 != pthread_create( &sConsumer, NULL, Consumer, NULL ) )
+  {
+    printf( "Can not start the consumer thread!\n" );
+    return -1;
+  }
+
+  // Producer: the main loop of the firmware, numbered notes at non-decreasing times
+  for( u32Sequence = 0u; u32Sequence < gu32Commands; u32Sequence++ )
+  {
+    u32Now = SoundSynth_GetTime();
+    if( (I32)( u32Now - u32Time ) > 0 )
+    {
+      u32Time = u32Now;
+    }
+    u32Time += Random( &u32Random ) % QUEUE_TEST_MAX_DELAY;
+
+    u32Queued = SOUNDSYNTH_COMMAND_QUEUE - SoundSynth_GetQueueSpace();
+    if( u32Queued > gu32MaxQueued )
+    {
+      gu32MaxQueued = u32Queued;
+    }
+    while( SYNTH_NOTE_NONE == SoundSynth_NoteOn( u32Sequence, SYNTH_INSTRUMENT_SINE, SYNTH_PRIORITY_MUSIC, u32Time ) )
+    {
+      gu32Full++;
+      sched_yield();
+    }
+
+    if( 0u == ( ( u32Sequence + 1u ) % QUEUE_TEST_PAUSE_EVERY ) )
+    {
+      usleep( 2000u );
+    }
+  }
+
+  pthread_join( sConsumer, NULL );
+
+  printf( "Commands: %u pushed, %u executed, %u at their exact sample time\n", gu32Commands, gu32Executed, gu32OnTime );
+  printf( "Queue full: %u times, most commands queued: %u of %u\n", gu32Full, gu32MaxQueued, SOUNDSYNTH_COMMAND_QUEUE );
+  printf( "Queue index: 0x%08X -> 0x%08X, sample time: 0x%08X -> 0x%08X\n",
+          QUEUE_TEST_INDEX_START, gu32CommandRead, QUEUE_TEST_TIME_START, gu32SampleTime );
+  printf( "Lost, duplicated, reordered or early commands: %u\n", gu32Errors );
+
+  if( ( 0u != gu32Errors ) || ( gu32Executed != gu32Commands ) || ( gu32CommandRead != gu32CommandWrite )
+   || ( gu32CommandRead != QUEUE_TEST_INDEX_START + gu32Commands ) )
+  {
+    bFailed = TRUE;
+  }
+  if( ( 0u == gu32Full ) || ( gu32CommandRead >= QUEUE_TEST_INDEX_START ) || ( gu32SampleTime >= QUEUE_TEST_TIME_START ) )
+  {
+    printf( "The run was too short: the queue was never full, or an index did not wrap around\n" );
+    bFailed = TRUE;
+  }
+
+  printf( ( TRUE == bFailed ) ? "FAILED\n" : "PASSED\n" );
+  return ( TRUE == bFailed ) ? -1 : 0;
+}
@@ -0,0 +1,261 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "types.h"
+#include "sound_synth.h"
+#include "tracker.h"
+
+#define RENDER_HALF_BUFFER_FRAMES  (128u)  //!< Frames rendered per call, like one half of the I2S buffer of the firmware
+#define RENDER_MAX_MODULE_SIZE   (65536u)  //!< Largest tracker module that can be loaded
+
+//! \brief The tracker module, the firmware links it from tetris.trk
+U8 gau8TrackerModule[ RENDER_MAX_MODULE_SIZE ];
+U32 gu32TrackerModuleSize;  //!< Size of the loaded module, the firmware gets it from the linker
+
+/*! *******************************************************************
+ * \brief  Reads the module as if it was in the SPI flash
+ * \param  u32Address: offset in the module
+ * \param  pu8Buffer: output buffer
+ * \param  u32Length: number of bytes
+ * \return -
+ *********************************************************************/
+static void ReadModule( U32 u32Address, U8* pu8Buffer, U32 u32Length )
+{
+  memcpy( pu8Buffer, &gau8TrackerModule[ u32Address ], u32Length );
+}
+
+/*! *******************************************************************
+ * \brief  Renders one half buffer the same way as Sound_IT() does
+ * \param  pi16Buffer: stereo output buffer
+ * \param  u16GainQ15: master gain
+ * \return -
+ *********************************************************************/
+static void RenderHalf( I16* pi16Buffer, U16 u16GainQ15 )
+{
+  U16 u16Frames;
+  U16 u16Chunk;
+
+  for( u16Frames = 0u; u16Frames < RENDER_HALF_BUFFER_FRAMES; u16Frames += u16Chunk )
+  {
+    u16Chunk = Tracker_Tick( RENDER_HALF_BUFFER_FRAMES - u16Frames );
+    SoundSynth_Render( &pi16Buffer[ 2u*u16Frames ], u16Chunk, u16GainQ15 );
+  }
+}
+
+/*! *******************************************************************
+ * \brief  Writes a little endian number
+ * \param  psFile: output file
+ * \param  u32Value: the number
+ * \param  u8Bytes: number of bytes
+ * \return -
+ *********************************************************************/
+static void WriteLE( FILE* psFile, U32 u32Value, U8 u8Bytes )
+{
+  for( ; u8Bytes > 0u; u8Bytes-- )
+  {
+    fputc( (U8)u32Value, psFile );
+    u32Value >>= 8u;
+  }
+}
+
+/*! *******************************************************************
+ * \brief  Writes a 16-bit stereo WAV file
+ * \param  pcFileName: name of the file
+ * \param  pi16Samples: interleaved samples
+ * \param  u32Frames: number of frames
+ * \return 0 on success
+ *********************************************************************/
+static int WriteWav( char const* pcFileName, I16 const* pi16Samples, U32 u32Frames )
+{
+  FILE* psFile = fopen( pcFileName, "wb" );
+  U32   u32Index;
+
+  if( NULL == psFile )
+  {
+    return -1;
+  }
+  fwrite( "RIFF", 4u, 1u, psFile );
+  WriteLE( psFile, 36u + 4u*u32Frames, 4u );
+  fwrite( "WAVEfmt ", 8u, 1u, psFile );
+  WriteLE( psFile, 16u, 4u );            // Chunk size
+  WriteLE( psFile, 1u, 2u );             // PCM
+  WriteLE( psFile, 2u, 2u );             // Stereo
+  WriteLE( psFile, SAMPLE_RATE, 4u );
+  WriteLE( psFile, 4u*SAMPLE_RATE, 4u ); // Bytes per second
+  WriteLE( psFile, 4u, 2u );             // Bytes per frame
+  WriteLE( psFile, 16u, 2u );            // Bits per sample
+  fwrite( "data", 4u, 1u, psFile );
+  WriteLE( psFile, 4u*u32Frames, 4u );
+  for( u32Index = 0u; u32Index < 2u*u32Frames; u32Index++ )
+  {
+    WriteLE( psFile, (U16)pi16Samples[ u32Index ], 2u );
+  }
+  fclose( psFile );
+
+  return 0;
+}
+
+/*! *******************************************************************
+ * \brief  32-bit FNV-1a hash of the samples as little endian bytes
+ * \param  pi16Samples: samples
+ * \param  u32Samples: number of samples
+ * \return Hash value
+ *********************************************************************/
+static U32 HashSamples( I16 const* pi16Samples, U32 u32Samples )
+{
+  U32 u32Hash = 2166136261u;
+  U32 u32Index;
+
+  for( u32Index = 0u; u32Index < u32Samples; u32Index++ )
+  {
+    u32Hash = ( u32Hash ^ ( (U16)pi16Samples[ u32Index ] & 0xFFu ) )*16777619u;
+    u32Hash = ( u32Hash ^ ( (U16)pi16Samples[ u32Index ]>>8u ) )*16777619u;
+  }
+
+  return u32Hash;
+}
+
+int main( int argc, char *argv[] )
+{
+  char  gcau8DefaultOutputFileName[] = "render.wav";
+  char* au8InputFileName = NULL;
+  char* au8OutputFileName = gcau8DefaultOutputFileName;
+  FILE  *psInputFile;
+  I16*  pi16Samples;
+  U32   u32Seconds = 30u;
+  U32   u32Halves;
+  U32   u32Index;
+  U32   u32Hash;
+  U32   u32ExpectedHash = 0u;
+  BOOL  bCheckHash = FALSE;
+  BOOL  bStream = FALSE;
+  U16   u16GainQ15 = 0x8000u;
+  long  lModuleSize;
+  double dSeconds;
+  clock_t sStart;
+  int   iArg;
+  E_TRACKER_LOAD_RESULT eResult;
+
+  printf( "RENDER_TRK by Hekk_Elek[Strlen]\n" );
+  printf( "Build time: %s, %s\n\n", __DATE__, __TIME__ );
+
+  for( iArg = 1; iArg < argc; iArg++ )
+  {
+    if( ( 0 == strcmp( argv[ iArg ], "-s" ) ) && ( iArg + 1 < argc ) )
+    {
+      u32Seconds = strtoul( argv[ ++iArg ], NULL, 0 );
+    }
+    else if( ( 0 == strcmp( argv[ iArg ], "-o" ) ) && ( iArg + 1 < argc ) )
+    {
+      au8OutputFileName = argv[ ++iArg ];
+    }
+    else if( ( 0 == strcmp( argv[ iArg ], "-e" ) ) && ( iArg + 1 < argc ) )
+    {
+      u32ExpectedHash = strtoul( argv[ ++iArg ], NULL, 16 );
+      bCheckHash = TRUE;
+    }
+    else if( ( 0 == strcmp( argv[ iArg ], "-g" ) ) && ( iArg + 1 < argc ) )
+    {
+      // Same scale as the volume setting of the firmware
+      u16GainQ15 = (U16)( ( strtoul( argv[ ++iArg ], NULL, 0 ) & 0xFFu ) + 1u )<<7u;
+    }
+    else if( 0 == strcmp( argv[ iArg ], "-f" ) )
+    {
+      // Played the way the songs of the SPI flash are
+      bStream = TRUE;
+    }
+    else if( ( '-' != argv[ iArg ][ 0 ] ) && ( NULL == au8InputFileName ) )
+    {
+      au8InputFileName = argv[ iArg ];
+    }
+    else
+    {
+      au8InputFileName = NULL;
+      break;
+    }
+  }
+  if( NULL == au8InputFileName )
+  {
+    printf( "Usage: render_trk [-s seconds] [-o outputfile.wav] [-g volume] [-e expectedhash] [-f] inputfile.trk\n" );
+    return -2;
+  }
+
+  printf( "Input file: %s\n", au8InputFileName );
+  printf( "Output file: %s\n", au8OutputFileName );
+
+  psInputFile = fopen( au8InputFileName, "rb" );
+  if( NULL == psInputFile )
+  {
+    printf( "Can not open input file!\n" );
+    return -1;
+  }
+  fseek( psInputFile, 0L, SEEK_END );
+  lModuleSize = ftell( psInputFile );
+  rewind( psInputFile );
+  if( ( lModuleSize <= 0 ) || ( lModuleSize > (long)RENDER_MAX_MODULE_SIZE ) || ( 1u != fread( gau8TrackerModule, lModuleSize, 1u, psInputFile ) ) )
+  {
+    printf( "Invalid module size!\n" );
+    fclose( psInputFile );
+    return -1;
+  }
+  fclose( psInputFile );
+  gu32TrackerModuleSize = (U32)lModuleSize;
+
+  u32Halves = ( u32Seconds*SAMPLE_RATE + RENDER_HALF_BUFFER_FRAMES - 1u )/RENDER_HALF_BUFFER_FRAMES;
+  pi16Samples = malloc( u32Halves*RENDER_HALF_BUFFER_FRAMES*2u*sizeof( I16 ) );
+  if( NULL == pi16Samples )
+  {
+    printf( "Out of memory!\n" );
+    return -1;
+  }
+
+  // Same order as Sound_Init() and the start of the game
+  SoundSynth_Init();
+  Tracker_Init();
+  if( TRUE == bStream )
+  {
+    eResult = Tracker_LoadStream( ReadModule, 0u, gu32TrackerModuleSize );
+  }
+  else
+  {
+    eResult = Tracker_Load( gau8TrackerModule, gu32TrackerModuleSize );
+  }
+  if( TRACKER_LOAD_OK != eResult )
+  {
+    printf( "Invalid module (error %u)!\n", (unsigned)eResult );
+    return -1;
+  }
+  Tracker_Start();
+
+  sStart = clock();
+  for( u32Index = 0u; u32Index < u32Halves; u32Index++ )
+  {
+    // The main loop reads ahead between the audio interrupts
+    Tracker_Service();
+    RenderHalf( &pi16Samples[ u32Index*RENDER_HALF_BUFFER_FRAMES*2u ], u16GainQ15 );
+  }
+  dSeconds = (double)( clock() - sStart )/CLOCKS_PER_SEC;
+
+  u32Hash = HashSamples( pi16Samples, u32Halves*RENDER_HALF_BUFFER_FRAMES*2u );
+  printf( "Rendered: %u frames (%u s at %u Hz)\n", u32Halves*RENDER_HALF_BUFFER_FRAMES, u32Seconds, SAMPLE_RATE );
+  printf( "Hash: %08X\n", u32Hash );
+  if( dSeconds > 0.0 )
+  {
+    printf( "Throughput: %.0f frames/s, %.1fx real time\n", u32Halves*RENDER_HALF_BUFFER_FRAMES/dSeconds, u32Halves*RENDER_HALF_BUFFER_FRAMES/dSeconds/SAMPLE_RATE );
+  }
+
+  if( 0 != WriteWav( au8OutputFileName, pi16Samples, u32Halves*RENDER_HALF_BUFFER_FRAMES ) )
+  {
+    printf( "Can not write output file!\n" );
+    return -1;
+  }
+
+  if( ( TRUE == bCheckHash ) && ( u32Hash != u32ExpectedHash ) )
+  {
+    printf( "Hash mismatch, expected: %08X\n", u32ExpectedHash );
+    return 1;
+  }
+
+  return 0;
+}
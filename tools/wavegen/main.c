@@ -0,0 +1,168 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "types.h"
+
+#define WAVETABLE_REFERENCE_SIZE  (512u)  //!< Size of the lowest level, a phase increase of 65536 plays it at SAMPLE_RATE/512 Hz
+#define WAVETABLE_LEVELS          (8u)    //!< One level per octave of the phase increase
+#define WAVETABLE_MIN_SIZE        (64u)   //!< Shortest level, so the interpolation stays accurate
+
+typedef enum
+{
+  WAVEFORM_SAWTOOTH,
+  WAVEFORM_SQUARE
+} E_WAVEFORM;
+
+static const char* gcapcWaveformNames[] = { "Saw", "Square" };
+static const char* gcapcWaveformComments[] = { "sawtooth", "square" };
+
+/*! *******************************************************************
+ * \brief  Number of harmonics that fit below the Nyquist frequency
+ * \param  u32Level: mip level
+ * \return Harmonic count
+ * \note   Level N is played with phase increases below 2^(N+1)*65536,
+ *         so its fundamental is below SAMPLE_RATE/256*2^N.
+ *********************************************************************/
+static U32 GetHarmonics( U32 u32Level )
+{
+  return ( WAVETABLE_REFERENCE_SIZE/4u )>>u32Level;
+}
+
+/*! *******************************************************************
+ * \brief  Size of a mip level
+ * \param  u32Level: mip level
+ * \return Number of samples, at least twice the highest harmonic
+ *********************************************************************/
+static U32 GetLevelSize( U32 u32Level )
+{
+  U32 u32Size = WAVETABLE_REFERENCE_SIZE>>u32Level;
+
+  return ( u32Size < WAVETABLE_MIN_SIZE ) ? WAVETABLE_MIN_SIZE : u32Size;
+}
+
+/*! *******************************************************************
+ * \brief  Additive synthesis of one band-limited period
+ * \param  eWaveform: waveform
+ * \param  u32Harmonics: highest harmonic
+ * \param  u32Size: number of samples
+ * \param  pdOut: output samples, peak level is about 1.0
+ * \return -
+ *********************************************************************/
+static void Synthesize( E_WAVEFORM eWaveform, U32 u32Harmonics, U32 u32Size, double* pdOut )
+{
+  U32    u32Index;
+  U32    u32Harmonic;
+  double dPhase;
+
+  for( u32Index = 0u; u32Index < u32Size; u32Index++ )
+  {
+    dPhase = 2.0*M_PI*u32Index/u32Size;
+    pdOut[ u32Index ] = 0.0;
+    for( u32Harmonic = 1u; u32Harmonic <= u32Harmonics; u32Harmonic++ )
+    {
+      if( WAVEFORM_SAWTOOTH == eWaveform )
+      {
+        pdOut[ u32Index ] += ( ( u32Harmonic & 1u ) ? 2.0 : -2.0 )*sin( u32Harmonic*dPhase )/( M_PI*u32Harmonic );
+      }
+      else if( u32Harmonic & 1u )
+      {
+        pdOut[ u32Index ] += 4.0*sin( u32Harmonic*dPhase )/( M_PI*u32Harmonic );
+      }
+    }
+  }
+}
+
+/*! *******************************************************************
+ * \brief  Writes all mip levels of a waveform as C source
+ * \param  psFile: output file
+ * \param  eWaveform: waveform
+ * \return -
+ * \note   All levels are scaled with the same factor, so the loudness does
+ *         not jump between the octaves.
+ *********************************************************************/
+static void ExportWaveform( FILE* psFile, E_WAVEFORM eWaveform )
+{
+  static double adLevels[ WAVETABLE_LEVELS ][ WAVETABLE_REFERENCE_SIZE ];
+  double dPeak = 0.0;
+  U32    u32Level;
+  U32    u32Index;
+
+  for( u32Level = 0u; u32Level < WAVETABLE_LEVELS; u32Level++ )
+  {
+    Synthesize( eWaveform, GetHarmonics( u32Level ), GetLevelSize( u32Level ), adLevels[ u32Level ] );
+    for( u32Index = 0u; u32Index < GetLevelSize( u32Level ); u32Index++ )
+    {
+      if( fabs( adLevels[ u32Level ][ u32Index ] ) > dPeak )
+      {
+        dPeak = fabs( adLevels[ u32Level ][ u32Index ] );
+      }
+    }
+  }
+
+  for( u32Level = 0u; u32Level < WAVETABLE_LEVELS; u32Level++ )
+  {
+    fprintf( psFile, "//! \\brief Mip level %u of the %s wave: %u harmonics\n", u32Level, gcapcWaveformComments[ eWaveform ], GetHarmonics( u32Level ) );
+    fprintf( psFile, "static const I16 gcai16%sWaveTable%u[ %uu ] =\n{\n", gcapcWaveformNames[ eWaveform ], u32Level, GetLevelSize( u32Level ) );
+    for( u32Index = 0u; u32Index < GetLevelSize( u32Level ); u32Index++ )
+    {
+      if( 0u == ( u32Index % 16u ) )
+      {
+        fprintf( psFile, "  " );
+      }
+      fprintf( psFile, "%ld, ", lround( 32767.0*adLevels[ u32Level ][ u32Index ]/dPeak ) );
+      if( 15u == ( u32Index % 16u ) )
+      {
+        fprintf( psFile, "\n" );
+      }
+    }
+    fprintf( psFile, "};\n\n" );
+  }
+
+  fprintf( psFile, "//! \\brief Band-limited %s wave, one mip level per octave\n", gcapcWaveformComments[ eWaveform ] );
+  fprintf( psFile, "const S_WAVETABLE gcs%sWaveTable =\n{\n  %uu,\n  {\n", gcapcWaveformNames[ eWaveform ], WAVETABLE_LEVELS );
+  for( u32Level = 0u; u32Level < WAVETABLE_LEVELS; u32Level++ )
+  {
+    fprintf( psFile, "    { gcai16%sWaveTable%u, %uu }%s\n", gcapcWaveformNames[ eWaveform ], u32Level, GetLevelSize( u32Level ), ( u32Level + 1u < WAVETABLE_LEVELS ) ? "," : "" );
+  }
+  fprintf( psFile, "  }\n};\n\n" );
+}
+
+int main( int argc, char *argv[] )
+{
+  char  gcau8DefaultOutputFileName[] = "wavetables.txt";
+  char* au8OutputFileName;
+  FILE  *psOutputFile;
+
+  printf( "WAVEGEN by Hekk_Elek[Strlen]\n" );
+  printf( "Build time: %s, %s\n\n", __DATE__, __TIME__ );
+
+  if( argc == 1 )
+  {
+    au8OutputFileName = gcau8DefaultOutputFileName;
+  }
+  else if( argc == 2 )
+  {
+    au8OutputFileName = argv[1];
+  }
+  else  // too many arguments
+  {
+    printf( "Usage: wavegen [outputfile.txt]\n" );
+    return -2;
+  }
+
+  printf( "Output file: %s\n", au8OutputFileName );
+
+  psOutputFile = fopen( au8OutputFileName, "w" );
+  if( NULL == psOutputFile )
+  {
+    printf( "Can not open output file!\n" );
+    return -1;
+  }
+
+  ExportWaveform( psOutputFile, WAVEFORM_SAWTOOTH );
+  ExportWaveform( psOutputFile, WAVEFORM_SQUARE );
+
+  fclose( psOutputFile );
+
+  return 0;
+}